@@ -0,0 +1,1165 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Micro benchmarks of the board operations, memory held by
+//               the games, fixed depth searches, endgames and proofs, and
+//               matches of the searches of more than 2 players, the results
+//               are written as JSON.
+//               bench [--filter <text>] [--min-time <ms>] [--output <file>]
+//                     [--counters]
+//============================================================================
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <malloc.h>
+#include <memory>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "bit_board.h"
+#include "endgame_solver.h"
+#include "evaluation_cache.h"
+#include "intelligent_board.h"
+#include "neural_evaluator.h"
+#include "perf_counters.h"
+#include "position_codec.h"
+#include "proof_search.h"
+#include "window_evaluator.h"
+
+// Every allocation of the program is counted, with the bytes held
+static std::atomic<std::size_t> num_allocations(0);
+static std::atomic<std::size_t> num_heap_bytes(0);
+
+void* operator new(std::size_t size) {
+  num_allocations.fetch_add(1, std::memory_order_relaxed);
+  void* memory = std::malloc(size == 0 ? 1 : size);
+  if(memory == nullptr) {
+    throw std::bad_alloc();
+  }
+  num_heap_bytes.fetch_add(malloc_usable_size(memory),
+                           std::memory_order_relaxed);
+  return memory;
+}
+
+void* operator new[](std::size_t size) {
+  return operator new(size);
+}
+
+// Not inlined: GCC would see the free of a pointer returned by operator new
+// and report a mismatched deallocation
+__attribute__((noinline)) void operator delete(void* memory) noexcept {
+  num_heap_bytes.fetch_sub(malloc_usable_size(memory),
+                           std::memory_order_relaxed);
+  std::free(memory);
+}
+
+__attribute__((noinline)) void operator delete[](void* memory) noexcept {
+  operator delete(memory);
+}
+
+using namespace Core;
+
+namespace {
+
+const char kUsageMsg[] = "usage: bench [--filter <text>] [--min-time <ms>]"
+                         " [--output <file>] [--counters]";
+const int kSchemaVersion = 1;
+// positions are reached by random moves from a fixed seed
+const uint32_t kPositionSeed = 2016;
+const std::size_t kMidGameMoves[] = {4, 8};
+const std::size_t kMaxRejectedMoves = 64;
+// the evaluations are checked on every position of random games
+const std::size_t kNumCheckedGames = 20;
+const InstructionSet kInstructionSets[] = {
+    InstructionSet::Scalar, InstructionSet::Sse2, InstructionSet::Avx2};
+// scores of IntelligentBoard
+const int kWinScore = 1000;
+const int kThreatScore = kWinScore / 2;
+// hidden size of the random networks timed
+const std::size_t kBenchHiddenSize = 256;
+const MultiPlayerSearch kMultiPlayerSearches[] = {
+    MultiPlayerSearch::Paranoid, MultiPlayerSearch::MaxN,
+    MultiPlayerSearch::BestReply};
+const std::size_t kNumMultiPlayerSearches = 3;
+// every match starts from these numbers of random moves, once for every
+// seating of the searches
+const std::size_t kMatchOpeningMoves[] = {1, 2, 3, 4, 5, 6, 7, 8};
+
+struct Variant {
+  const char* name_;
+  std::vector<std::size_t> dimensions_;
+  uint8_t num_connected_;
+  // depth of the searches
+  DepthType depth_;
+  uint8_t num_players_;
+};
+
+const Variant kVariants[] = {{"6x7c4", {6, 7}, 4, 8, 2},
+                             {"3x6c3", {3, 6}, 3, 10, 2},
+                             {"6x9c5", {6, 9}, 5, 6, 2},
+                             {"7x10c4", {7, 10}, 4, 6, 2},
+                             {"8x8c4", {8, 8}, 4, 7, 2},
+                             {"4x4x4c4", {4, 4, 4}, 4, 10, 2}};
+
+// Score Four is also searched without its bitboard, at the depth the generic
+// search reaches in a few seconds
+const Variant kGenericScoreFourVariant = {"4x4x4c4", {4, 4, 4}, 4, 6, 2};
+
+// Searched with every MultiPlayerSearch, the matches give kMatchNodes to
+// every move so that the cheaper nodes buy a deeper search
+const Variant kMultiPlayerVariants[] = {{"7x9c4p3", {7, 9}, 4, 6, 3},
+                                        {"8x10c4p4", {8, 10}, 4, 5, 4}};
+const std::size_t kMatchNodes = 2000;
+
+// The best moves are ranked by a multi-PV search of kMultiPVLines lines and
+// by a search after every possible move, with a transposition table
+const std::size_t kMultiPVLines = 3;
+const std::size_t kMultiPVTableMegabytes = 16;
+
+// The games held at once to measure the memory of a game, half of the cells
+// are played
+const std::size_t kFootprintGames = 1000;
+
+// Positions whose result is known, the wins are named after the length of
+// the winning line found
+struct TacticalPosition {
+  const char* name_;
+  const char* position_;
+  ProofStatus expected_;
+};
+
+const TacticalPosition kTacticalPositions[] = {
+    {"6x7c4/proof/win_5_plies", "6x7 4 2 a 7/7/4b2/2b1b1a/2a1a1b/1aa1bab",
+     ProofStatus::Proven},
+    {"6x7c4/proof/win_7_plies", "6x7 4 2 a 7/7/2b4/2a4/b1ba1aa/a1ba1bb",
+     ProofStatus::Proven},
+    {"6x7c4/proof/win_11_plies", "6x7 4 2 a 7/7/4aa1/4ab1/3bbab/3bbaa",
+     ProofStatus::Proven},
+    {"6x7c4/proof/win_21_plies", "6x7 4 2 a 7/4b2/4aa1/2a1baa/1abbabb/bbababa",
+     ProofStatus::Proven},
+    {"6x7c4/proof/win_29_plies", "6x7 4 2 a 7/7/7/4a2/2a1b2/bba1a1b",
+     ProofStatus::Proven},
+    {"6x7c4/proof/no_win_1", "6x7 4 2 a 6a/6a/6b/3bb1b/2bab1a/1abbaaa",
+     ProofStatus::Disproven},
+    {"6x7c4/proof/no_win_2", "6x7 4 2 a 7/7/7/1bb1a2/abaab2/baaab1b",
+     ProofStatus::Disproven},
+    {"6x7c4/proof/no_win_3", "6x7 4 2 b 7/7/4b2/a2aa2/b1ababb/bbaabaa",
+     ProofStatus::Disproven}};
+
+// Endgames of games between searches, named after their number of empty
+// cells. They are solved and searched to the end of the game by the
+// heuristic search with a table.
+struct EndgamePosition {
+  const char* name_;
+  const char* position_;
+  EndgameResult expected_;
+};
+
+const EndgamePosition kEndgamePositions[] = {
+    {"6x7c4/endgame/win_16_cells",
+     "6x7 4 2 a 7/1ba1ab1/1ba1bb1/1abbba1/abaaba1/aabbaba",
+     EndgameResult::Win},
+    {"6x7c4/endgame/draw_20_cells",
+     "6x7 4 2 a 7/b6/a1ba3/bbabbb1/aaabaa1/bbaaab1", EndgameResult::Draw},
+    {"6x7c4/endgame/loss_20_cells",
+     "6x7 4 2 a 7/7/a1babb1/b1bbaa1/b1aaaba/b1ababa", EndgameResult::Loss},
+    {"6x7c4/endgame/win_24_cells",
+     "6x7 4 2 a 7/6a/2a3b/2b2ab/1ba1abb/bababaa", EndgameResult::Win},
+    {"6x7c4/endgame/loss_24_cells",
+     "6x7 4 2 a 7/7/1b1ab2/1a1ba2/bb1abb1/aaababa", EndgameResult::Loss}};
+
+struct Result {
+  std::string name_;
+  std::string kind_;
+  std::size_t iterations_;
+  double ns_per_op_;
+  double allocations_per_op_;
+  // searches and proofs only
+  std::size_t nodes_;
+  std::size_t evaluations_;
+  // searches only, evaluations found in the evaluation cache
+  std::size_t eval_cache_hits_;
+  double nodes_per_second_;
+  std::string best_move_;
+  int score_;
+  // matches only, per search: seats played, won and drawn
+  std::size_t games_;
+  std::size_t wins_;
+  std::size_t draws_;
+  // footprints only, per game: bytes held on the heap and bytes handed out
+  // by the arena of the game
+  double heap_bytes_;
+  double arena_bytes_;
+  // hardware counters of all the operations, empty without counters
+  std::vector<double> counters_;
+};
+
+// Gives access to the protected operations of the board
+class BenchBoard : public IntelligentBoard {
+ public:
+  BenchBoard(const Variant& variant)
+      : IntelligentBoard(GetParties(variant), variant.dimensions_,
+                         variant.num_connected_) {}
+  using IntelligentBoard::SetMoveInc;
+  using ModelBoard::CheckConnected;
+  using ModelBoard::GetDirections;
+  const PieceIDType* GetCells() const { return board_.data(); }
+
+ private:
+  static std::vector<Party> GetParties(const Variant& variant) {
+    std::vector<Party> parties;
+    for(uint8_t turn = 1; turn <= variant.num_players_; turn++) {
+      parties.push_back(Party(turn));
+    }
+    return parties;
+  }
+};
+
+// true if the player to move can win at once
+bool HasWinningMove(BenchBoard& board) {
+  std::vector<ModelBoard::MoveType> moves;
+  board.GetPossibleMoves(moves);
+  bool found = false;
+  for(std::size_t i = 0; !found && i < moves.size(); i++) {
+    board.SetMove(moves[i]);
+    found = board.GetCurrentState() == States::Win;
+    board.Undo();
+  }
+  return found;
+}
+
+// Plays random moves which neither end the game nor give a win in one move,
+// so that the searches do not stop at once. The last condition is dropped
+// when no such move is found.
+void PlayRandomMoves(BenchBoard& board, std::size_t num_moves,
+                     uint32_t seed = kPositionSeed) {
+  std::mt19937 random(seed);
+  std::vector<ModelBoard::MoveType> moves;
+  std::size_t num_rejected = 0;
+  while(board.GetNumPieces() < num_moves) {
+    board.GetPossibleMoves(moves);
+    board.SetMove(moves[random() % moves.size()]);
+    if(board.GetCurrentState() != States::OnGoing ||
+       (num_rejected < kMaxRejectedMoves && HasWinningMove(board))) {
+      board.Undo();
+      num_rejected++;
+    } else {
+      num_rejected = 0;
+    }
+  }
+}
+
+// The column of a move, numbered from 1
+std::string FormatColumn(const ModelBoard::MoveType& move) {
+  std::string column;
+  for(std::size_t i = 1; i < move.size(); i++) {
+    column += (i > 1 ? "." : "") + std::to_string(move[i] + 1);
+  }
+  return column;
+}
+
+class Bench {
+ public:
+  Bench(const std::string& filter, std::chrono::milliseconds min_time)
+      : filter_(filter),
+        min_time_(min_time),
+        counters_(nullptr),
+        passed_(true),
+        sink_(0) {}
+
+  // The counters are read around every benchmark, nullptr to stop
+  void SetCounters(PerfCounters* counters) { counters_ = counters; }
+
+  void RunAll();
+  // false if an optimized computation differs from the reference one
+  bool HasPassed() const { return passed_; }
+  void WriteJson(std::ostream& output) const;
+
+ private:
+  bool IsSelected(const std::string& name) const {
+    return name.find(filter_) != std::string::npos;
+  }
+  // Runs the operation, which does num_ops operations, until min_time_
+  template <typename F>
+  void Measure(const std::string& name, std::size_t num_ops, F operation);
+  void RunMicro(const Variant& variant);
+  // kFootprintGames games held at once: the bytes and allocations of a game,
+  // and the time to free it
+  void RunFootprint(const Variant& variant);
+  // The operations of ModelBoard measured on a BitBoard of the position of
+  // board
+  template <typename Board>
+  void RunBitBoard(Board& bit_board, const BenchBoard& board,
+                   const std::string& prefix);
+  struct BitBoardMicro {
+    Bench* bench_;
+    const BenchBoard* board_;
+    std::string prefix_;
+
+    template <typename Board>
+    void operator()(Board& bit_board) {
+      bench_->RunBitBoard(bit_board, *board_, prefix_);
+    }
+  };
+  void CheckEvaluations(const Variant& variant, WindowEvaluator& evaluator);
+  void RunNeural(const Variant& variant);
+  void CheckNeuralEvaluations(const Variant& variant,
+                              const std::shared_ptr<NeuralNetwork>& network);
+  // The name holds the search of the variants of more than 2 players, and
+  // "generic" when the bitboard of Score Four is not used
+  void RunSearch(const Variant& variant, std::size_t num_moves,
+                 MultiPlayerSearch search, bool score_four_search = true);
+  // The ranking of the best moves of the boards of 2 dimensions, by a
+  // multi-PV search (lines_) and by a search per move (per_move)
+  void RunMultiPV(const Variant& variant);
+  // Games between the multi-player searches, every search plays every seat
+  void RunMatch(const Variant& variant);
+  // The endgame solver (solver) and the search to the end of the game
+  // (search) must find the expected result
+  void RunEndgame(const EndgamePosition& endgame_position);
+  // The proof must find the expected result
+  void RunProof(const TacticalPosition& tactical_position);
+  // The counters between the last start and stop
+  std::vector<double> ReadCounters() const;
+  // Writes the available counters divided by num_ops as a JSON object
+  void WriteCounters(std::ostream& output,
+                     const std::vector<double>& values,
+                     double num_ops) const;
+
+  std::string filter_;
+  std::chrono::milliseconds min_time_;
+  PerfCounters* counters_;
+  std::vector<Result> results_;
+  bool passed_;
+  // keeps the results of the operations alive
+  volatile long long sink_;
+};
+
+template <typename F>
+void Bench::Measure(const std::string& name, std::size_t num_ops, F operation) {
+  if(!IsSelected(name)) {
+    return;
+  }
+  operation();  // warm up
+  std::size_t iterations = 1, allocations;
+  std::chrono::nanoseconds elapsed;
+  while(true) {
+    allocations = num_allocations.load();
+    if(counters_ != nullptr) {
+      counters_->Start();
+    }
+    auto start = std::chrono::steady_clock::now();
+    for(std::size_t i = 0; i < iterations; i++) {
+      operation();
+    }
+    elapsed = std::chrono::steady_clock::now() - start;
+    if(counters_ != nullptr) {
+      counters_->Stop();
+    }
+    allocations = num_allocations.load() - allocations;
+    if(elapsed >= min_time_) {
+      break;
+    }
+    iterations *= elapsed * 2 < min_time_ ? 4 : 2;
+  }
+  double num_total_ops = static_cast<double>(iterations) * num_ops;
+  results_.push_back({name, "micro", iterations * num_ops,
+                      elapsed.count() / num_total_ops,
+                      allocations / num_total_ops, 0, 0, 0, 0.0, "", 0, 0,
+                      0, 0, 0.0, 0.0, ReadCounters()});
+  std::cerr << std::left << std::setw(44) << name << std::right
+            << std::setw(12) << std::fixed << std::setprecision(1)
+            << results_.back().ns_per_op_ << " ns/op" << std::setw(8)
+            << std::setprecision(2) << results_.back().allocations_per_op_
+            << " allocs/op" << std::endl;
+}
+
+void Bench::RunMicro(const Variant& variant) {
+  BenchBoard board(variant);
+  PlayRandomMoves(board, kMidGameMoves[1]);
+  std::string prefix = std::string(variant.name_) + '/';
+  std::vector<ModelBoard::MoveType> cells;
+  ModelBoard::MoveType cell(variant.dimensions_.size(), 0);
+  do {
+    cells.push_back(cell);
+  } while(ModelBoard::NextCoordinates(variant.dimensions_, cell));
+  std::vector<ModelBoard::MoveType> occupied, moves;
+  for(const ModelBoard::MoveType& position : cells) {
+    if(board.GetPiece(position) != kEmptyPosition) {
+      occupied.push_back(position);
+    }
+  }
+  board.GetPossibleMoves(moves);
+
+  MultiDimArray<int8_t> array(variant.dimensions_);
+  array.Fill(1);
+  Measure(prefix + "multi_dim_array/index", cells.size(), [&] {
+    long long sum = 0;
+    for(const ModelBoard::MoveType& position : cells) {
+      sum += array[position];
+    }
+    sink_ = sink_ + sum;
+  });
+  Measure(prefix + "model_board/construct", 1, [&] {
+    ModelBoard constructed(board.GetPieceIDs(), variant.dimensions_,
+                           variant.num_connected_);
+    sink_ = sink_ + constructed.GetNumPieces();
+  });
+  Measure(prefix + "intelligent_board/construct", 1, [&] {
+    BenchBoard constructed(variant);
+    sink_ = sink_ + constructed.GetNumPieces();
+  });
+  Measure(prefix + "model_board/set_move_undo", moves.size(), [&] {
+    for(const ModelBoard::MoveType& move : moves) {
+      board.SetMoveInc(move);
+      board.Undo();
+    }
+  });
+  Measure(prefix + "model_board/check_connected", occupied.size(), [&] {
+    long long sum = 0;
+    for(const ModelBoard::MoveType& position : occupied) {
+      sum += board.CheckConnected(position);
+    }
+    sink_ = sink_ + sum;
+  });
+  Measure(prefix + "model_board/get_possible_moves", 1, [&] {
+    board.GetPossibleMoves(moves);
+    sink_ = sink_ + moves.size();
+  });
+  BitBoardMicro bit_board_micro = {this, &board, prefix};
+  CallWithBitBoard(board.GetPieceIDs(), variant.dimensions_,
+                   variant.num_connected_, bit_board_micro);
+  Measure(prefix + "intelligent_board/evaluate_grid", 1, [&] {
+    sink_ = sink_ + board.EvaluateGrid(board.GetNextChipId());
+  });
+  Measure(prefix + "intelligent_board/evaluate_patterns", 1, [&] {
+    sink_ = sink_ + board.EvaluatePatterns(board.GetNextChipId());
+  });
+  if(!WindowEvaluator::IsSupported(variant.dimensions_,
+                                   variant.num_connected_)) {
+    return;
+  }
+  WindowEvaluator evaluator(variant.dimensions_, board.GetDirections(),
+                            variant.num_connected_, board.GetPieceIDs(),
+                            kWinScore, kThreatScore);
+  WindowEvaluator::Scratch scratch;
+  for(InstructionSet instruction_set : kInstructionSets) {
+    if(!WindowEvaluator::IsAvailable(instruction_set)) {
+      continue;
+    }
+    evaluator.SetInstructionSet(instruction_set);
+    Measure(prefix + "window_evaluator/" +
+                WindowEvaluator::GetName(instruction_set),
+            1, [&] {
+              sink_ = sink_ + evaluator.Evaluate(board.GetCells(),
+                                                 board.GetNextChipId(),
+                                                 board.GetNextChipId(),
+                                                 scratch);
+            });
+  }
+  CheckEvaluations(variant, evaluator);
+}
+
+// The WindowEvaluator must give the scores of the patterns
+template <typename Board>
+void Bench::RunBitBoard(Board& bit_board, const BenchBoard& board,
+                        const std::string& prefix) {
+  std::vector<ModelBoard::PieceIDType> cells;
+  std::vector<ModelBoard::MoveType> occupied, moves;
+  ModelBoard::MoveType cell(board.GetDimensions().size(), 0);
+  do {
+    cells.push_back(board.GetPiece(cell));
+    if(cells.back() != kEmptyPosition) {
+      occupied.push_back(cell);
+    }
+  } while(ModelBoard::NextCoordinates(board.GetDimensions(), cell));
+  if(!bit_board.SetPosition(cells, board.GetNextChipId())) {
+    std::cerr << prefix << "bit_board: invalid position" << std::endl;
+    passed_ = false;
+    return;
+  }
+  bit_board.GetPossibleMoves(moves);
+  Measure(prefix + "bit_board/set_move_undo", moves.size(), [&] {
+    for(const ModelBoard::MoveType& move : moves) {
+      bit_board.SetMove(move);
+      bit_board.Undo();
+    }
+  });
+  Measure(prefix + "bit_board/is_winning_move", occupied.size(), [&] {
+    long long sum = 0;
+    for(const ModelBoard::MoveType& position : occupied) {
+      sum += bit_board.IsWinningMove(position, bit_board.GetPiece(position));
+    }
+    sink_ = sink_ + sum;
+  });
+  Measure(prefix + "bit_board/get_possible_moves", 1, [&] {
+    bit_board.GetPossibleMoves(moves);
+    sink_ = sink_ + moves.size();
+  });
+}
+
+void Bench::CheckEvaluations(const Variant& variant,
+                             WindowEvaluator& evaluator) {
+  WindowEvaluator::Scratch scratch;
+  std::mt19937 random(kPositionSeed);
+  std::vector<ModelBoard::MoveType> moves;
+  BenchBoard board(variant);
+  for(std::size_t game = 0; game < kNumCheckedGames;) {
+    for(InstructionSet instruction_set : kInstructionSets) {
+      if(!WindowEvaluator::IsAvailable(instruction_set)) {
+        continue;
+      }
+      evaluator.SetInstructionSet(instruction_set);
+      for(ModelBoard::PieceIDType chip : board.GetPieceIDs()) {
+        if(evaluator.Evaluate(board.GetCells(), chip, board.GetNextChipId(),
+                              scratch) != board.EvaluatePatterns(chip)) {
+          std::cerr << variant.name_ << ": the "
+                    << WindowEvaluator::GetName(instruction_set)
+                    << " evaluation differs after " << board.GetNumPieces()
+                    << " moves" << std::endl;
+          passed_ = false;
+        }
+      }
+    }
+    board.GetPossibleMoves(moves);
+    if(board.GetCurrentState() != States::OnGoing || moves.empty()) {
+      while(board.GetNumPieces() > 0) {
+        board.Undo();
+      }
+      game++;
+    } else {
+      board.SetMove(moves[random() % moves.size()]);
+    }
+  }
+}
+
+void Bench::RunSearch(const Variant& variant, std::size_t num_moves,
+                      MultiPlayerSearch search, bool score_four_search) {
+  std::ostringstream name;
+  name << variant.name_ << "/search/";
+  if(variant.num_players_ > 2) {
+    name << GetMultiPlayerSearchName(search) << '/';
+  }
+  if(!score_four_search) {
+    name << "generic/";
+  }
+  name << num_moves << "_moves/depth_" << static_cast<int>(variant.depth_);
+  if(!IsSelected(name.str())) {
+    return;
+  }
+  BenchBoard board(variant);
+  EvaluationCache eval_cache;
+  board.SetEvaluationCache(&eval_cache);
+  board.SetMultiPlayerSearch(search);
+  board.SetScoreFourSearch(score_four_search);
+  PlayRandomMoves(board, num_moves);
+  SearchLimits limits;
+  limits.depth_ = variant.depth_;
+  ModelBoard::MoveType best_move;
+  std::size_t allocations = num_allocations.load();
+  if(counters_ != nullptr) {
+    counters_->Start();
+  }
+  auto start = std::chrono::steady_clock::now();
+  board.Search(limits, best_move);
+  std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+  if(counters_ != nullptr) {
+    counters_->Stop();
+  }
+  allocations = num_allocations.load() - allocations;
+  std::size_t nodes = board.GetNumNodes();
+  results_.push_back({name.str(), "search", 1,
+                      static_cast<double>(elapsed.count()),
+                      static_cast<double>(allocations), nodes,
+                      board.GetNumEvaluations(), board.GetNumEvalCacheHits(),
+                      nodes * 1e9 / std::max<long long>(elapsed.count(), 1),
+                      FormatColumn(best_move), board.GetLastScore(), 0, 0, 0,
+                      0.0, 0.0, ReadCounters()});
+  std::cerr << std::left << std::setw(44) << name.str() << std::right
+            << std::setw(12) << std::fixed << std::setprecision(0)
+            << results_.back().nodes_per_second_ << " nodes/s" << std::setw(10)
+            << nodes << " nodes " << std::setprecision(1)
+            << elapsed.count() / 1e6 << " ms" << std::endl;
+}
+
+// The score of a search per move is the one of the best move, from the point
+// of view of the player to move
+void Bench::RunMultiPV(const Variant& variant) {
+  std::ostringstream prefix;
+  prefix << variant.name_ << "/multi_pv/" << kMidGameMoves[1]
+         << "_moves/depth_" << static_cast<int>(variant.depth_) << '/';
+  if(variant.dimensions_.size() != 2 || !IsSelected(prefix.str())) {
+    return;
+  }
+  std::string name = prefix.str() + "lines_" + std::to_string(kMultiPVLines);
+  BenchBoard board(variant);
+  PlayRandomMoves(board, kMidGameMoves[1]);
+  TranspositionTable table(kMultiPVTableMegabytes);
+  EvaluationCache eval_cache;
+  board.SetTranspositionTable(&table);
+  board.SetEvaluationCache(&eval_cache);
+  SearchLimits limits;
+  limits.depth_ = variant.depth_;
+  limits.multi_pv_ = kMultiPVLines;
+  ModelBoard::MoveType best_move;
+  std::size_t allocations = num_allocations.load();
+  auto start = std::chrono::steady_clock::now();
+  board.Search(limits, best_move);
+  std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+  allocations = num_allocations.load() - allocations;
+  std::size_t nodes = board.GetNumNodes();
+  results_.push_back({name, "search", 1, static_cast<double>(elapsed.count()),
+                      static_cast<double>(allocations), nodes,
+                      board.GetNumEvaluations(), board.GetNumEvalCacheHits(),
+                      nodes * 1e9 / std::max<long long>(elapsed.count(), 1),
+                      FormatColumn(best_move), board.GetLastScore(), 0, 0, 0,
+                      0.0, 0.0, std::vector<double>()});
+  std::cerr << std::left << std::setw(44) << name << std::right
+            << std::setw(12) << std::fixed << std::setprecision(0)
+            << results_.back().nodes_per_second_ << " nodes/s" << std::setw(10)
+            << nodes << " nodes " << std::setprecision(1)
+            << elapsed.count() / 1e6 << " ms" << std::endl;
+
+  name = prefix.str() + "per_move";
+  table.Clear();
+  eval_cache.Clear();
+  std::vector<ModelBoard::MoveType> moves;
+  board.GetPossibleMoves(moves);
+  limits.depth_ = variant.depth_ - 1;
+  limits.multi_pv_ = 1;
+  ModelBoard::MoveType reply;
+  std::size_t evaluations = 0, eval_cache_hits = 0;
+  int best_score = 0;
+  nodes = 0;
+  allocations = num_allocations.load();
+  start = std::chrono::steady_clock::now();
+  for(std::size_t i = 0; i < moves.size(); i++) {
+    const ModelBoard::MoveType& move = moves[i];
+    board.SetMove(move);
+    // score of the player to move after the move
+    int score = board.GetCurrentState() == States::Win
+                    ? -std::numeric_limits<int>::max()
+                    : 0;
+    if(board.GetCurrentState() == States::OnGoing) {
+      board.Search(limits, reply);
+      score = board.GetLastScore();
+      nodes += board.GetNumNodes();
+      evaluations += board.GetNumEvaluations();
+      eval_cache_hits += board.GetNumEvalCacheHits();
+    }
+    board.Undo();
+    if(i == 0 || -score > best_score) {
+      best_score = -score;
+      best_move = move;
+    }
+  }
+  elapsed = std::chrono::steady_clock::now() - start;
+  allocations = num_allocations.load() - allocations;
+  results_.push_back({name, "search", 1, static_cast<double>(elapsed.count()),
+                      static_cast<double>(allocations), nodes, evaluations,
+                      eval_cache_hits,
+                      nodes * 1e9 / std::max<long long>(elapsed.count(), 1),
+                      FormatColumn(best_move), best_score, 0, 0, 0, 0.0, 0.0,
+                      std::vector<double>()});
+  std::cerr << std::left << std::setw(44) << name << std::right
+            << std::setw(12) << std::fixed << std::setprecision(0)
+            << results_.back().nodes_per_second_ << " nodes/s" << std::setw(10)
+            << nodes << " nodes " << std::setprecision(1)
+            << elapsed.count() / 1e6 << " ms" << std::endl;
+}
+
+// The scores are those of the searches
+void Bench::RunEndgame(const EndgamePosition& endgame_position) {
+  std::string prefix = std::string(endgame_position.name_) + '/';
+  if(!IsSelected(prefix)) {
+    return;
+  }
+  Position position;
+  if(!ParsePosition(endgame_position.position_, position)) {
+    std::cerr << endgame_position.name_ << ": invalid position" << std::endl;
+    passed_ = false;
+    return;
+  }
+  std::vector<IntelligentBoard::Party> parties;
+  for(uint8_t turn = 1; turn <= position.num_players_; turn++) {
+    parties.push_back(IntelligentBoard::Party(turn));
+  }
+  IntelligentBoard board(parties, position.dimensions_,
+                         position.num_win_connected_);
+  SetPosition(position, board);
+  board.SetEndgameCells(GetNumCells(position.dimensions_));
+  const int kExpectedScores[] = {-std::numeric_limits<int>::max(), 0,
+                                 std::numeric_limits<int>::max()};
+  int expected_score =
+      kExpectedScores[static_cast<int>(endgame_position.expected_)];
+  for(int solve = 1; solve >= 0; solve--) {
+    std::string name = prefix + (solve ? "solver" : "search");
+    if(!IsSelected(name)) {
+      continue;
+    }
+    TranspositionTable table;
+    EndgameSolver endgame_solver;
+    board.SetTranspositionTable(solve ? nullptr : &table);
+    board.SetEndgameSolver(solve ? &endgame_solver : nullptr);
+    SearchLimits limits;
+    ModelBoard::MoveType best_move;
+    std::size_t allocations = num_allocations.load();
+    if(counters_ != nullptr) {
+      counters_->Start();
+    }
+    auto start = std::chrono::steady_clock::now();
+    board.Search(limits, best_move);
+    std::chrono::nanoseconds elapsed =
+        std::chrono::steady_clock::now() - start;
+    if(counters_ != nullptr) {
+      counters_->Stop();
+    }
+    allocations = num_allocations.load() - allocations;
+    // a draw is any score short of a win
+    int score = board.GetLastScore();
+    if(board.IsWinScore(score) ? score != expected_score
+                               : expected_score != 0) {
+      std::cerr << name << ": unexpected result of the search" << std::endl;
+      passed_ = false;
+    }
+    std::size_t nodes = board.GetNumNodes();
+    results_.push_back({name, "search", 1,
+                        static_cast<double>(elapsed.count()),
+                        static_cast<double>(allocations), nodes,
+                        board.GetNumEvaluations(), board.GetNumEvalCacheHits(),
+                        nodes * 1e9 / std::max<long long>(elapsed.count(), 1),
+                        FormatColumn(best_move), score, 0, 0, 0, 0.0, 0.0,
+                        ReadCounters()});
+    std::cerr << std::left << std::setw(44) << name << std::right
+              << std::setw(12) << std::fixed << std::setprecision(0)
+              << results_.back().nodes_per_second_ << " nodes/s"
+              << std::setw(10) << nodes << " nodes " << std::setprecision(1)
+              << elapsed.count() / 1e6 << " ms" << std::endl;
+  }
+}
+
+// The score is 1 for a proven win, -1 if disproven and 0 if unknown
+void Bench::RunProof(const TacticalPosition& tactical_position) {
+  if(!IsSelected(tactical_position.name_)) {
+    return;
+  }
+  Position position;
+  if(!ParsePosition(tactical_position.position_, position)) {
+    std::cerr << tactical_position.name_ << ": invalid position" << std::endl;
+    passed_ = false;
+    return;
+  }
+  std::vector<IntelligentBoard::Party> parties;
+  for(uint8_t turn = 1; turn <= position.num_players_; turn++) {
+    parties.push_back(IntelligentBoard::Party(turn));
+  }
+  IntelligentBoard board(parties, position.dimensions_,
+                         position.num_win_connected_);
+  SetPosition(position, board);
+  ProofSearch proof_search;
+  std::vector<ModelBoard::MoveType> line;
+  std::size_t allocations = num_allocations.load();
+  if(counters_ != nullptr) {
+    counters_->Start();
+  }
+  auto start = std::chrono::steady_clock::now();
+  ProofStatus status = proof_search.Solve(board, ProofLimits(), line);
+  std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+  if(counters_ != nullptr) {
+    counters_->Stop();
+  }
+  allocations = num_allocations.load() - allocations;
+  if(status != tactical_position.expected_) {
+    std::cerr << tactical_position.name_ << ": unexpected result of the proof"
+              << std::endl;
+    passed_ = false;
+  }
+  std::size_t nodes = proof_search.GetNumNodes();
+  results_.push_back({tactical_position.name_, "proof", 1,
+                      static_cast<double>(elapsed.count()),
+                      static_cast<double>(allocations), nodes, 0, 0,
+                      nodes * 1e9 / std::max<long long>(elapsed.count(), 1),
+                      line.empty() ? "" : FormatColumn(line.front()),
+                      status == ProofStatus::Proven
+                          ? 1
+                          : (status == ProofStatus::Disproven ? -1 : 0),
+                      0, 0, 0, 0.0, 0.0, ReadCounters()});
+  std::cerr << std::left << std::setw(44) << tactical_position.name_
+            << std::right << std::setw(12) << std::fixed
+            << std::setprecision(0) << results_.back().nodes_per_second_
+            << " nodes/s" << std::setw(10) << nodes << " nodes "
+            << std::setprecision(1) << elapsed.count() / 1e6 << " ms"
+            << std::endl;
+}
+
+// The seats are given the searches in every order, the players beyond the
+// third repeat the order. The nodes are those of the moves of the search.
+void Bench::RunMatch(const Variant& variant) {
+  std::string prefix = std::string(variant.name_) + "/match/nodes_" +
+                       std::to_string(kMatchNodes) + '/';
+  if(!IsSelected(prefix)) {
+    return;
+  }
+  std::vector<Result> results;
+  std::chrono::nanoseconds elapsed[kNumMultiPlayerSearches] = {};
+  for(MultiPlayerSearch search : kMultiPlayerSearches) {
+    results.push_back({prefix + GetMultiPlayerSearchName(search), "match", 0,
+                       0.0, 0.0, 0, 0, 0, 0.0, "", 0, 0, 0, 0, 0.0, 0.0,
+                       std::vector<double>()});
+  }
+  std::size_t order[] = {0, 1, 2};
+  SearchLimits limits;
+  limits.nodes_ = kMatchNodes;
+  ModelBoard::MoveType move;
+  do {
+    for(std::size_t num_moves : kMatchOpeningMoves) {
+      BenchBoard board(variant);
+      PlayRandomMoves(board, num_moves,
+                      kPositionSeed + static_cast<uint32_t>(num_moves));
+      const std::vector<ModelBoard::PieceIDType>& piece_IDs =
+          board.GetPieceIDs();
+      while(board.GetCurrentState() == States::OnGoing) {
+        std::size_t seat =
+            std::find(piece_IDs.begin(), piece_IDs.end(),
+                      board.GetNextChipId()) - piece_IDs.begin();
+        std::size_t index = order[seat % kNumMultiPlayerSearches];
+        board.SetMultiPlayerSearch(kMultiPlayerSearches[index]);
+        auto start = std::chrono::steady_clock::now();
+        board.Search(limits, move);
+        elapsed[index] += std::chrono::steady_clock::now() - start;
+        results[index].iterations_++;
+        results[index].nodes_ += board.GetNumNodes();
+        board.SetMove(move);
+      }
+      for(std::size_t seat = 0; seat < piece_IDs.size(); seat++) {
+        Result& result = results[order[seat % kNumMultiPlayerSearches]];
+        result.games_++;
+        if(board.GetCurrentState() == States::Draw) {
+          result.draws_++;
+        } else if(board.GetCurrentChipId() == piece_IDs[seat]) {
+          result.wins_++;
+        }
+      }
+    }
+  } while(std::next_permutation(order, order + kNumMultiPlayerSearches));
+  for(std::size_t i = 0; i < kNumMultiPlayerSearches; i++) {
+    Result& result = results[i];
+    result.ns_per_op_ = elapsed[i].count() /
+                        static_cast<double>(std::max<std::size_t>(
+                            result.iterations_, 1));
+    result.nodes_per_second_ =
+        result.nodes_ * 1e9 / std::max<long long>(elapsed[i].count(), 1);
+    result.score_ = static_cast<int>(
+        (result.wins_ * 2 + result.draws_) * 1000 /
+        std::max<std::size_t>(result.games_ * 2, 1));
+    results_.push_back(result);
+    std::cerr << std::left << std::setw(44) << result.name_ << std::right
+              << std::setw(12) << std::fixed << std::setprecision(0)
+              << result.nodes_per_second_ << " nodes/s" << std::setw(6)
+              << result.wins_ << " wins" << std::setw(6) << result.draws_
+              << " draws" << std::setw(6) << result.games_ << " seats"
+              << std::endl;
+  }
+}
+
+std::vector<double> Bench::ReadCounters() const {
+  std::vector<double> values;
+  for(int i = 0; counters_ != nullptr && i < PerfCounters::kNumCounters;
+      i++) {
+    values.push_back(counters_->Get(static_cast<PerfCounters::Counter>(i)));
+  }
+  return values;
+}
+
+void Bench::RunFootprint(const Variant& variant) {
+  std::string name = std::string(variant.name_) + "/footprint/games_" +
+                     std::to_string(kFootprintGames);
+  if(!IsSelected(name)) {
+    return;
+  }
+  std::size_t num_cells = 1;
+  for(std::size_t dimension : variant.dimensions_) {
+    num_cells *= dimension;
+  }
+  // the caches of the shape are filled before the measure
+  BenchBoard cached(variant);
+  PlayRandomMoves(cached, num_cells / 2);
+  std::vector<std::unique_ptr<BenchBoard> > games(kFootprintGames);
+  std::size_t allocations = num_allocations.load();
+  std::size_t heap_bytes = num_heap_bytes.load();
+  double arena_bytes = 0;
+  for(std::size_t game = 0; game < kFootprintGames; game++) {
+    games[game].reset(new BenchBoard(variant));
+    PlayRandomMoves(*games[game], num_cells / 2,
+                    kPositionSeed + static_cast<uint32_t>(game));
+    arena_bytes += games[game]->GetArena().GetNumUsedBytes();
+  }
+  allocations = num_allocations.load() - allocations;
+  heap_bytes = num_heap_bytes.load() - heap_bytes;
+  auto start = std::chrono::steady_clock::now();
+  games.clear();
+  std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+  results_.push_back({name, "footprint", kFootprintGames,
+                      elapsed.count() / static_cast<double>(kFootprintGames),
+                      allocations / static_cast<double>(kFootprintGames), 0,
+                      0, 0, 0.0, "", 0, 0, 0, 0,
+                      heap_bytes / static_cast<double>(kFootprintGames),
+                      arena_bytes / kFootprintGames, std::vector<double>()});
+  std::cerr << std::left << std::setw(44) << name << std::right
+            << std::setw(10) << std::fixed << std::setprecision(0)
+            << results_.back().heap_bytes_ << " B/game" << std::setw(8)
+            << results_.back().arena_bytes_ << " B in arena" << std::setw(8)
+            << results_.back().allocations_per_op_ << " allocs"
+            << std::setw(8) << results_.back().ns_per_op_ << " ns free"
+            << std::endl;
+}
+
+// A network of random weights, as fast as a trained one
+void Bench::RunNeural(const Variant& variant) {
+  std::shared_ptr<NeuralNetwork> network(new NeuralNetwork());
+  network->Initialize(variant.dimensions_, variant.num_connected_, 2,
+                      kBenchHiddenSize, kPositionSeed);
+  BenchBoard board(variant);
+  board.SetNeuralNetwork(network);
+  PlayRandomMoves(board, kMidGameMoves[1]);
+  std::string prefix = std::string(variant.name_) + "/neural/";
+  std::vector<ModelBoard::MoveType> moves;
+  board.GetPossibleMoves(moves);
+  for(InstructionSet instruction_set : kInstructionSets) {
+    if(!WindowEvaluator::IsAvailable(instruction_set)) {
+      continue;
+    }
+    network->SetInstructionSet(instruction_set);
+    std::string suffix =
+        std::string("/") + WindowEvaluator::GetName(instruction_set);
+    Measure(prefix + "set_move_undo" + suffix, moves.size(), [&] {
+      for(const ModelBoard::MoveType& move : moves) {
+        board.SetMoveInc(move);
+        board.Undo();
+      }
+    });
+    Measure(prefix + "evaluate" + suffix, 1, [&] {
+      sink_ = sink_ + board.EvaluateGrid(board.GetNextChipId());
+    });
+  }
+  if(IsSelected(prefix)) {
+    CheckNeuralEvaluations(variant, network);
+  }
+}
+
+// The accumulators updated by the moves must give the scores of the
+// accumulators computed from the cells, with every instruction set
+void Bench::CheckNeuralEvaluations(
+    const Variant& variant,
+    const std::shared_ptr<NeuralNetwork>& network) {
+  std::mt19937 random(kPositionSeed);
+  std::vector<ModelBoard::MoveType> moves;
+  std::vector<ModelBoard::PieceIDType> cells;
+  BenchBoard board(variant), reference(variant);
+  std::shared_ptr<NeuralNetwork> reference_network(new NeuralNetwork(*network));
+  reference_network->SetInstructionSet(InstructionSet::Scalar);
+  board.SetNeuralNetwork(network);
+  reference.SetNeuralNetwork(reference_network);
+  for(std::size_t game = 0; game < kNumCheckedGames;) {
+    cells.clear();
+    ModelBoard::MoveType cell(variant.dimensions_.size(), 0);
+    do {
+      cells.push_back(board.GetPiece(cell));
+    } while(ModelBoard::NextCoordinates(variant.dimensions_, cell));
+    reference.SetPosition(cells, board.GetNextChipId());
+    for(InstructionSet instruction_set : kInstructionSets) {
+      if(!WindowEvaluator::IsAvailable(instruction_set)) {
+        continue;
+      }
+      network->SetInstructionSet(instruction_set);
+      for(ModelBoard::PieceIDType chip : board.GetPieceIDs()) {
+        if(board.EvaluateGrid(chip) != reference.EvaluateGrid(chip)) {
+          std::cerr << variant.name_ << ": the "
+                    << WindowEvaluator::GetName(instruction_set)
+                    << " neural evaluation differs after "
+                    << board.GetNumPieces() << " moves" << std::endl;
+          passed_ = false;
+        }
+      }
+    }
+    board.GetPossibleMoves(moves);
+    if(board.GetCurrentState() != States::OnGoing || moves.empty()) {
+      while(board.GetNumPieces() > 0) {
+        board.Undo();
+      }
+      game++;
+    } else {
+      board.SetMove(moves[random() % moves.size()]);
+    }
+  }
+}
+
+void Bench::RunAll() {
+  for(const Variant& variant : kVariants) {
+    RunMicro(variant);
+    RunFootprint(variant);
+    RunNeural(variant);
+  }
+  for(const Variant& variant : kVariants) {
+    RunSearch(variant, 0, MultiPlayerSearch::Paranoid);
+    for(std::size_t num_moves : kMidGameMoves) {
+      RunSearch(variant, num_moves, MultiPlayerSearch::Paranoid);
+    }
+  }
+  RunSearch(kGenericScoreFourVariant, 0, MultiPlayerSearch::Paranoid, false);
+  for(const Variant& variant : kVariants) {
+    RunMultiPV(variant);
+  }
+  for(const Variant& variant : kMultiPlayerVariants) {
+    for(MultiPlayerSearch search : kMultiPlayerSearches) {
+      RunSearch(variant, kMidGameMoves[1], search);
+    }
+    RunMatch(variant);
+  }
+  for(const EndgamePosition& endgame_position : kEndgamePositions) {
+    RunEndgame(endgame_position);
+  }
+  for(const TacticalPosition& tactical_position : kTacticalPositions) {
+    RunProof(tactical_position);
+  }
+}
+
+std::string EscapeJson(const std::string& text) {
+  std::string escaped;
+  for(char symbol : text) {
+    if(symbol == '"' || symbol == '\\') {
+      escaped += '\\';
+    }
+    escaped += symbol;
+  }
+  return escaped;
+}
+
+void Bench::WriteCounters(std::ostream& output,
+                          const std::vector<double>& values,
+                          double num_ops) const {
+  const char* separator = "";
+  output << "{";
+  for(int i = 0; i < PerfCounters::kNumCounters; i++) {
+    PerfCounters::Counter counter = static_cast<PerfCounters::Counter>(i);
+    if(counters_->IsAvailable(counter)) {
+      output << separator << '"' << PerfCounters::GetName(counter) << "\": "
+             << std::setprecision(3) << values[i] / std::max(num_ops, 1.0);
+      separator = ", ";
+    }
+  }
+  output << "}";
+}
+
+void Bench::WriteJson(std::ostream& output) const {
+  char date[32];
+  std::time_t now = std::time(nullptr);
+  std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+  output << "{\n  \"schema\": " << kSchemaVersion << ",\n  \"date\": \""
+         << date << "\",\n  \"compiler\": \"" << EscapeJson(__VERSION__)
+         << "\",\n  \"min_time_ms\": " << min_time_.count()
+         << ",\n  \"counters\": " << (counters_ != nullptr ? "true" : "false")
+         << ",\n  \"benchmarks\": [";
+  output << std::fixed;
+  for(std::size_t i = 0; i < results_.size(); i++) {
+    const Result& result = results_[i];
+    output << (i > 0 ? "," : "") << "\n    {\"name\": \""
+           << EscapeJson(result.name_) << "\", \"kind\": \"" << result.kind_
+           << "\", \"iterations\": " << result.iterations_
+           << ", \"ns_per_op\": " << std::setprecision(2) << result.ns_per_op_
+           << ", \"allocations_per_op\": " << std::setprecision(3)
+           << result.allocations_per_op_;
+    if(result.kind_ == "footprint") {
+      output << ", \"heap_bytes_per_game\": " << std::setprecision(0)
+             << result.heap_bytes_ << ", \"arena_bytes_per_game\": "
+             << result.arena_bytes_;
+    } else if(result.kind_ != "micro") {
+      output << ", \"nodes\": " << result.nodes_ << ", \"nodes_per_second\": "
+             << std::setprecision(0) << result.nodes_per_second_
+             << ", \"evaluations\": " << result.evaluations_
+             << ", \"eval_cache_hits\": " << result.eval_cache_hits_
+             << ", \"best_move\": \"" << result.best_move_
+             << "\", \"score\": " << result.score_;
+    }
+    if(result.kind_ == "match") {
+      output << ", \"games\": " << result.games_ << ", \"wins\": "
+             << result.wins_ << ", \"draws\": " << result.draws_;
+    }
+    if(!result.counters_.empty() && result.kind_ != "micro") {
+      output << ", \"counters_per_node\": ";
+      WriteCounters(output, result.counters_, result.nodes_);
+      if(result.kind_ == "search") {
+        output << ", \"counters_per_evaluation\": ";
+        WriteCounters(output, result.counters_, result.evaluations_);
+      }
+    } else if(!result.counters_.empty()) {
+      output << ", \"counters_per_op\": ";
+      WriteCounters(output, result.counters_, result.iterations_);
+    }
+    output << "}";
+  }
+  output << "\n  ]\n}" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::string filter, output_file;
+  long min_time = 200;
+  bool use_counters = false;
+  for(int i = 1; i < argc; i++) {
+    std::string argument = argv[i];
+    if(argument == "--filter" && i + 1 < argc) {
+      filter = argv[++i];
+    } else if(argument == "--min-time" && i + 1 < argc) {
+      min_time = std::atol(argv[++i]);
+    } else if(argument == "--output" && i + 1 < argc) {
+      output_file = argv[++i];
+    } else if(argument == "--counters") {
+      use_counters = true;
+    } else {
+      std::cerr << kUsageMsg << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  if(min_time <= 0) {
+    std::cerr << kUsageMsg << std::endl;
+    return EXIT_FAILURE;
+  }
+  Bench bench(filter, std::chrono::milliseconds(min_time));
+  PerfCounters counters;
+  std::string error;
+  if(use_counters) {
+    if(counters.Open(error)) {
+      bench.SetCounters(&counters);
+    } else {
+      std::cerr << "hardware counters unavailable (" << error
+                << "), running without them" << std::endl;
+    }
+  }
+  bench.RunAll();
+  if(!bench.HasPassed()) {
+    return EXIT_FAILURE;
+  }
+  if(output_file.empty()) {
+    bench.WriteJson(std::cout);
+  } else {
+    std::ofstream output(output_file);
+    bench.WriteJson(output);
+    if(!output) {
+      std::cerr << "cannot write " << output_file << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
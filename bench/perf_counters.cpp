@@ -0,0 +1,131 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Hardware performance counters of the calling thread (Linux
+//               perf_event_open).
+//============================================================================
+#include "perf_counters.h"
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace {
+
+const char* const kCounterNames[PerfCounters::kNumCounters] = {
+    "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses"};
+
+#ifdef __linux__
+struct EventType {
+  uint32_t type_;
+  uint64_t config_;
+};
+
+const EventType kEventTypes[PerfCounters::kNumCounters] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D |
+                             (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                             (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES}};
+
+// value, time enabled and time running (PERF_FORMAT_TOTAL_TIME_*)
+struct ReadFormat {
+  uint64_t value_;
+  uint64_t time_enabled_;
+  uint64_t time_running_;
+};
+
+int OpenEvent(const EventType& event) {
+  perf_event_attr attributes;
+  std::memset(&attributes, 0, sizeof(attributes));
+  attributes.size = sizeof(attributes);
+  attributes.type = event.type_;
+  attributes.config = event.config_;
+  attributes.disabled = 1;
+  attributes.exclude_kernel = 1;
+  attributes.exclude_hv = 1;
+  attributes.read_format =
+      PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  return static_cast<int>(
+      syscall(__NR_perf_event_open, &attributes, 0, -1, -1, 0));
+}
+#endif
+
+}  // namespace
+
+PerfCounters::PerfCounters() {
+  for(int i = 0; i < kNumCounters; i++) {
+    fds_[i] = -1;
+    values_[i] = 0.0;
+  }
+}
+
+PerfCounters::~PerfCounters() {
+#ifdef __linux__
+  for(int fd : fds_) {
+    if(fd >= 0) {
+      close(fd);
+    }
+  }
+#endif
+}
+
+bool PerfCounters::Open(std::string& error) {
+#ifdef __linux__
+  bool opened = false;
+  for(int i = 0; i < kNumCounters; i++) {
+    fds_[i] = OpenEvent(kEventTypes[i]);
+    if(fds_[i] >= 0) {
+      opened = true;
+    } else if(error.empty()) {
+      error = std::string("perf_event_open: ") + std::strerror(errno);
+    }
+  }
+  return opened;
+#else
+  error = "performance counters are only supported on Linux";
+  return false;
+#endif
+}
+
+void PerfCounters::Start() {
+#ifdef __linux__
+  for(int fd : fds_) {
+    if(fd >= 0) {
+      ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+      ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+#endif
+}
+
+void PerfCounters::Stop() {
+#ifdef __linux__
+  for(int fd : fds_) {
+    if(fd >= 0) {
+      ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+  }
+  for(int i = 0; i < kNumCounters; i++) {
+    ReadFormat counts;
+    values_[i] = 0.0;
+    if(fds_[i] >= 0 &&
+       read(fds_[i], &counts, sizeof(counts)) == sizeof(counts) &&
+       counts.time_running_ > 0) {
+      values_[i] = static_cast<double>(counts.value_) *
+                   counts.time_enabled_ / counts.time_running_;
+    }
+  }
+#endif
+}
+
+const char* PerfCounters::GetName(Counter counter) {
+  return kCounterNames[counter];
+}
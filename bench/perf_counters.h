@@ -0,0 +1,54 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Hardware performance counters of the calling thread (Linux
+//               perf_event_open).
+//============================================================================
+#ifndef CONNECTX_PERF_COUNTERS_H_
+#define CONNECTX_PERF_COUNTERS_H_
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @class PerfCounters
+ * @brief Counts the events of the thread between Start and Stop, in user
+ * space only so an unprivileged process can use them. Every counter is
+ * opened on its own: the ones the processor, the kernel or the container do
+ * not provide are left out and the others still work. The counts are scaled
+ * when the kernel multiplexes the counters.
+ */
+class PerfCounters {
+ public:
+  enum Counter {
+    kCycles,
+    kInstructions,
+    kL1DataMisses,
+    kLastLevelMisses,
+    kBranchMisses,
+    kNumCounters
+  };
+
+  PerfCounters();
+  ~PerfCounters();
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+
+  // Returns false if no counter is available, error then tells why
+  bool Open(std::string& error);
+  bool IsAvailable(Counter counter) const { return fds_[counter] >= 0; }
+  void Start();
+  void Stop();
+  // Count of the last Start/Stop, 0 if the counter is not available
+  double Get(Counter counter) const { return values_[counter]; }
+
+  // Name used in the JSON output
+  static const char* GetName(Counter counter);
+
+ private:
+  int fds_[kNumCounters];
+  double values_[kNumCounters];
+};
+
+#endif  // CONNECTX_PERF_COUNTERS_H_
@@ -0,0 +1,75 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Search deepening on a position in the background while a
+//               human player thinks.
+//============================================================================
+#ifndef CONNECTX_BACKGROUND_ANALYSIS_H_
+#define CONNECTX_BACKGROUND_ANALYSIS_H_
+
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "intelligent_board.h"
+
+namespace Core {
+
+// Best move of the last completed iteration of the analysis
+struct AnalysisReport {
+  ModelBoard::MoveType move_;
+  // from the side of the player to move
+  int score_ = 0;
+  bool win_score_ = false;
+  DepthType depth_ = 0;
+  std::size_t nodes_ = 0;
+  // iterations completed since the analysis started, 0 before the first one
+  std::size_t num_iterations_ = 0;
+};
+
+/**
+ * @class BackgroundAnalysis
+ * @brief Searches a copy of a position on a thread of its own, one iteration
+ * deeper after the other without limit, and keeps the best move of the last
+ * completed iteration for the interface to poll. Stop returns within 1024
+ * nodes of the search. The table and the evaluation cache are kept from one
+ * position to the next of a variant, the analysis after a move starts from
+ * the entries of the previous one. Once few cells are left the search ends with the
+ * solution of the endgame.
+ * The copy shares the bitboard of Score Four with the board it comes from:
+ * that board must not be searched nor played until the analysis is stopped.
+ */
+class BackgroundAnalysis {
+ public:
+  BackgroundAnalysis();
+  ~BackgroundAnalysis();
+  BackgroundAnalysis(const BackgroundAnalysis&) = delete;
+  BackgroundAnalysis& operator=(const BackgroundAnalysis&) = delete;
+
+  // Stops the current analysis and analyses the position of the board
+  void Start(const IntelligentBoard& board);
+  // Returns once the thread of the analysis has ended, the report is cleared
+  void Stop();
+  // Stops the analysis and clears the table, the evaluation cache and the
+  // endgame solver, whose keys do not tell one variant from another
+  void Clear();
+  // true from Start to Stop, even once the search has ended by itself
+  bool IsStarted() const { return thread_.joinable(); }
+  AnalysisReport GetReport() const;
+
+ private:
+  void Run();
+  void SetReport(const SearchInfo& info);
+
+  std::unique_ptr<IntelligentBoard> board_;
+  TranspositionTable table_;
+  EvaluationCache eval_cache_;
+  EndgameSolver endgame_solver_;
+  SearchControl control_;
+  std::thread thread_;
+  mutable std::mutex report_mutex_;
+  AnalysisReport report_;
+};
+
+}  // namespace Core
+#endif  // CONNECTX_BACKGROUND_ANALYSIS_H_
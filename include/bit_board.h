@@ -0,0 +1,460 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Boards of any size and number of dimensions stored as one
+//               bitset per player, with the interface of ModelBoard.
+//============================================================================
+#ifndef CONNECTX_BIT_BOARD_H_
+#define CONNECTX_BIT_BOARD_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "game_record.h"
+#include "model_board.h"
+
+namespace Core {
+
+const std::size_t kBitsPerWord = 64;
+// the largest instantiation of BitBoard, 2048 bits
+const std::size_t kMaxBitBoardWords = 32;
+
+/**
+ * @class BitSet
+ * @brief kNumWords words of bits, the bit 0 being the lowest bit of the
+ * first word. The loops on the words have a fixed count and are unrolled.
+ */
+template <std::size_t kNumWords>
+class BitSet {
+ public:
+  BitSet() { Clear(); }
+
+  void Clear() { std::fill(words_, words_ + kNumWords, 0); }
+  void Set(std::size_t bit) {
+    words_[bit / kBitsPerWord] |= 1ULL << (bit % kBitsPerWord);
+  }
+  void Reset(std::size_t bit) {
+    words_[bit / kBitsPerWord] &= ~(1ULL << (bit % kBitsPerWord));
+  }
+  bool Test(std::size_t bit) const {
+    return (words_[bit / kBitsPerWord] >> (bit % kBitsPerWord)) & 1;
+  }
+  bool IsEmpty() const {
+    uint64_t any = 0;
+    for(std::size_t i = 0; i < kNumWords; i++) {
+      any |= words_[i];
+    }
+    return any == 0;
+  }
+  BitSet& operator&=(const BitSet& other) {
+    for(std::size_t i = 0; i < kNumWords; i++) {
+      words_[i] &= other.words_[i];
+    }
+    return *this;
+  }
+  BitSet& operator|=(const BitSet& other) {
+    for(std::size_t i = 0; i < kNumWords; i++) {
+      words_[i] |= other.words_[i];
+    }
+    return *this;
+  }
+  // The bits move to lower indexes, zeros come in at the top
+  BitSet ShiftDown(std::size_t num_bits) const {
+    BitSet shifted;
+    std::size_t word_shift = num_bits / kBitsPerWord;
+    std::size_t bit_shift = num_bits % kBitsPerWord;
+    for(std::size_t i = 0; i + word_shift < kNumWords; i++) {
+      shifted.words_[i] = words_[i + word_shift] >> bit_shift;
+      if(bit_shift != 0 && i + word_shift + 1 < kNumWords) {
+        shifted.words_[i] |=
+            words_[i + word_shift + 1] << (kBitsPerWord - bit_shift);
+      }
+    }
+    return shifted;
+  }
+  // Calls function with the index of every bit set, from the lowest
+  template <typename Function>
+  void ForEach(Function function) const {
+    for(std::size_t i = 0; i < kNumWords; i++) {
+      for(uint64_t word = words_[i]; word != 0; word &= word - 1) {
+        function(i * kBitsPerWord + __builtin_ctzll(word));
+      }
+    }
+  }
+  std::size_t Count() const {
+    std::size_t count = 0;
+    for(std::size_t i = 0; i < kNumWords; i++) {
+      count += __builtin_popcountll(words_[i]);
+    }
+    return count;
+  }
+
+ private:
+  uint64_t words_[kNumWords];
+};
+
+/**
+ * @class BitBoardLayout
+ * @brief Places the cells of a board in the bits: the first axis (the
+ * gravity) varies the fastest so that the cell above a cell is the bit
+ * below it. Every axis but the last one has one more position, a padding
+ * bit which is never set: a step in any direction from a cell at the edge of
+ * an axis lands in a padding bit or outside of the bits, so the lines are
+ * tested by shifting the bitsets without checking the coordinates.
+ * The layout only depends on the shape of the board, it is shared by the
+ * boards of a same variant.
+ */
+class BitBoardLayout {
+ public:
+  typedef ModelBoard::MoveType MoveType;
+
+  BitBoardLayout(const std::vector<std::size_t>& dimensions,
+                 uint8_t num_win_connected);
+  static std::shared_ptr<const BitBoardLayout> Create(
+      const std::vector<std::size_t>& dimensions, uint8_t num_win_connected);
+
+  // Bits of the layout of a board, padding included
+  static std::size_t GetNumBits(const std::vector<std::size_t>& dimensions);
+  // Fewest words holding the bits, 0 if more than kMaxBitBoardWords
+  static std::size_t GetNumWords(const std::vector<std::size_t>& dimensions);
+
+  std::size_t GetNumBits() const { return coordinates_.size(); }
+  std::size_t GetNumCells() const { return num_cells_; }
+  const std::vector<std::size_t>& GetDimensions() const {
+    return dimensions_;
+  }
+  uint8_t GetNumWinConnected() const { return num_win_connected_; }
+  std::size_t GetBit(const MoveType& move) const {
+    std::size_t bit = 0;
+    for(std::size_t axis = 0; axis < move.size(); axis++) {
+      bit += move[axis] * strides_[axis];
+    }
+    return bit;
+  }
+  // coordinates of the cell of a bit, empty for a padding bit
+  const MoveType& GetMove(std::size_t bit) const { return coordinates_[bit]; }
+  // true for the cells of the top row, nothing is dropped above them
+  bool IsTop(std::size_t bit) const { return coordinates_[bit][0] == 0; }
+  // Distance in bits of a step along each direction, always positive
+  const std::vector<std::size_t>& GetDirectionOffsets() const {
+    return direction_offsets_;
+  }
+  // the bottom cell of every column
+  const std::vector<std::size_t>& GetBottomBits() const {
+    return bottom_bits_;
+  }
+
+ private:
+  std::vector<std::size_t> dimensions_;
+  uint8_t num_win_connected_;
+  std::size_t num_cells_;
+  std::vector<std::size_t> strides_;
+  std::vector<MoveType> coordinates_;
+  std::vector<std::size_t> direction_offsets_;
+  std::vector<std::size_t> bottom_bits_;
+};
+
+/**
+ * @class BitBoard
+ * @brief The rules of ModelBoard on one bitset per player and a bitset of
+ * the lowest empty cell of every column, with the same interface so that the
+ * code written for ModelBoard (a template on the type of board) runs on
+ * either. A move sets a bit and moves the playable cell of its column one
+ * bit down; it wins if the bits at its distance along a direction, on both
+ * sides, are set. SetPosition finds the lines of a player with shifts of its
+ * bitset, one per piece of a line and per direction.
+ * kNumWords is the number of 64 bit words of a bitset, see CallWithBitBoard
+ * to choose it from the shape of the board.
+ */
+template <std::size_t kNumWords>
+class BitBoard {
+ public:
+  typedef ModelBoard::MoveType    MoveType;
+  typedef ModelBoard::PieceIDType PieceIDType;
+  typedef BitSet<kNumWords>       BitSetType;
+
+  BitBoard(const std::vector<PieceIDType>& piece_IDs,
+           const std::vector<std::size_t>& dimensions,
+           uint8_t num_connected = kDefaultConnectedFour)
+      : layout_(BitBoardLayout::Create(dimensions, num_connected)),
+        piece_IDs_(piece_IDs), pieces_(piece_IDs.size()),
+        recorder_(nullptr) {
+    assert(layout_->GetNumBits() <= kNumWords * kBitsPerWord);
+    Reset();
+  }
+
+  // The bits of the board fit in kNumWords words
+  static bool IsSupported(const std::vector<std::size_t>& dimensions) {
+    return BitBoardLayout::GetNumBits(dimensions) <= kNumWords * kBitsPerWord;
+  }
+
+  void SetMove(const MoveType& move) {
+    assert(current_state_ == States::OnGoing);
+    assert(playable_.Test(layout_->GetBit(move)));
+    std::size_t bit = layout_->GetBit(move);
+    pieces_[current_chip_index_].Set(bit);
+    playable_.Reset(bit);
+    if(!layout_->IsTop(bit)) {
+      playable_.Set(bit - 1);
+    }
+    history_bits_.push_back(bit);
+    if(recorder_ != nullptr) {
+      recorder_->WriteMove(move);
+    }
+    if(IsConnected(bit, pieces_[current_chip_index_])) {
+      current_state_ = States::Win;
+    } else if(history_bits_.size() + num_set_pieces_ ==
+              layout_->GetNumCells()) {
+      current_state_ = States::Draw;
+    }
+    current_chip_index_ = (current_chip_index_ + 1) % piece_IDs_.size();
+  }
+  void Undo() {
+    if(history_bits_.empty()) {
+      return;
+    }
+    if(recorder_ != nullptr) {
+      recorder_->WriteUndo();
+    }
+    std::size_t bit = history_bits_.back();
+    history_bits_.pop_back();
+    current_chip_index_ = GetIndexCurrentChip();
+    pieces_[current_chip_index_].Reset(bit);
+    if(!layout_->IsTop(bit)) {
+      playable_.Reset(bit - 1);
+    }
+    playable_.Set(bit);
+    current_state_ = States::OnGoing;
+  }
+  void Reset() {
+    for(BitSetType& pieces : pieces_) {
+      pieces.Clear();
+    }
+    playable_.Clear();
+    for(std::size_t bit : layout_->GetBottomBits()) {
+      playable_.Set(bit);
+    }
+    history_bits_.clear();
+    num_set_pieces_ = 0;
+    current_chip_index_ = 0;
+    current_state_ = States::OnGoing;
+  }
+  /**
+   * @brief Sets up an arbitrary position without any history, as
+   * ModelBoard::SetPosition does
+   * @return false if a piece is not supported by another one or a piece ID
+   * is unknown, the board is then reset.
+   */
+  bool SetPosition(const std::vector<PieceIDType>& cells,
+                   PieceIDType next_chip) {
+    auto next_it = std::find(piece_IDs_.begin(), piece_IDs_.end(), next_chip);
+    if(cells.size() != layout_->GetNumCells() || next_it == piece_IDs_.end()) {
+      return false;
+    }
+    Reset();
+    playable_.Clear();
+    MoveType position(layout_->GetDimensions().size(), 0);
+    auto cell_it = cells.begin();
+    do {
+      PieceIDType piece_ID = *cell_it++;
+      if(piece_ID == kEmptyPosition) {
+        continue;
+      }
+      auto piece_it = std::find(piece_IDs_.begin(), piece_IDs_.end(), piece_ID);
+      if(piece_it == piece_IDs_.end()) {
+        Reset();
+        return false;
+      }
+      pieces_[piece_it - piece_IDs_.begin()].Set(layout_->GetBit(position));
+      num_set_pieces_++;
+    } while(ModelBoard::NextCoordinates(layout_->GetDimensions(), position));
+    // the lowest empty cell of each column, all the cells above must be empty
+    BitSetType occupied = GetOccupied();
+    std::size_t height = layout_->GetDimensions()[0];
+    for(std::size_t bottom : layout_->GetBottomBits()) {
+      // the row r of the column is the bit top + r
+      std::size_t top = bottom + 1 - height;
+      std::size_t num_empty = height;
+      while(num_empty > 0 && occupied.Test(top + num_empty - 1)) {
+        num_empty--;
+      }
+      for(std::size_t row = 0; row + 1 < num_empty; row++) {
+        if(occupied.Test(top + row)) {
+          Reset();
+          return false;
+        }
+      }
+      if(num_empty > 0) {
+        playable_.Set(top + num_empty - 1);
+      }
+    }
+    current_chip_index_ = next_it - piece_IDs_.begin();
+    for(const BitSetType& pieces : pieces_) {
+      if(HasLine(pieces)) {
+        current_state_ = States::Win;
+        return true;
+      }
+    }
+    if(num_set_pieces_ == layout_->GetNumCells()) {
+      current_state_ = States::Draw;
+    }
+    return true;
+  }
+  // The elements of moves are reused, their coordinates are assigned
+  void GetPossibleMoves(std::vector<MoveType>& moves) const {
+    if(current_state_ != States::OnGoing) {
+      moves.clear();
+      return;
+    }
+    moves.resize(playable_.Count());
+    std::size_t i = 0;
+    const BitBoardLayout& layout = *layout_;
+    playable_.ForEach([&moves, &i, &layout](std::size_t bit) {
+      const MoveType& move = layout.GetMove(bit);
+      moves[i++].assign(move.begin(), move.end());
+    });
+  }
+  // true if a piece of chip at move would be part of a winning line, the
+  // cell itself is not read
+  bool IsWinningMove(const MoveType& move, PieceIDType chip) const {
+    auto it = std::find(piece_IDs_.begin(), piece_IDs_.end(), chip);
+    assert(it != piece_IDs_.end());
+    return IsConnected(layout_->GetBit(move), pieces_[it - piece_IDs_.begin()]);
+  }
+
+  PieceIDType GetCurrentChipId() const {
+    return piece_IDs_[GetIndexCurrentChip()];
+  }
+  PieceIDType GetNextChipId() const { return piece_IDs_[current_chip_index_]; }
+  const std::vector<PieceIDType>& GetPieceIDs() const { return piece_IDs_; }
+  States GetCurrentState() const { return current_state_; }
+  MoveType GetLastMove() const {
+    assert(!history_bits_.empty());
+    return layout_->GetMove(history_bits_.back());
+  }
+  PieceIDType GetPiece(const MoveType& position) const {
+    std::size_t bit = layout_->GetBit(position);
+    for(std::size_t i = 0; i < pieces_.size(); i++) {
+      if(pieces_[i].Test(bit)) {
+        return piece_IDs_[i];
+      }
+    }
+    return kEmptyPosition;
+  }
+  uint8_t GetNumWinConnected() const {
+    return layout_->GetNumWinConnected();
+  }
+  const std::vector<std::size_t>& GetDimensions() const {
+    return layout_->GetDimensions();
+  }
+  std::size_t GetHistoryCount() const { return history_bits_.size(); }
+  std::size_t GetNumPieces() const {
+    return num_set_pieces_ + history_bits_.size();
+  }
+  void SetRecorder(GameRecordWriter* recorder) { recorder_ = recorder; }
+
+ private:
+  std::size_t GetIndexCurrentChip() const {
+    return current_chip_index_ == 0 ? piece_IDs_.size() - 1
+                                    : current_chip_index_ - 1;
+  }
+  BitSetType GetOccupied() const {
+    BitSetType occupied;
+    for(const BitSetType& pieces : pieces_) {
+      occupied |= pieces;
+    }
+    return occupied;
+  }
+  // The pieces at the distance of the bit along a direction, on both sides,
+  // the padding bits end the lines
+  bool IsConnected(std::size_t bit, const BitSetType& pieces) const {
+    const std::size_t num_bits = layout_->GetNumBits();
+    const std::size_t num_win_connected = layout_->GetNumWinConnected();
+    for(std::size_t offset : layout_->GetDirectionOffsets()) {
+      std::size_t num_connected = 1;
+      for(std::size_t next = bit + offset;
+          next < num_bits && pieces.Test(next) &&
+          num_connected < num_win_connected;
+          next += offset) {
+        num_connected++;
+      }
+      for(std::size_t steps = 1;
+          steps * offset <= bit && pieces.Test(bit - steps * offset) &&
+          num_connected < num_win_connected;
+          steps++) {
+        num_connected++;
+      }
+      if(num_connected >= num_win_connected) {
+        return true;
+      }
+    }
+    return false;
+  }
+  // A line starts at every bit left after the pieces are shifted by every
+  // step of the line and anded
+  bool HasLine(const BitSetType& pieces) const {
+    for(std::size_t offset : layout_->GetDirectionOffsets()) {
+      BitSetType starts = pieces;
+      for(std::size_t step = 1;
+          step < layout_->GetNumWinConnected() && !starts.IsEmpty(); step++) {
+        starts &= pieces.ShiftDown(step * offset);
+      }
+      if(!starts.IsEmpty()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  std::shared_ptr<const BitBoardLayout> layout_;
+  std::vector<PieceIDType> piece_IDs_;
+  // pieces of the players, in the order of piece_IDs_
+  std::vector<BitSetType> pieces_;
+  BitSetType playable_;
+  std::vector<std::size_t> history_bits_;
+  // pieces set up by SetPosition
+  std::size_t num_set_pieces_;
+  std::size_t current_chip_index_;
+  States current_state_;
+  GameRecordWriter* recorder_;
+};
+
+/**
+ * @brief Calls function(board) with a BitBoard of the fewest words the board
+ * fits in, Function having a template operator() taking a BitBoard<N>&.
+ * @return false if the board needs more than kMaxBitBoardWords words
+ */
+template <typename Function>
+bool CallWithBitBoard(const std::vector<ModelBoard::PieceIDType>& piece_IDs,
+                      const std::vector<std::size_t>& dimensions,
+                      uint8_t num_connected,
+                      Function& function) {
+  std::size_t num_words = BitBoardLayout::GetNumWords(dimensions);
+  if(num_words == 1) {
+    BitBoard<1> board(piece_IDs, dimensions, num_connected);
+    function(board);
+  } else if(num_words == 2) {
+    BitBoard<2> board(piece_IDs, dimensions, num_connected);
+    function(board);
+  } else if(num_words <= 4 && num_words > 0) {
+    BitBoard<4> board(piece_IDs, dimensions, num_connected);
+    function(board);
+  } else if(num_words <= 8 && num_words > 0) {
+    BitBoard<8> board(piece_IDs, dimensions, num_connected);
+    function(board);
+  } else if(num_words <= 16 && num_words > 0) {
+    BitBoard<16> board(piece_IDs, dimensions, num_connected);
+    function(board);
+  } else if(num_words <= kMaxBitBoardWords && num_words > 0) {
+    BitBoard<kMaxBitBoardWords> board(piece_IDs, dimensions, num_connected);
+    function(board);
+  } else {
+    return false;
+  }
+  return true;
+}
+
+}  // namespace Core
+#endif  // CONNECTX_BIT_BOARD_H_
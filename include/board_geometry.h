@@ -0,0 +1,74 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : What the boards of a same shape have in common, computed once
+//               per process.
+//============================================================================
+#ifndef CONNECTX_BOARD_GEOMETRY_H_
+#define CONNECTX_BOARD_GEOMETRY_H_
+
+#include <array>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace Core {
+
+typedef long long SSizeT;
+
+/**
+ * @class BoardGeometry
+ * @brief The directions of the lines, the steps along them in the cells and
+ * the columns of an empty board only depend on the dimensions. Get builds
+ * them on the first call for a shape and keeps them for the lifetime of the
+ * process, the boards share them read-only: a board only copies the moves
+ * of the empty board when it is built or reset.
+ */
+class BoardGeometry {
+ public:
+  typedef std::vector<std::size_t> CoMoveType;
+  typedef std::vector<SSizeT>      DirectionType;
+
+  explicit BoardGeometry(const std::vector<std::size_t>& dimensions);
+
+  // Thread safe, the geometries are never released
+  static std::shared_ptr<const BoardGeometry> Get(
+      const std::vector<std::size_t>& dimensions);
+
+  // strides of the axes in the keys of the cells, the last axis varies the
+  // fastest
+  const std::vector<std::size_t>& GetStrides() const { return strides_; }
+  // one of a direction and its opposite, the first non-zero step being 1
+  const std::list<DirectionType>& GetDirections() const {
+    return directions_;
+  }
+  // offset in the cells of a MultiDimArray of a step along each direction
+  const std::vector<SSizeT>& GetDirectionOffsets() const {
+    return direction_offsets_;
+  }
+  // row of the bottom cell of every column
+  const std::map<CoMoveType, std::size_t>& GetInitialMoves() const {
+    return initial_moves_;
+  }
+
+ private:
+  static const std::size_t kNumPossibleMovements = 3;
+  static const std::array<int, kNumPossibleMovements> kAllMovements;
+
+  bool GenerateDirections(std::size_t num_directions_limit,
+                          DirectionType& current_direction,
+                          std::size_t pos, std::size_t depth);
+  void GeneratePossibleInitialMoves(
+      const std::vector<std::size_t>& dimensions);
+
+  std::vector<std::size_t> strides_;
+  std::list<DirectionType> directions_;
+  std::vector<SSizeT> direction_offsets_;
+  std::map<CoMoveType, std::size_t> initial_moves_;
+};
+
+}  // namespace Core
+#endif  // CONNECTX_BOARD_GEOMETRY_H_
@@ -10,6 +10,7 @@
 #include <vector>
 #include <list>
 #include <sstream>
+#include <fstream>
 #include <memory>
 #include <map>
 #include <functional>
@@ -24,6 +25,10 @@ class MarginBoard;
 
 namespace Core {
 class IntelligentBoard;
+class GameRecordWriter;
+class ProofSearch;
+class EndgameSolver;
+class BackgroundAnalysis;
 }
 /* ConnectX's main class
  * This class represent the game itself
@@ -37,6 +42,10 @@ class ConnectFour {
    * @brief Play is the game loop
    */
   void Play();
+  /**
+   * @brief Every game played is appended to the file as a binary game record
+   */
+  void SetRecordFile(const std::string& path);
 
  protected:
   
@@ -48,7 +57,7 @@ class ConnectFour {
   bool IsOnGoing() const;
   bool IsHumanPlayerTurn() const;
   std::string GetInput();
-  std::string GetUserInput() const;
+  std::string GetUserInput();
   void DropChip();
   void DrawBoard();
   void PrintTopHeader();
@@ -57,6 +66,8 @@ class ConnectFour {
   void PrintCurrentPlayerName();
   void PrintLastAndPossibleMoves();
   void DrawFooter();
+  void UpdateHint();
+  void RefreshHint();
   void PrepareCursor();
   void Display();
   void ProcessInput(const std::string& input);
@@ -66,34 +77,61 @@ class ConnectFour {
   bool HandleRestart(const std::string& command);
   bool HandleUndo(const std::string& command);
   bool HandleMove(const std::string& command);
+  bool HandleScroll(const std::string& command);
+  bool HandleHint(const std::string& command);
   void ChangeAIDepthsOptions();
   void ConfigureOptions();
   void GetLevels();
   void GetAIPlayerLevels();
   void GetVariants();
+  void GetCustomBoard();
+  void FitBoardToWindow();
   void GetPlayerConfig();
   void GetDifficulty();
   void GetFirstPlayer();
   void Reset();
   void DisplayEndofGame() const;
-  void InitializeGameVariant(uint8_t& num_chips_connected);
-  void InitializeModel(uint8_t num_chips_connected);
+  void InitializeGameVariant(uint8_t& num_chips_connected,
+                             std::vector<std::size_t>& dimensions);
+  void InitializeModel(const std::vector<std::size_t>& dimensions,
+                       uint8_t num_chips_connected);
   void InitializeGame();
   void GetPlayerDetails();
   void FillForConnectFive();
   void FillColumn(std::size_t column, std::size_t num_stop_row);
+  void RecordNewGame();
+  // The columns of a board of more than 2 dimensions are numbered along the
+  // axes other than the first one (the gravity), the last axis varying the
+  // fastest
+  std::size_t GetColumn(const std::vector<std::size_t>& move) const;
+  std::vector<std::size_t> GetColumnMove(std::size_t column,
+                                         std::size_t row) const;
   
   int last_move_;
   bool running_;
   bool b_played_;
+  // the human players see the best move of the background analysis
+  bool hint_enabled_;
+  // iterations of the analysis shown in the footer
+  std::size_t num_hint_iterations_;
   std::size_t offset_history_count_;
+  uint8_t num_chips_connected_;
   std::list<std::function<bool(const std::string&)> > commands_;
   GameOptions current_options_;
   std::unique_ptr<UI::ConnectXBoard> board_;
   std::unique_ptr<Core::IntelligentBoard> model_board_;
+  // proves the forced wins of the AI players, see GetAIPlayerMove
+  std::unique_ptr<Core::ProofSearch> proof_search_;
+  // solves the endgames of two players, see IntelligentBoard::Search
+  std::unique_ptr<Core::EndgameSolver> endgame_solver_;
+  // searches the position while a human player thinks, stopped before the
+  // board changes
+  std::unique_ptr<Core::BackgroundAnalysis> analysis_;
   std::unique_ptr<UI::MarginBoard> margin_board_;
   std::vector<std::size_t> latest_positions_;
   std::vector<const char *> level_names_;
+  std::unique_ptr<std::ofstream> record_stream_;
+  std::unique_ptr<Core::GameRecordWriter> recorder_;
 };
 
 #endif // CONNECTFOUR_H
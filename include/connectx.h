@@ -0,0 +1,92 @@
+/*============================================================================
+ * Author      : Franck Nassé - October 19, 2026
+ * Version     : v1.0
+ * Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+ * Description : C interface of the core library (libconnectx_core).
+ *============================================================================
+ */
+#ifndef CONNECTX_H_
+#define CONNECTX_H_
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CONNECTX_VERSION_MAJOR 1
+#define CONNECTX_VERSION_MINOR 0
+
+/* Return codes */
+#define CX_OK     0
+#define CX_ERROR -1
+
+/* States of a game */
+#define CX_ONGOING 0
+#define CX_WIN     1
+#define CX_DRAW    2
+
+/* A board and the AI searching on it, a board must not be used by two
+ * threads at the same time. */
+typedef struct cx_board cx_board;
+
+/* Limits of a search, 0 means no limit. A search without any limit stops
+ * after one second. */
+typedef struct cx_limits {
+  int depth;
+  unsigned long long nodes;
+  long movetime_ms;
+} cx_limits;
+
+/* "major.minor" */
+const char* cx_version(void);
+
+/* The variant is "<dimensions> <chips to connect> [players]", "6x7 4 2" for
+ * Connect Four. Returns NULL if the variant is invalid. */
+cx_board* cx_board_create(const char* variant);
+void cx_board_destroy(cx_board* board);
+
+/* The size of the transposition table kept between searches, 0 to search
+ * without it (the default) */
+int cx_board_set_table_size(cx_board* board, size_t megabytes);
+
+/* Empties the board */
+void cx_board_reset(cx_board* board);
+/* The text of a position (see position_codec.h), the variant must be the
+ * one of the board */
+int cx_board_set_position(cx_board* board, const char* position);
+/* Writes the text of the position like snprintf, returns its length */
+size_t cx_board_get_position(const cx_board* board, char* text, size_t size);
+
+/* A move is the column numbered from 1, "4", or its coordinates when the
+ * board has more than 2 dimensions, "2.3" */
+int cx_board_play(cx_board* board, const char* move);
+int cx_board_undo(cx_board* board);
+int cx_board_get_state(const cx_board* board);
+/* Turn of the player to move, 1 for the player who moved first */
+int cx_board_get_player(const cx_board* board);
+
+/* Searches the best move of the player to move, which is written in move
+ * (16 characters are enough for a board of 4 dimensions). The score is
+ * from the point of view of that player. Returns CX_ERROR if the game is
+ * over. */
+int cx_board_search(cx_board* board,
+                    const cx_limits* limits,
+                    char* move,
+                    size_t size,
+                    int* score);
+/* Ranks up to num_lines best moves in a single search (multi-PV), best
+ * first. The move of line i is written to moves + i * size, its score to
+ * scores[i] (scores can be NULL). Returns the number of moves ranked, or
+ * CX_ERROR if the game is over. */
+int cx_board_search_lines(cx_board* board,
+                          const cx_limits* limits,
+                          size_t num_lines,
+                          char* moves,
+                          size_t size,
+                          int* scores);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* CONNECTX_H_ */
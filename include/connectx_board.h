@@ -42,12 +42,22 @@ class ConnectXBoard : public TextBoard {
   void UnSetConnectedChips(
       const std::list<std::vector<std::size_t> >& positions,
       int8_t ship_id);
-  void ClearBoard();
   
+ protected:
+  std::size_t GetNumExtraLines() const;
+  void PrintExtraLines();
+  // Number printed below a column of the grid, 0 leaves it blank
+  virtual std::size_t GetColumnLabel(std::size_t column) const {
+    return column + 1;
+  }
+  // largest label of the grid
+  std::size_t GetMaxColumnLabel() const;
+
  private:
   void PrintColumnNumber();
+  void PrintViewportRange();
   void ChangeBackgroundCell(const std::vector<std::size_t>& position,
-                            int8_t piece_ID, char replaced_char, char new_char);
+                            int8_t piece_ID, bool highlighted);
 };
 }
 #endif  //CONNECTX_BOARD_H_
\ No newline at end of file
@@ -17,14 +17,18 @@ extern const char kFiveInRowConnectFour[];
 extern const char k3By6ConnectThree[];
 extern const char kTenBy7ConnectFour[];
 extern const char kEightBy8ConnectFour[]; 
+extern const char kScoreFour[];
+extern const char kCustomConnectX[];
 extern const std::vector<const char *> kGameVariantsEnum;
 extern const std::size_t KClassic3By6Height;
 extern const std::size_t KClassic3By6Width;
+extern const std::size_t kScoreFourBoardSize;
 extern const std::size_t k1stDim;
 extern const std::size_t k2ndDim;
 extern const char kSinglePlayer [];
 extern const char kTwoPlayers   [];
 extern const char kTwoAIPlayers [];
+extern const char kThreeAIPlayers [];
 extern const std::vector<const char *> kPlayerModeEnum;
 extern const std::string kIndentScreen;
 extern const char kColonPoint[];
@@ -36,6 +40,7 @@ extern const char kChooseKindMsg[];
 extern const char kChooseModesMsg[];
 extern const char kAIPlayer1NameMsg[];
 extern const char kAIPlayer2NameMsg[];
+extern const char kAIPlayer3NameMsg[];
 extern const char kGetDepthMsg[];
 extern const char kGetDepthMsg_1[];
 extern const char kGetDepthMsg_2[]; 
@@ -78,10 +83,10 @@ extern const char kTok3Bubbles[];
 extern const char kOddBubble[];
 extern const std::vector<std::string> KPly1Symbol;
 extern const std::vector<std::string> KPly2Symbol;
+extern const std::vector<std::string> KPly3Symbol;
 extern const char kLastMoveMsg[];
 extern const char kTurnMsg1[];
 extern const int kLastMoveBoardEmpty;
-extern const std::size_t kAtomicUndoCounter;
 extern const char kEndOfGameMsg_1[];
 extern const char kEndOfGameMsg_2[];
 extern const char kEndOfGameMsg_3[];
@@ -112,6 +117,36 @@ extern const int kDelayAIPlayer;
 extern const char kLevelsNameError[];
 extern const char kOnGoingGameMove[];
 extern const char kIDPlayerMap[];
+extern const char kScrollLeftCmd;
+extern const char kScrollLeftCmdStr[];
+extern const char kScrollRightCmd;
+extern const char kScrollRightCmdStr[];
+extern const char kScrollUpCmd;
+extern const char kScrollUpCmdStr[];
+extern const char kScrollDownCmd;
+extern const char kScrollDownCmdStr[];
+extern const char kInstructionsMsg_8[];
+extern const char kInstructionsMsg_9[];
+extern const char kHintCmd;
+extern const char kHintCmdStr[];
+extern const char kInstructionsMsg_10[];
+extern const char kInstructionsMsg_11[];
+extern const char kHintMsg[];
+extern const char kHintThinkingMsg[];
+extern const char kHintDepthMsg[];
+extern const char kHintWinMsg[];
+extern const char kHintLossMsg[];
+extern const int kHintRefreshDelay;
+extern const char kRowsRangeMsg[];
+extern const char kColumnsRangeMsg[];
+extern const char kRangeSeparator[];
+extern const char kRangeOfMsg[];
+extern const std::size_t kMarginWindowLines;
+extern const std::size_t kMinCustomBoardSize;
+extern const std::size_t kMaxCustomBoardSize;
+extern const char kCustomRowsMsg[];
+extern const char kCustomColumnsMsg[];
+extern const char kCustomConnectedMsg[];
 }
 
 #endif //CONSTANTS_H 
\ No newline at end of file
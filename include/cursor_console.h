@@ -14,9 +14,11 @@
 namespace UI {
 void EnterGameMode();
 void GetCursorPosition(std::pair<int, int>&);
+void GetWindowSize(std::pair<int, int>&);
 void GotoNextWindowLine();
 void SetCursorPosition(int, int);
 void CloseWindow();
+void SetWindowScrolling(bool);
 void WriteToWindow(const std::string & message);
 void WriteToWindow(const std::stringstream & message);
 void WriteToWindow(const char & message);
@@ -26,6 +28,7 @@ void ClearWindowCurrentLine(int);
 void ClearRemainingWindow();
 void ClearWindowScreen();
 void GetCharacter(std::string&, int = Constants::kLimitNamePlayerMax);
+bool ReadCharacters(std::string&, int, int);
 void FlashBeep(int n);
 void Beep(int n);
 }  // namespace UI
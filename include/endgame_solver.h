@@ -0,0 +1,120 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Exact search of the endgames of two players, to the end of
+//               the game.
+//============================================================================
+#ifndef CONNECTX_ENDGAME_SOLVER_H_
+#define CONNECTX_ENDGAME_SOLVER_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "model_board.h"
+
+namespace Core {
+
+const std::size_t kDefaultEndgameTableMegabytes = 4;
+// the searches solve the positions with at most this number of empty cells
+const std::size_t kDefaultEndgameCells = 20;
+
+// Value of a position for the player to move
+enum class EndgameResult {
+  Loss,
+  Draw,
+  Win,
+  Unknown  // the limits were reached first
+};
+
+// Limits of a solve, a value of zero means no limit
+struct EndgameLimits {
+  std::size_t nodes_ = 0;
+  std::chrono::milliseconds time_ = std::chrono::milliseconds(0);
+  // set by another thread to stop the solve, nullptr for none
+  const std::atomic<bool>* stop_ = nullptr;
+};
+
+/**
+ * @class EndgameSolver
+ * @brief Alpha-beta search of the positions of two players to the end of
+ * the game with the values loss, draw and win only, so that most nodes are
+ * cut by the first move which reaches the window. The immediate wins end
+ * the nodes: a win of the player to move, two winning cells of the other
+ * player, and a single one is the only move to try. The other moves are
+ * tried by the move of the table, then by the number of winning cells they
+ * make, then from the centre of the board out; the moves giving the other
+ * player a winning cell come last.
+ * The bounds are kept in a table of buckets of two entries, one kept for
+ * the positions with the most empty cells and one always replaced. The
+ * table remains valid from one solve to the next for the same shape of
+ * board.
+ */
+class EndgameSolver {
+ public:
+  typedef ModelBoard::MoveType    MoveType;
+  typedef ModelBoard::PieceIDType PieceIDType;
+
+  explicit EndgameSolver(
+      std::size_t num_megabytes = kDefaultEndgameTableMegabytes);
+
+  void Clear();
+  /**
+   * @brief Solves the position of the board, which must have two players
+   * @param line: the best move first then the best replies, from the table,
+   * shorter when its entries were replaced
+   */
+  EndgameResult Solve(const ModelBoard& board,
+                      const EndgameLimits& limits,
+                      std::vector<MoveType>& line);
+  // nodes searched by the last solve
+  std::size_t GetNumNodes() const { return num_nodes_; }
+
+ private:
+  struct Entry {
+    uint64_t key_;
+    int8_t value_;
+    uint8_t bound_;
+    // index of the best move in the possible moves of the position
+    uint8_t move_;
+    uint8_t num_empty_cells_;
+  };
+
+  bool Probe(uint64_t key, Entry& entry) const;
+  void Store(const Entry& entry);
+  uint64_t GetKey(const ModelBoard& board) const;
+  /**
+   * @brief Gets the moves of the position and the order they are tried in,
+   * the move of the table first
+   * @return true if the value of the position is known without searching,
+   * order then starts with its best move
+   */
+  bool GetOrderedMoves(ModelBoard& board, int table_move,
+                       std::vector<MoveType>& moves,
+                       std::vector<uint8_t>& order, int& value) const;
+  // Score of the order of a move which is not an immediate win
+  int ScoreMove(ModelBoard& board, const MoveType& move) const;
+  // -1, 0 or 1 for the player to move, best_move is the index of the best
+  // move in the possible moves
+  int Search(ModelBoard& board, int alpha, int beta, uint8_t& best_move);
+  bool IsOutOfBudget();
+  void BuildLine(ModelBoard& board, std::vector<MoveType>& line);
+
+  std::unique_ptr<Entry[]> entries_;
+  // number of buckets minus one
+  std::size_t mask_;
+  // cells empty when the solve started, the only ones which can be threats
+  std::vector<MoveType> empty_cells_;
+  std::size_t num_cells_;
+  std::size_t num_nodes_;
+  std::size_t max_nodes_;
+  std::chrono::steady_clock::time_point deadline_;
+  bool has_deadline_;
+  const std::atomic<bool>* stop_;
+  bool aborted_;
+};
+
+}  // namespace Core
+#endif  // CONNECTX_ENDGAME_SOLVER_H_
@@ -0,0 +1,207 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Text protocol, modelled on UCI, to drive the AI.
+//============================================================================
+#ifndef CONNECTX_ENGINE_H_
+#define CONNECTX_ENGINE_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "endgame_solver.h"
+#include "evaluation_cache.h"
+#include "intelligent_board.h"
+#include "position_codec.h"
+#include "proof_search.h"
+#include "transposition_table.h"
+
+namespace Core {
+
+const char kEngineName[]   = "ConnectX";
+const char kEngineAuthor[] = "Franck Nassé";
+const uint8_t kEngineMaxPlayers = 26;
+const char kDefaultVariant[] = "6x7 4 2";
+const char kMoveCoordinateSeparator = '.';
+// number of words of a position text
+const int kPositionNumWords = 5;
+// the search of the positions of more than 2 players depends on their number
+const char kAutoMultiPlayerSearch[] = "auto";
+// time of a proof without limit
+const long kDefaultProofMilliseconds = 10000;
+// the table file is saved after a search once this time has elapsed
+const long kTableFileSaveSeconds = 60;
+// score of a win whose principal variation does not reach the end of the
+// game, the distance to the win is then unknown
+const int kWinCentipawns = 100000;
+
+/*
+ * One command per line, the answers are written one per line to the output:
+ *   uci                       -> id name/author, options, uciok
+ *   isready                   -> readyok
+ *   setoption name Variant value <dimensions> <chips to connect> [players]
+ *                                e.g. "6x7 4 2", the default
+ *   setoption name Hash value <megabytes of the transposition table>
+ *   setoption name EvalFile value <network file>
+ *                                evaluates with the network (see
+ *                                neural_evaluator.h), <empty> comes back
+ *                                to the patterns
+ *   setoption name MultiPlayer value auto|paranoid|maxn|brs
+ *                                search of the variants of more than 2
+ *                                players (see MultiPlayerSearch), auto
+ *                                chooses it from the number of players
+ *   setoption name MultiPV value <n>
+ *                                number of best moves ranked with their
+ *                                scores and principal variations, 1 by
+ *                                default
+ *   setoption name EndgameCells value <n>
+ *                                the positions of 2 players with at most n
+ *                                empty cells are solved to the end of the
+ *                                game (see endgame_solver.h), 0 never
+ *                                solves them
+ *   setoption name TableDirectory value <directory>
+ *                                the transposition table starts from the
+ *                                table file of the variant in the directory
+ *                                (see GetTableFileName) and is saved to it,
+ *                                <empty> for none
+ *   setoption name TableReadOnly value true|false
+ *                                the table file is loaded but not saved,
+ *                                false by default
+ *   ucinewgame                   clears the transposition table
+ *   position startpos|fen <position text> [moves <move>...]
+ *                                the position text is the one of
+ *                                position_codec.h, a move is its column
+ *                                numbered from 1, the coordinates of a
+ *                                column are separated by '.' ("2.3") when
+ *                                the board has more than 2 dimensions
+ *   go [depth <n>] [nodes <n>] [movetime <ms>] [infinite] [ponder]
+ *                             -> info depth <n> [multipv <rank>] score
+ *                                cp|mate <n> nodes <n> nps <n> time <ms>
+ *                                pv <move>...
+ *                                after every iteration, once per line best
+ *                                first with MultiPV; mate when the pv ends
+ *                                the game, a win cut short by the table is
+ *                                sent as cp +/-kWinCentipawns, then
+ *                                bestmove <move> [ponder <move>]
+ *   prove [nodes <n>] [movetime <ms>]
+ *                             -> proof win|nowin|unknown nodes <n> time <ms>
+ *                                [pv <move>...]
+ *                                tries to prove a forced win of the player
+ *                                to move (see proof_search.h) and waits for
+ *                                the end of the proof, which is limited to
+ *                                kDefaultProofMilliseconds by default
+ *   stop, ponderhit, quit
+ *   d                         -> position text of the current position
+ * The search runs in its own thread, the commands are read meanwhile. A
+ * search started with infinite or ponder only ends with stop (or ponderhit
+ * for ponder, after which the limits apply).
+ */
+class Engine {
+ public:
+  explicit Engine(std::ostream& output);
+  ~Engine();
+
+  // Executes a command, returns false when the engine must quit
+  bool Execute(const std::string& command);
+  // Waits for the end of the search, an endless search is stopped
+  void Finish();
+
+ private:
+  typedef ModelBoard::MoveType MoveType;
+
+  void SendIdentity();
+  void SetOption(std::istringstream& arguments);
+  // Loads the network evaluating the positions, none for the patterns
+  void SetEvalFile(const std::string& path);
+  bool SetVariant(const std::string& variant);
+  void SetUpPosition(std::istringstream& arguments);
+  void Go(std::istringstream& arguments);
+  void Prove(std::istringstream& arguments);
+  void Stop();
+  void PonderHit();
+  void RunSearch(SearchLimits limits);
+  void SendInfo(const SearchInfo& info);
+  void Send(const std::string& line);
+  void CreateBoard();
+  // The table file of the variant searched, evaluated and searched
+  TableFileShape GetTableFileShape() const;
+  std::string GetTableFilePath() const;
+  // Saves the table to the file of the positions it holds, clears it and
+  // loads the file of the current variant
+  void ReloadTable();
+  void SaveTable();
+
+  std::ostream& output_;
+  std::mutex output_mutex_;
+  std::vector<std::size_t> dimensions_;
+  uint8_t num_connected_;
+  uint8_t num_players_;
+  std::unique_ptr<IntelligentBoard> board_;
+  // kept for the next variants, nullptr for the patterns
+  std::shared_ptr<const NeuralNetwork> network_;
+  // kept from one search to the next
+  std::unique_ptr<TranspositionTable> table_;
+  // scores of the evaluation of the board, cleared with it
+  std::unique_ptr<EvaluationCache> eval_cache_;
+  std::unique_ptr<ProofSearch> proof_search_;
+  // cleared with the board
+  std::unique_ptr<EndgameSolver> endgame_solver_;
+  // one table file per variant, empty for none
+  std::string table_directory_;
+  bool table_read_only_;
+  // the positions of the table
+  TableFileShape table_shape_;
+  std::chrono::steady_clock::time_point table_saved_;
+  // key of the content of the network file
+  uint64_t network_key_;
+  // kAutoMultiPlayerSearch or the name of a MultiPlayerSearch
+  std::string multi_player_search_name_;
+  // lines ranked by the searches
+  std::size_t multi_pv_;
+  // empty cells of the endgames solved
+  std::size_t endgame_cells_;
+  SearchControl control_;
+  std::thread search_thread_;
+  // the best move is sent once the infinite search is stopped
+  bool infinite_;
+  std::mutex search_mutex_;
+  std::condition_variable search_condition_;
+};
+
+// The functions below read and write the words of the protocol
+
+// "<dimensions> <chips to connect> [players]", the variant is the start
+// position, its shape is bounded as the one of a position (IsValidShape)
+bool ParseVariant(const std::string& text, Position& variant);
+std::string FormatVariant(const Position& variant);
+// The column of the move, see the position command
+std::string FormatMove(const ModelBoard::MoveType& move);
+bool ParseMove(const std::string& text,
+               const std::vector<std::size_t>& dimensions,
+               ModelBoard::CoMoveType& column);
+// Reads the arguments of go, returns false if there is no limit
+bool ParseSearchLimits(std::istream& arguments,
+                       SearchLimits& limits,
+                       bool& infinite,
+                       bool& ponder);
+// Reads the arguments of prove, returns false if there is no limit
+bool ParseProofLimits(std::istream& arguments, ProofLimits& limits);
+std::string FormatProof(ProofStatus status,
+                        std::size_t nodes,
+                        std::chrono::milliseconds time,
+                        const std::vector<ModelBoard::MoveType>& line);
+// board is the position searched
+std::string FormatInfo(const SearchInfo& info, const IntelligentBoard& board);
+std::string FormatBestMove(bool has_move,
+                           const ModelBoard::MoveType& best_move,
+                           const std::vector<ModelBoard::MoveType>& pv);
+
+}  // namespace Core
+#endif  // CONNECTX_ENGINE_H_
@@ -0,0 +1,148 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Serves the AI to many games over a Unix domain socket.
+//============================================================================
+#ifndef CONNECTX_ENGINE_SERVER_H_
+#define CONNECTX_ENGINE_SERVER_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "engine.h"
+
+namespace Core {
+
+struct ServerOptions {
+  std::size_t num_workers_ = 4;
+  // size of the transposition table of each variant
+  std::size_t table_megabytes_ = kDefaultTableMegabytes;
+  // time budget of a search without limits and largest budget allowed
+  std::chrono::milliseconds default_budget_ = std::chrono::milliseconds(1000);
+  std::chrono::milliseconds max_budget_ = std::chrono::milliseconds(10000);
+  // the tables start from the table files of their variants in the directory
+  // and are saved to them every kTableFileSaveSeconds and on exit, empty for
+  // none
+  std::string table_directory_;
+  // the table files are loaded but not saved
+  bool table_read_only_ = false;
+  // variants kept in memory, the least recently searched one is freed, with
+  // its table and its boards, to make room for another one
+  std::size_t max_variants_ = 4;
+};
+
+/**
+ * @class EngineServer
+ * @brief Every connection is a game speaking the protocol of the engine
+ * (setoption name Variant, ucinewgame, position, go, isready, quit). A go
+ * answers with the info line of the last iteration and the bestmove line;
+ * stop and ponder are not supported, infinite is bounded by the budget.
+ * A connection only keeps its position, the searches run on a fixed pool of
+ * workers which own one board per variant, and the boards of the same
+ * variant share a transposition table, backed by a table file with
+ * ServerOptions::table_directory_. At most ServerOptions::max_variants_
+ * variants are kept, the table of the one freed is saved to its file.
+ * The commands of a connection are executed in order. The connections take
+ * turns: a worker executes one command of the first connection waiting, which
+ * then waits behind the others if it has more commands. The time budget of a
+ * search includes the time spent waiting for a worker.
+ */
+class EngineServer {
+ public:
+  explicit EngineServer(const ServerOptions& options);
+  ~EngineServer();
+
+  // Creates the socket, returns false on error
+  bool Listen(const std::string& socket_path);
+  // Serves the connections until Shutdown is called
+  void Run();
+  // Can be called from a signal handler
+  void Shutdown() { running_ = false; }
+
+ private:
+  struct Command {
+    std::string line_;
+    std::chrono::steady_clock::time_point received_;
+  };
+
+  struct Session {
+    explicit Session(int socket);
+    ~Session();
+
+    int socket_;
+    // incomplete line received
+    std::string input_;
+    std::deque<Command> commands_;
+    // waiting for a worker or executing a command
+    bool scheduled_;
+    // start position of the game and moves played from it
+    Position base_;
+    std::vector<ModelBoard::CoMoveType> moves_;
+  };
+
+  // shared by the boards of a variant, which keep them alive once the
+  // variant is freed
+  struct VariantTables {
+    std::shared_ptr<TranspositionTable> table_;
+    std::shared_ptr<EvaluationCache> eval_cache_;
+  };
+
+  struct LiveVariant {
+    VariantTables tables_;
+    // order of the last search, the smallest is freed first
+    uint64_t last_used_;
+  };
+
+  struct WorkerBoard {
+    std::unique_ptr<IntelligentBoard> board_;
+    VariantTables tables_;
+  };
+
+  // boards of a worker by variant
+  typedef std::map<std::string, WorkerBoard> Boards;
+
+  void Accept();
+  bool Receive(const std::shared_ptr<Session>& session);
+  void Close(const std::shared_ptr<Session>& session);
+  void RunWorker();
+  void Execute(Session& session, const Command& command, Boards& boards);
+  void SetUpPosition(Session& session, std::istringstream& arguments);
+  void Go(Session& session, const Command& command, std::istringstream& arguments,
+          Boards& boards);
+  IntelligentBoard& GetBoard(const Position& variant, Boards& boards);
+  // Creates the tables of a variant on its first search
+  VariantTables GetVariantTables(const std::string& variant);
+  void SaveTables();
+  void Send(Session& session, const std::string& line);
+
+  ServerOptions options_;
+  int listen_socket_;
+  std::string socket_path_;
+  std::atomic<bool> running_;
+  // read by the thread running Run only
+  std::map<int, std::shared_ptr<Session> > sessions_;
+  // guards the commands and the queue
+  std::mutex queue_mutex_;
+  std::condition_variable queue_condition_;
+  std::deque<std::shared_ptr<Session> > queue_;
+  // guards the variants and the number of uses, shared by the workers
+  std::mutex tables_mutex_;
+  std::map<std::string, LiveVariant> variants_;
+  uint64_t num_variant_uses_;
+  // the table files are written by one thread at a time
+  std::mutex save_mutex_;
+  // read by the thread running Run only
+  std::chrono::steady_clock::time_point tables_saved_;
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace Core
+#endif  // CONNECTX_ENGINE_SERVER_H_
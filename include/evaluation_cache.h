@@ -0,0 +1,54 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Static evaluations of the positions shared by concurrent
+//               searches.
+//============================================================================
+#ifndef CONNECTX_EVALUATION_CACHE_H_
+#define CONNECTX_EVALUATION_CACHE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace Core {
+
+const std::size_t kDefaultEvaluationCacheKilobytes = 1024;
+
+/**
+ * @class EvaluationCache
+ * @brief Scores of EvaluateGrid by key of the position and the maximizing
+ * chip. An entry is a single word, the upper half of the key next to the
+ * score, so several threads can probe and store at the same time without
+ * locks and never read a torn entry. The lower bits of the key select the
+ * slot, an entry always replaces the one of its slot.
+ */
+class EvaluationCache {
+ public:
+  explicit EvaluationCache(
+      std::size_t num_kilobytes = kDefaultEvaluationCacheKilobytes);
+
+  void Clear();
+  bool Probe(uint64_t key, int& score) const {
+    uint64_t entry = slots_[key & mask_].load(std::memory_order_relaxed);
+    if((entry >> 32) != (key >> 32)) {
+      return false;
+    }
+    score = static_cast<int32_t>(static_cast<uint32_t>(entry));
+    return true;
+  }
+  void Store(uint64_t key, int score) {
+    slots_[key & mask_].store(
+        (key >> 32 << 32) | static_cast<uint32_t>(score),
+        std::memory_order_relaxed);
+  }
+  std::size_t GetNumSlots() const { return mask_ + 1; }
+
+ private:
+  std::unique_ptr<std::atomic<uint64_t>[]> slots_;
+  std::size_t mask_;
+};
+
+}  // namespace Core
+#endif  // CONNECTX_EVALUATION_CACHE_H_
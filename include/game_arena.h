@@ -0,0 +1,120 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Pool of memory of a game and the allocator of the containers
+//               of the boards allocating in it.
+//============================================================================
+#ifndef CONNECTX_GAME_ARENA_H_
+#define CONNECTX_GAME_ARENA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+
+namespace Core {
+
+/**
+ * @class GameArena
+ * @brief Hands out the memory of the containers of a board from blocks of
+ * its own of 512 bytes, a game needs a few of them. A freed cell goes to the
+ * free list of its size class (16 byte steps up to 256 bytes, then powers of
+ * two up to 4 KB) and is reused by the next allocation of that class; the
+ * larger ones come from the heap. The blocks are released together with the arena, so
+ * the short-lived allocations of thousands of games do not fragment the
+ * heap between the long-lived ones.
+ * An arena is not thread safe, it belongs to a board.
+ */
+class GameArena {
+ public:
+  GameArena();
+  ~GameArena();
+  GameArena(const GameArena&) = delete;
+  GameArena& operator=(const GameArena&) = delete;
+
+  void* Allocate(std::size_t size);
+  // size is the one given to Allocate
+  void Deallocate(void* memory, std::size_t size);
+  // memory taken from the heap: the blocks and the large allocations
+  std::size_t GetNumReservedBytes() const { return num_reserved_bytes_; }
+  // memory handed out and not freed, rounded up to the size classes
+  std::size_t GetNumUsedBytes() const { return num_used_bytes_; }
+
+ private:
+  static const std::size_t kNumSizeClasses = 20;
+  struct FreeCell {
+    FreeCell* next_;
+  };
+  struct Block {
+    Block* previous_;
+    std::size_t size_;
+  };
+
+  // kNumSizeClasses for the sizes served by the heap
+  static std::size_t GetSizeClass(std::size_t size);
+  static std::size_t GetClassSize(std::size_t size_class);
+  void AddBlock(std::size_t min_size);
+
+  FreeCell* free_cells_[kNumSizeClasses];
+  Block* last_block_;
+  char* next_;
+  char* end_;
+  std::size_t num_reserved_bytes_;
+  std::size_t num_used_bytes_;
+};
+
+/**
+ * @class ArenaAllocator
+ * @brief Allocator of the standard containers taking their memory from a
+ * GameArena, or from the heap without one. The allocator keeps its arena
+ * alive, the containers may outlive the board which created the arena. A
+ * container copied without an allocator gets one of the heap: the copies of
+ * a board, searched or played on other threads, never touch the arena of
+ * the game.
+ */
+template <typename T>
+class ArenaAllocator {
+ public:
+  typedef T value_type;
+
+  ArenaAllocator() {}
+  explicit ArenaAllocator(const std::shared_ptr<GameArena>& arena)
+      : arena_(arena) {}
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other) : arena_(other.GetArena()) {}
+
+  T* allocate(std::size_t num_elements) {
+    std::size_t size = num_elements * sizeof(T);
+    return static_cast<T*>(arena_ ? arena_->Allocate(size)
+                                  : ::operator new(size));
+  }
+  void deallocate(T* memory, std::size_t num_elements) {
+    if(arena_) {
+      arena_->Deallocate(memory, num_elements * sizeof(T));
+    } else {
+      ::operator delete(memory);
+    }
+  }
+  ArenaAllocator select_on_container_copy_construction() const {
+    return ArenaAllocator();
+  }
+
+  const std::shared_ptr<GameArena>& GetArena() const { return arena_; }
+
+ private:
+  std::shared_ptr<GameArena> arena_;
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& left, const ArenaAllocator<U>& right) {
+  return left.GetArena() == right.GetArena();
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& left, const ArenaAllocator<U>& right) {
+  return left.GetArena() != right.GetArena();
+}
+
+}  // namespace Core
+#endif  // CONNECTX_GAME_ARENA_H_
@@ -9,6 +9,7 @@
 
 #include <cstddef>
 #include <map>
+#include <vector>
 #include "player.h"
 
   struct GameOptions {
@@ -18,6 +19,9 @@
     uint8_t difficulty_;
     std::map<int8_t, int8_t> simulation_depths_;
     int8_t firstplayer_;
+    // rows and columns of the custom board
+    std::vector<std::size_t> custom_dimensions_;
+    uint8_t custom_num_connected_;
   };
 
 #endif // GAME_OPTIONS_H
@@ -0,0 +1,132 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Binary game records, streaming writer and reader.
+//============================================================================
+#ifndef CONNECTX_GAME_RECORD_H_
+#define CONNECTX_GAME_RECORD_H_
+
+#include <chrono>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "model_board.h"
+
+namespace Core {
+
+/*
+ * Layout of a game record (all the integers are unsigned LEB128 varints
+ * unless specified otherwise). A stream holds any number of games.
+ *
+ *   magic "CXGR" | version (1 byte) | flags (1 byte)
+ *   variant name length | variant name
+ *   number of dimensions | size of each dimension
+ *   number of chips to connect (1 byte)
+ *   number of players | for each player: piece ID (1 byte), name length, name
+ *   moves ... | end of game code
+ *
+ * A move is coded as its column index + kFirstColumnCode, the column index
+ * being the linear index of the move coordinates without the first (gravity)
+ * axis. When kRecordMoveInfo is set, each move is followed by its score
+ * (zigzag varint) and the thinking time in milliseconds.
+ */
+const char kGameRecordMagic[]      = {'C', 'X', 'G', 'R'};
+const uint8_t kGameRecordVersion   = 1;
+const uint8_t kRecordMoveInfo      = 0x01;
+const uint64_t kEndOfGameCode      = 0;
+const uint64_t kUndoCode           = 1;
+const uint64_t kFirstColumnCode    = 2;
+// longest variant or player name read, a longer one marks the record corrupt
+const uint64_t kMaxRecordStringSize = 1 << 12;
+
+struct GameRecordHeader {
+  std::string variant_;
+  std::vector<std::size_t> dimensions_;
+  uint8_t num_win_connected_ = kDefaultConnectedFour;
+  // in the order of the turns
+  std::vector<ModelBoard::PieceIDType> piece_IDs_;
+  std::vector<std::string> player_names_;
+  bool has_move_info_ = false;
+};
+
+struct GameRecordMove {
+  bool undo_ = false;
+  std::size_t column_ = 0;
+  int score_ = 0;
+  uint32_t think_time_ms_ = 0;
+};
+
+std::size_t GetColumnIndex(const std::vector<std::size_t>& dimensions,
+                           const ModelBoard::MoveType& move);
+void GetColumn(const std::vector<std::size_t>& dimensions, std::size_t index,
+               ModelBoard::CoMoveType& column);
+
+void WriteVarint(std::ostream& stream, uint64_t value);
+bool ReadVarint(std::streambuf& buffer, uint64_t& value);
+
+/**
+ * @class GameRecordWriter
+ * @brief Appends games to a stream. Once attached to a ModelBoard
+ * (ModelBoard::SetRecorder) every move and undo is written as it is played.
+ */
+class GameRecordWriter {
+ public:
+  explicit GameRecordWriter(std::ostream& stream);
+  ~GameRecordWriter();
+
+  void BeginGame(const GameRecordHeader& header);
+  void EndGame();
+  bool IsGameOpen() const { return game_open_; }
+  void WriteMove(const ModelBoard::MoveType& move);
+  void WriteUndo();
+  // Score and thinking time attached to the next move written
+  void SetNextMoveInfo(int score, const std::chrono::milliseconds& think_time);
+
+ private:
+  std::ostream& stream_;
+  std::vector<std::size_t> dimensions_;
+  bool has_move_info_;
+  bool game_open_;
+  int next_score_;
+  uint32_t next_think_time_ms_;
+};
+
+/**
+ * @class GameRecordReader
+ * @brief Reads the games of a stream one after the other. The header of a
+ * game is read first, then its moves until the end of the game.
+ */
+class GameRecordReader {
+ public:
+  explicit GameRecordReader(std::istream& stream);
+
+  // false at the end of the stream or if the data is not a game record, the
+  // header is checked as a position is (IsValidShape, players, chips to
+  // connect) and the reader is then failed
+  bool ReadHeader(GameRecordHeader& header);
+  // false at the end of the game
+  bool ReadMove(GameRecordMove& move);
+  // Plays the remaining moves of the current game on the board, the board
+  // must have been created from the header.
+  bool Replay(ModelBoard& board);
+  void SkipGame();
+  // true if the last header or game read is corrupt
+  bool HasFailed() const { return failed_; }
+
+ private:
+  bool ReadString(std::string& value);
+
+  std::streambuf& buffer_;
+  std::vector<std::size_t> dimensions_;
+  std::size_t num_columns_;
+  ModelBoard::CoMoveType column_;
+  bool has_move_info_;
+  bool game_open_;
+  bool failed_;
+};
+
+}  // namespace Core
+#endif  // CONNECTX_GAME_RECORD_H_
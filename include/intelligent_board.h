@@ -8,15 +8,94 @@
 #define CONNECT4_INTELLIGENCE_BOARD_H_
 
 #include "model_board.h"
+#include "neural_evaluator.h"
+#include "endgame_solver.h"
+#include "proof_search.h"
+#include "evaluation_cache.h"
+#include "transposition_table.h"
+#include "window_evaluator.h"
 #include <list>
 #include <map>
+#include <memory>
 #include <vector>
 #include <chrono>
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <string>
 
 namespace Core {
+class ScoreFourBoard;
 
 typedef int8_t DepthType;
 const int8_t kLevelExternalPlayer = -1;
+const DepthType kMaxSearchDepth = std::numeric_limits<DepthType>::max();
+// GetAIPlayerMove gives this fraction of its time to the proof search
+const int kProofTimeDivisor = 8;
+// Search gives this fraction of its time to the endgame solver, the rest is
+// left to the heuristic search if the endgame is not solved in time
+const int kEndgameTimeDivisor = 2;
+
+// How the positions of more than 2 players are searched, with 2 players the
+// three searches are the same alpha-beta
+enum class MultiPlayerSearch {
+  // the other players form a coalition minimizing the score of the player to
+  // move (paranoid), alpha-beta applies
+  Paranoid,
+  // every player maximizes its own share of the scores (max-n), a move is
+  // only cut when the player who chose the position cannot gain from it
+  MaxN,
+  // the best reply among the moves of all the opponents is the only one
+  // played between two moves of the player to move (best-reply search, BRS),
+  // alpha-beta applies
+  BestReply
+};
+
+// The search used for a number of players unless another one is set
+MultiPlayerSearch GetDefaultMultiPlayerSearch(std::size_t num_players);
+// "paranoid", "maxn" or "brs"
+const char* GetMultiPlayerSearchName(MultiPlayerSearch search);
+bool ParseMultiPlayerSearch(const std::string& name,
+                            MultiPlayerSearch& search);
+
+// Limits of a search, a value of zero means no limit
+struct SearchLimits {
+  DepthType depth_ = kMaxSearchDepth;
+  std::size_t nodes_ = 0;
+  // the search is interrupted once movetime_ has elapsed
+  std::chrono::milliseconds movetime_ = std::chrono::milliseconds(0);
+  // no new iteration is started once soft_time_ has elapsed
+  std::chrono::milliseconds soft_time_ = std::chrono::milliseconds(0);
+  // number of best moves ranked with their exact scores (multi-PV), every
+  // iteration searches them one after the other. Max-n ranks a single move,
+  // Score Four is searched without its bitboard to rank more than one.
+  std::size_t multi_pv_ = 1;
+};
+
+// Shared with the thread running a search to control it
+struct SearchControl {
+  std::atomic<bool> stop_{false};
+  // the clock of the search does not run while pondering
+  std::atomic<bool> pondering_{false};
+};
+
+// Result of an iteration of the search
+struct SearchInfo {
+  DepthType depth_;
+  int score_;
+  std::size_t nodes_;
+  std::chrono::milliseconds time_;
+  std::vector<ModelBoard::MoveType> pv_;
+  // rank of the line from 1 in a multi-PV search, 0 for a single line
+  std::size_t multi_pv_;
+};
+
+// A move ranked by the search, with its score and principal variation
+struct RankedMove {
+  ModelBoard::MoveType move_;
+  int score_;
+  std::vector<ModelBoard::MoveType> pv_;
+};
 
 /**
  * @class IntelligentBoard
@@ -50,35 +129,169 @@ class IntelligentBoard : public ModelBoard {
   void SetAIDepth(PieceIDType piece_ID, DepthType depth);
   int8_t GetAIDepth(PieceIDType piece_ID) const;
   void Reset();
+  bool SetPosition(const std::vector<PieceIDType>& cells,
+                   PieceIDType next_chip);
   // returns the next move as predicted by the algorithm
   void GetAIPlayerMove(MoveType& ai_move, 
       const std::chrono::milliseconds& thinking_time);
+  /**
+   * @brief Searches the best move of the player to move within the limits
+   * @param limits: depth, nodes and time limits of the search
+   * @param best_move: best move found
+   * @return false if the game is over
+   */
+  bool Search(const SearchLimits& limits, MoveType& best_move);
+  // Lets another thread stop the search, nullptr to detach it
+  void SetSearchControl(SearchControl* control) { control_ = control; }
+  // The callback is called after every completed iteration of the search
+  void SetInfoCallback(const std::function<void(const SearchInfo&)>& callback) {
+    info_callback_ = callback;
+  }
+  // moves expected to be played from the position of the last search
+  const std::vector<MoveType>& GetPrincipalVariation() const {
+    return principal_variation_;
+  }
+  // best moves of the last search, best first, as many as
+  // SearchLimits::multi_pv_ and the possible moves allow
+  const std::vector<RankedMove>& GetRankedMoves() const {
+    return ranked_moves_;
+  }
+  // The table can be shared by boards of the same shape and players,
+  // nullptr to search without it
+  void SetTranspositionTable(TranspositionTable* table) { table_ = table; }
+  // The cache can be shared by boards of the same shape, players and
+  // evaluation (patterns or network), nullptr to evaluate every leaf
+  void SetEvaluationCache(EvaluationCache* cache) { eval_cache_ = cache; }
+  // Set by default from the number of players
+  void SetMultiPlayerSearch(MultiPlayerSearch search) {
+    multi_player_search_ = search;
+  }
+  MultiPlayerSearch GetMultiPlayerSearch() const {
+    return multi_player_search_;
+  }
+  // The boards of Score Four (4x4x4, 4 connected, 2 players) are searched
+  // on the bitboard of ScoreFourBoard unless disabled
+  void SetScoreFourSearch(bool enabled) { score_four_search_ = enabled; }
+  // GetAIPlayerMove first tries to prove a forced win with it, nullptr to
+  // only search
+  void SetProofSearch(ProofSearch* proof_search) {
+    proof_search_ = proof_search;
+  }
+  // Search solves the positions of two players with at most
+  // SetEndgameCells empty cells with it, nullptr to only search
+  void SetEndgameSolver(EndgameSolver* endgame_solver) {
+    endgame_solver_ = endgame_solver;
+  }
+  // 0 never solves the endgames
+  void SetEndgameCells(std::size_t num_cells) { endgame_cells_ = num_cells; }
+  std::size_t GetEndgameCells() const { return endgame_cells_; }
+  bool IsWinScore(int score) const {
+    return score == kPlayerWon || score == -kPlayerWon;
+  }
+  std::size_t GetNumNodes() const { return num_nodes_; }
   std::size_t GetNumEvaluations() const { return num_evaluations_; }
+  // evaluations of the last search found in the cache, and computed then
+  // stored in it
+  std::size_t GetNumEvalCacheHits() const { return num_eval_cache_hits_; }
+  std::size_t GetNumEvalCacheMisses() const { return num_eval_cache_misses_; }
   std::chrono::milliseconds 
       GetActualThinkingTime() const { return thinking_time_; }
+  // score of the last move returned by GetAIPlayerMove
+  int GetLastScore() const { return last_score_; }
   void Undo();
+  // Uses the neural network if one is set, else the WindowEvaluator when the
+  // board supports it. The score is looked up in the evaluation cache first.
   int EvaluateGrid(PieceIDType maximizing_chip);
+  // The evaluation by patterns of strings, same score as the WindowEvaluator
+  int EvaluatePatterns(PieceIDType maximizing_chip);
+  /**
+   * @brief Evaluates the positions with a network instead of the patterns,
+   * its accumulators are then updated with every move.
+   * @param network: nullptr to come back to the patterns
+   * @return false if the network is not made for this board and players
+   */
+  bool SetNeuralNetwork(const std::shared_ptr<const NeuralNetwork>& network);
+  const std::shared_ptr<const NeuralNetwork>& GetNeuralNetwork() const {
+    return network_;
+  }
   
  protected:
+  // offsets in board_ of the pieces of a chip, allocated in the arena of
+  // the board
+  typedef std::vector<std::size_t, ArenaAllocator<std::size_t> > PositionList;
   struct EvaluationResult {
     int best_candidate_;
     int score_;
   };
+  // Immediate wins among the possible moves
+  struct Threats {
+    // of the player to move, the search stops at the first one (win_)
+    std::size_t num_wins_;
+    MoveType win_;
+    // cells where the next player (block_chip_) would win, counted up to 2
+    std::size_t num_blocks_;
+    // the last of these cells
+    MoveType block_;
+    PieceIDType block_chip_;
+  };
   
-  const char kEmptyPlace    = '0';
-  const char kOccupiedPlace = '1';
+  static const char kEmptyPlace    = '0';
+  static const char kOccupiedPlace = '1';
   const int8_t kVisited     = 1;
   const int8_t kUnVisited   = 0;
   const int kPlayerWon      = std::numeric_limits<int>::max();
   const int kPlayerMaxScore =  1000;
   const int kPlayerMidScore =  kPlayerMaxScore/2;
+  // sum of the shares of the players in max-n, a win is worth all of it
+  const int kMaxNScoreSum   = 1 << 20;
   
   EvaluationResult FindMove(IntelligentBoard & grid_candidate, 
       DepthType depth, int alpha, int beta, PieceIDType maximizing_chip);
   EvaluationResult IterativeDeepening(IntelligentBoard & grid_candidate, 
-     DepthType depth, 
-     const std::chrono::milliseconds& thinking_time);
-  int EvalPieceType(const std::list<MoveType>& moves, 
+     const SearchLimits& limits);
+  /**
+   * @brief Max-n search, the shares of the players (in the order of the
+   * turns) are written to maxn_scores_[ply]
+   * @param parent_bound: share of the player who chose the position in its
+   * best position so far, the search stops once it cannot be exceeded
+   * @return index of the best move, -1 for a leaf
+   */
+  int FindMaxNMove(IntelligentBoard& grid_candidate, DepthType depth,
+                   int parent_bound);
+  // Shares of the players at a leaf of max-n
+  void EvaluateMaxN(std::vector<int>& scores);
+  // Score of the player to move from the shares of the players
+  int GetMaxNScore(const std::vector<int>& scores) const;
+  bool IsMaxNSearch() const {
+    return multi_player_search_ == MultiPlayerSearch::MaxN &&
+           piece_IDs_.size() > 2;
+  }
+  bool IsBestReplySearch() const {
+    return multi_player_search_ == MultiPlayerSearch::BestReply &&
+           piece_IDs_.size() > 2;
+  }
+  // true if the player of chip can win at once
+  bool HasWinningMove(PieceIDType chip) const;
+  // false unless the proof search proves a win within proof_time
+  bool SolveAIPlayerMove(MoveType& ai_move,
+                         const std::chrono::milliseconds& proof_time);
+  // false unless the endgame solver solves the position within the limits
+  bool SolveEndgame(const SearchLimits& limits, MoveType& best_move);
+  // true if the current iteration must be abandoned
+  bool IsSearchInterrupted();
+  /**
+   * @brief Finds the immediate wins of the player to move and of the next
+   * player. The player to move wins at once if it has one, loses if the next
+   * player has two of them and must block a single one.
+   */
+  void FindThreats(Threats& threats) const;
+  // Score of a win of the player of chip
+  int GetWinScore(PieceIDType chip, PieceIDType maximizing_chip) const {
+    return chip == maximizing_chip ? kPlayerWon : -kPlayerWon;
+  }
+  // the principal variation at ply starts with move
+  void UpdatePrincipalVariation(std::size_t ply, const MoveType& move);
+  int EvalPieceType(const PositionList& offsets,
       PieceIDType chip_evaluated);
   int ScorePatterns(MultiDimArray<PieceIDType>& visiting_grid,
       const MoveType& current_position, 
@@ -89,17 +302,72 @@ class IntelligentBoard : public ModelBoard {
       const DirectionType& direction,
       PieceIDType chip_evaluated,
       std::string& current_string);
-  void InitPatterns();
+  // The patterns of a number of pieces to connect, built once per process
+  static std::shared_ptr<const std::list<std::string> > GetPatterns(
+      uint8_t num_win_connected);
+  // The evaluator of the shape and the pieces of the board, built once per
+  // process, nullptr if the board does not support it
+  std::shared_ptr<const WindowEvaluator> GetWindowEvaluator() const;
   int GetMaxCandidate(const std::vector<MoveType>&);
   bool CheckPattern(const std::string& curr_pattern);
   void SetMoveInc(const MoveType& move);
+  // EvaluateGrid without the cache
+  int EvaluateCells(PieceIDType maximizing_chip);
+  // Recomputes the accumulators of the network from the pieces
+  void RefreshAccumulator();
+  // index of the chip in the order of the turns
+  std::size_t GetTurn(PieceIDType chip) const;
   
   std::map<PieceIDType,int8_t> intelligent_pieces_;
-  std::map<PieceIDType, std::list<MoveType> > piece_positions_;
-  std::list<std::string> patterns_;
+  // the lists of all the chips are created with the board, in its arena,
+  // with room for all the pieces of the chip
+  std::map<PieceIDType, PositionList, std::less<PieceIDType>,
+           ArenaAllocator<std::pair<const PieceIDType, PositionList> > >
+      piece_positions_;
+  std::shared_ptr<const std::list<std::string> > patterns_;
   std::size_t num_evaluations_;
   std::chrono::milliseconds thinking_time_;
   int prev_best_move_;
+  int last_score_;
+  // search in progress
+  SearchControl* control_;
+  std::function<void(const SearchInfo&)> info_callback_;
+  std::size_t num_nodes_;
+  std::size_t max_nodes_;
+  std::chrono::milliseconds movetime_;
+  std::chrono::steady_clock::time_point clock_start_;
+  DepthType iteration_depth_;
+  bool interrupted_;
+  TranspositionTable* table_;
+  EvaluationCache* eval_cache_;
+  std::size_t num_eval_cache_hits_;
+  std::size_t num_eval_cache_misses_;
+  ProofSearch* proof_search_;
+  EndgameSolver* endgame_solver_;
+  std::size_t endgame_cells_;
+  MultiPlayerSearch multi_player_search_;
+  // shares of the players at every ply of max-n
+  std::vector<std::vector<int> > maxn_scores_;
+  // nullptr if the board does not support it, shared by the boards of the
+  // same shape and pieces
+  std::shared_ptr<const WindowEvaluator> window_evaluator_;
+  WindowEvaluator::Scratch window_scratch_;
+  // created by the first search of a Score Four board, shared by the copies
+  // which must not search at the same time
+  std::shared_ptr<ScoreFourBoard> score_four_board_;
+  bool score_four_search_;
+  // nullptr to evaluate with the patterns, shared by the copies
+  std::shared_ptr<const NeuralNetwork> network_;
+  NeuralAccumulator accumulator_;
+  // the scores depend on the maximizing player which is part of the keys
+  uint64_t maximizing_key_;
+  // principal variation found at every ply of the current iteration
+  std::vector<std::vector<MoveType> > pv_table_;
+  std::vector<MoveType> principal_variation_;
+  std::vector<RankedMove> ranked_moves_;
+  // moves of the root skipped by the search, the ones of the lines already
+  // ranked in the iteration of a multi-PV search
+  std::vector<MoveType> excluded_root_moves_;
 };
 
 
@@ -0,0 +1,53 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : LayeredBoard draws a 3D board as its vertical planes side by
+//               side.
+//============================================================================
+#ifndef CONNECTX_LAYERED_BOARD_H_
+#define CONNECTX_LAYERED_BOARD_H_
+
+#include "connectx_board.h"
+
+namespace UI {
+/* A 3D board (z, y, x), z being the axis of the gravity, is drawn as its
+ * planes of constant y from left to right, separated by an empty column. The
+ * 4x4x4 board below has a chip X at (3, 1, 2), the columns are numbered
+ * y * 4 + x + 1 as the moves are entered:
+ *
+ *   |___|___|___|___|   |___|___|___|___|   |___|___|___|___|   |___|___|...
+ *   |___|___|___|___|   |___|___|___|___|   |___|___|___|___|   |___|___|...
+ *   |___|___|___|___|   |___|___|___|___|   |___|___|___|___|   |___|___|...
+ *   |___|___|___|___|   |___|___|_X_|___|   |___|___|___|___|   |___|___|...
+ *   | 1 | 2 | 3 | 4 |   | 5 | 6 | 7 | 8 |   | 9 |10 |11 |12 |   |13 |14 |...
+ */
+class LayeredBoard : public ConnectXBoard {
+ public:
+  LayeredBoard(const std::map<int8_t, TextPiece>& chips,
+               const std::vector<std::size_t>& dimensions,
+               const std::string& line_indent);
+  ~LayeredBoard() {}
+
+ protected:
+  static const std::size_t kNumLayerDimensions = 3;
+
+  std::vector<std::size_t> GetGridPosition(
+      const std::vector<std::size_t>& position) const;
+  std::size_t GetColumnLabel(std::size_t column) const;
+  void PrintLine(std::size_t cline);
+
+ private:
+  static std::vector<std::size_t> GetGridDimensions(
+      const std::vector<std::size_t>& dimensions);
+  // true for the empty columns between the planes
+  bool IsSeparator(std::size_t column) const {
+    return column % (layer_dimensions_[kNumLayerDimensions - 1] + 1) ==
+           layer_dimensions_[kNumLayerDimensions - 1];
+  }
+
+  // dimensions of the 3D board, GetDimensions gives the ones of the grid
+  std::vector<std::size_t> layer_dimensions_;
+};
+}
+#endif  // CONNECTX_LAYERED_BOARD_H_
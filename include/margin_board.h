@@ -26,6 +26,9 @@ class MarginBoard
   std::vector<const char *> level_names_;
   std::map<int8_t, UI::TextPiece> chips_;
   std::vector<std::size_t> dimensions_;
+  // the hint line is drawn below the possible moves, on the line hint_line_
+  std::string hint_;
+  int hint_line_;
 public:
   MarginBoard(const GameOptions&,
               std::size_t,
@@ -42,6 +45,14 @@ public:
                    const std::vector<std::size_t>&,
                    int);
   void DrawFooter();
+  // the analysis has not completed an iteration yet
+  void PrintHint();
+  // best move of the analysis and its score from the side of the player to
+  // move, drawn on a bar
+  void PrintHint(std::size_t column, int depth, int score, bool win_score);
+  void ClearHint();
+  // Redraws the hint line and puts the cursor back where it was
+  void DrawHint();
 };
 
 }
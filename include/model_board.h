@@ -8,21 +8,25 @@
 #define CONNECT4_MODEL_BOARD_H_
 
 #include <list>
-#include <stack>
+#include <vector>
 #include <cstdint>
 #include <cassert>
 #include <map>
 #include <iterator>
 #include <array>
+#include <memory>
+#include "board_geometry.h"
+#include "game_arena.h"
 #include "multi_dim_array.h"
 
 namespace Core {
+class GameRecordWriter;
+
 enum class States {
   Draw,
   OnGoing,
   Win
 };
-typedef long long                  SSizeT;
 const int8_t kEmptyPosition           = 0;
 const uint8_t kDefaultConnectedFour   = 4;
 const uint8_t kDefaultMinNumConnected = 2;
@@ -54,9 +58,13 @@ const uint8_t kMinNumDimensions       = 1;
 class ModelBoard {
  public:
   typedef std::vector<std::size_t> MoveType;
-  typedef std::vector<std::size_t> CoMoveType;
-  typedef std::vector<SSizeT>      DirectionType;
+  typedef BoardGeometry::CoMoveType    CoMoveType;
+  typedef BoardGeometry::DirectionType DirectionType;
   typedef int8_t                   PieceIDType;
+  // lowest empty row of the columns which are not full
+  typedef std::map<CoMoveType, std::size_t, std::less<CoMoveType>,
+                   ArenaAllocator<std::pair<const CoMoveType, std::size_t> > >
+      PossibleMovesType;
 
   /**
    * @brief Constructor of the class. It gets all that is needed to simulate a game.
@@ -70,6 +78,19 @@ class ModelBoard {
   
   // Simulate a move on the board
   virtual void SetMove(const MoveType& move);
+  /**
+   * @brief Sets up an arbitrary position without any history.
+   * @param cells: piece ID of every cell (kEmptyPosition if empty), the last
+   * axis varies the fastest (see NextCoordinates)
+   * @param next_chip: piece ID of the player to move
+   * @return false if a piece is not supported by another one or a piece ID
+   * is unknown, the board is then reset.
+   */
+  virtual bool SetPosition(const std::vector<PieceIDType>& cells,
+                           PieceIDType next_chip);
+  // Drops a piece in a column (coordinates without the first axis),
+  // returns false if the column is full or does not exist.
+          bool SetMoveInColumn(const CoMoveType& column);
   // returns all the current possible moves
           void GetPossibleMoves(std::vector<MoveType>& moves);
   virtual void Undo();
@@ -77,14 +98,26 @@ class ModelBoard {
   virtual void Reset();
   PieceIDType  GetCurrentChipId() const;
   PieceIDType  GetNextChipId() const { return piece_IDs_[current_chip_index_]; }
+  // piece IDs in the order of the turns
+  const std::vector<PieceIDType>& GetPieceIDs() const { return piece_IDs_; }
   States       GetCurrentState() const { return current_state_; }
   
   // Returns the last move
   MoveType     GetLastMove() {
     assert(!history_moves_.empty());
-    return history_moves_.top();
+    return board_.GetPosition(history_moves_.back());
   }
   
+  // Returns the piece ID at a position, kEmptyPosition if the cell is empty
+  PieceIDType  GetPiece(const MoveType& position) const {
+    return board_[position];
+  }
+
+  uint8_t      GetNumWinConnected() const { return num_win_connected_; }
+  // true if a piece of chip at move would be part of a winning line, the
+  // cell itself is not read
+  bool IsWinningMove(const MoveType& move, PieceIDType chip) const;
+
   // Returns the board's dimension
   const std::vector<std::size_t>& GetDimensions() const {
     return board_.GetDimensions();
@@ -95,40 +128,62 @@ class ModelBoard {
    * @param positions
    */
   void GetWinningPositions(std::list<MoveType>& positions) const {
-    positions = winning_moves_;
+    positions.clear();
+    for(std::size_t offset : winning_moves_) {
+      positions.push_back(board_.GetPosition(offset));
+    }
   }
   
   // returns the number of moves so far in the current game
   std::size_t GetHistoryCount() { return history_moves_.size(); }
+  // the pool of memory of the containers of the game
+  const GameArena& GetArena() const { return *arena_; }
+  // returns the number of pieces on the board, including the ones of the
+  // position set up by SetPosition
+  std::size_t GetNumPieces() const { return num_pieces_; }
+  // Zobrist key of the cells (the keys of PositionHasher) and of the player
+  // to move, updated with every move
+  uint64_t GetHashKey() const;
+
+  // Moves to the next coordinates of the board, the last axis varies the
+  // fastest. Returns false after the last cell.
+  static bool NextCoordinates(const std::vector<std::size_t>& dimensions,
+                              MoveType& position);
+
+  // The moves and undos are written to the recorder while it is attached,
+  // nullptr detaches it.
+  void SetRecorder(GameRecordWriter* recorder) { recorder_ = recorder; }
   
  protected:
-  static const std::size_t kNumPossibleMovements = 3;
-  static const std::array<int, kNumPossibleMovements> kAllMovements;
-  
   bool IsItSafeToMove(const MoveType& move) const;
   bool IsItSafeToMove(const MoveType& move, 
                       const DirectionType& direction) const;
   virtual void SetMoveInc(const MoveType& move);
-  std::list<DirectionType> GetDirections() {
-    return directions_;
+  // Gives the turn to the player of chip, for the searches which let the
+  // players move out of turn. Undo gives the turn back to the player of the
+  // last move, the turn is restored after it.
+  void SetNextChipId(PieceIDType chip);
+  // true if the piece at move is part of a winning line
+  bool CheckConnected(const MoveType& move);
+  const std::list<DirectionType>& GetDirections() const {
+    return geometry_->GetDirections();
   }
   
+  // the containers of the board allocate in it, those of the copies of the
+  // board allocate on the heap
+  std::shared_ptr<GameArena> arena_;
   MultiDimArray<PieceIDType> board_;
   const uint8_t num_win_connected_;
-  std::map<CoMoveType,std::size_t> possible_moves_;
+  PossibleMovesType possible_moves_;
   std::vector<PieceIDType> piece_IDs_;
 
  private:
   bool ExploreMove(const DirectionType& direction, MoveType move, 
                    int8_t& counter, PieceIDType lookup_chip);
-  bool CheckConnected(const MoveType& move);
-  bool GenerateDirections(std::size_t num_directions_limit, 
-                          DirectionType& current_direction, 
-                          std::size_t pos, std::size_t depth);
-  void GeneratePossibleInitialMoves();
   void UpdatePossibleMoves(const MoveType& move, bool undo = false);
-  void ClearMoveHistory();
   
+  // key of a piece of the player at chip_index in a cell
+  uint64_t GetCellKey(const MoveType& move, std::size_t chip_index) const;
   std::size_t GetIndexCurrentChip() const {
     return current_chip_index_ == 0 ? 
         piece_IDs_.size() - 1 :  current_chip_index_ - 1;
@@ -136,9 +191,15 @@ class ModelBoard {
   
   States current_state_;
   std::size_t current_chip_index_;
-  std::stack<MoveType> history_moves_;
-  std::list<MoveType>  winning_moves_;
-  std::list<DirectionType> directions_;
+  std::size_t num_pieces_;
+  uint64_t cells_key_;
+  // offsets in board_ of the moves played and of the pieces of the winning
+  // line
+  std::vector<std::size_t, ArenaAllocator<std::size_t> > history_moves_;
+  std::vector<std::size_t, ArenaAllocator<std::size_t> > winning_moves_;
+  // directions, strides and columns shared by the boards of the same shape
+  std::shared_ptr<const BoardGeometry> geometry_;
+  GameRecordWriter* recorder_;
 };
 
 ModelBoard::MoveType operator+(const ModelBoard::MoveType& move_left, 
@@ -1,6 +1,7 @@
 #ifndef MULTIDIMARRAY_H
 #define MULTIDIMARRAY_H
 
+#include <list>
 #include <vector>
 #include <memory>
 #include <algorithm>
@@ -62,8 +63,10 @@ public:
   const DimCoordinates& GetDimensions() const {
     return dims_; 
   }
-  
- private:
+
+  // The elements, the first axis varies the fastest (see GetOffset)
+  const T* data() const { return array_.data(); }
+
   std::size_t GetOffset(const DimCoordinates& position) const {
     std::size_t offset = 0;
     auto mit = mult_.begin();
@@ -74,7 +77,8 @@ public:
     });
     return offset;
   }
-  
+
+  // The coordinates of the element at an offset (see GetOffset)
   DimCoordinates GetPosition(const std::size_t& offset) const {
     DimCoordinates result(mult_.size());
     auto mit = mult_.rbegin();
@@ -87,7 +91,8 @@ public:
     }
     return result;
   }
-  
+
+ private:
   DimCoordinates dims_;
   DimCoordinates mult_;
   std::vector<T> array_;
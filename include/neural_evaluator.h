@@ -0,0 +1,142 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Small neural network evaluating a board, its first layer is
+//               updated with every move (NNUE).
+//============================================================================
+#ifndef CONNECTX_NEURAL_EVALUATOR_H_
+#define CONNECTX_NEURAL_EVALUATOR_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "model_board.h"
+#include "window_evaluator.h"
+
+namespace Core {
+
+const char kNeuralNetworkMagic[]     = {'C', 'X', 'N', 'N'};
+const uint32_t kNeuralNetworkVersion = 1;
+const std::size_t kNeuralNetworkMaxDimensions = 8;
+// the hidden size is a multiple of it, the SIMD loops have no remainder
+const std::size_t kNeuralHiddenAlignment = 32;
+const std::size_t kNeuralMaxHiddenSize   = 1024;
+// the hidden values are clipped to [0, kNeuralActivationMax]
+const int kNeuralActivationMax = 127;
+// the scores are clipped to [-kNeuralMaxScore, kNeuralMaxScore], far from
+// the score of a win
+const int kNeuralMaxScore = 1000000;
+
+/*
+ * Inputs: a feature per cell and per player, the feature of cell c and
+ *   relative turn t is c * players + t. The cells are numbered with the last
+ *   axis varying the fastest, as in the position text (see position_codec.h),
+ *   the relative turn of a piece is 0 for the player from whose perspective
+ *   the board is seen, 1 for the next player...
+ * Hidden layer: every player p has an accumulator of hidden_size_ values,
+ *   the feature biases plus the feature weights of the pieces seen from p.
+ *   It is updated by every move instead of being recomputed.
+ * Output: seen from p, the accumulators of p, p + 1... (in the order of the
+ *   turns) clipped to [0, 127] are concatenated, the output row is the turn
+ *   of the player to move relative to p:
+ *   score = (output bias[row] + output weights[row] . hidden) / output_scale_
+ *
+ * File layout: a NeuralNetworkHeader, then
+ *   int16_t feature weights, cells * players rows of hidden_size_ values
+ *   int16_t feature biases, hidden_size_ values
+ *   int8_t  output weights, players rows of players * hidden_size_ values
+ *   int32_t output biases, players values
+ * The integers are stored in the byte order of the machine. The sums of the
+ * accumulators must fit in 16 bits.
+ */
+struct NeuralNetworkHeader {
+  char magic_[4];
+  uint32_t version_;
+  uint32_t num_dimensions_;
+  uint32_t num_win_connected_;
+  uint32_t dimensions_[kNeuralNetworkMaxDimensions];
+  uint32_t num_players_;
+  uint32_t hidden_size_;
+  int32_t output_scale_;
+};
+
+/**
+ * @class NeuralNetwork
+ * @brief The weights of a network for a shape of board and a number of
+ * players. They are not modified by the evaluation, a network can be shared
+ * by the boards of a same variant.
+ */
+class NeuralNetwork {
+ public:
+  typedef ModelBoard::MoveType MoveType;
+
+  NeuralNetwork();
+
+  // false if the file cannot be read or is not a valid network
+  bool Load(const std::string& path);
+  bool Save(const std::string& path) const;
+  // Small random weights, the starting point of a training
+  void Initialize(const std::vector<std::size_t>& dimensions,
+                  uint8_t num_win_connected,
+                  uint8_t num_players,
+                  std::size_t hidden_size,
+                  uint32_t seed);
+
+  bool HasShape(const std::vector<std::size_t>& dimensions,
+                uint8_t num_win_connected,
+                std::size_t num_players) const;
+  const std::vector<std::size_t>& GetDimensions() const { return dimensions_; }
+  std::size_t GetNumPlayers() const { return num_players_; }
+  std::size_t GetHiddenSize() const { return hidden_size_; }
+  // Index of a cell in the order of the features
+  std::size_t GetCellIndex(const MoveType& position) const;
+
+  // The best instruction set is used by default
+  void SetInstructionSet(InstructionSet instruction_set);
+  InstructionSet GetInstructionSet() const { return instruction_set_; }
+
+ private:
+  friend class NeuralAccumulator;
+
+  void Resize();
+
+  std::vector<std::size_t> dimensions_;
+  // strides of the axes, the last axis varies the fastest
+  std::vector<std::size_t> strides_;
+  uint8_t num_win_connected_;
+  std::size_t num_players_;
+  std::size_t hidden_size_;
+  int32_t output_scale_;
+  std::vector<int16_t> feature_weights_;
+  std::vector<int16_t> feature_biases_;
+  std::vector<int8_t> output_weights_;
+  std::vector<int32_t> output_biases_;
+  InstructionSet instruction_set_;
+};
+
+/**
+ * @class NeuralAccumulator
+ * @brief The accumulators of all the players for the pieces on a board.
+ * The turns are the indexes of the players in the order of the turns.
+ */
+class NeuralAccumulator {
+ public:
+  // No piece on the board
+  void Reset(const NeuralNetwork& network);
+  void AddPiece(const NeuralNetwork& network, std::size_t cell,
+                std::size_t turn);
+  void RemovePiece(const NeuralNetwork& network, std::size_t cell,
+                   std::size_t turn);
+  // Score seen from the player of perspective_turn
+  int Evaluate(const NeuralNetwork& network,
+               std::size_t perspective_turn,
+               std::size_t next_turn) const;
+
+ private:
+  // one block of hidden_size values per player
+  std::vector<int16_t> values_;
+};
+
+}  // namespace Core
+#endif  // CONNECTX_NEURAL_EVALUATOR_H_
@@ -0,0 +1,107 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Enumeration of the move sequences of a board (perft).
+//============================================================================
+#ifndef CONNECTX_PERFT_H_
+#define CONNECTX_PERFT_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "model_board.h"
+
+namespace Core {
+
+/*
+ * A leaf is a sequence of moves from the position which either has the
+ * given depth or ends the game sooner. The leaves where the game is won or
+ * drawn are also counted apart, whatever their depth.
+ */
+struct PerftCounts {
+  uint64_t leaves_ = 0;
+  uint64_t wins_ = 0;
+  uint64_t draws_ = 0;
+  // moves played to reach all the leaves
+  uint64_t moves_ = 0;
+
+  PerftCounts& operator+=(const PerftCounts& counts);
+};
+
+// moves holds the moves of every depth so they are allocated once
+template <typename Board>
+void CountPerftLeaves(Board& board,
+                      std::size_t depth,
+                      std::vector<std::vector<ModelBoard::MoveType>>& moves,
+                      PerftCounts& counts) {
+  States state = board.GetCurrentState();
+  if(depth == 0 || state != States::OnGoing) {
+    counts.leaves_++;
+    counts.wins_ += state == States::Win;
+    counts.draws_ += state == States::Draw;
+    return;
+  }
+  std::vector<ModelBoard::MoveType>& current_moves = moves[depth - 1];
+  board.GetPossibleMoves(current_moves);
+  for(std::size_t i = 0; i < current_moves.size(); i++) {
+    board.SetMove(current_moves[i]);
+    counts.moves_++;
+    CountPerftLeaves(board, depth - 1, moves, counts);
+    board.Undo();
+  }
+}
+
+// Counts the leaves of the board, which is left as it was. Board is a
+// ModelBoard or a BitBoard.
+template <typename Board>
+PerftCounts Perft(Board& board, std::size_t depth) {
+  std::vector<std::vector<ModelBoard::MoveType>> moves(depth);
+  PerftCounts counts;
+  CountPerftLeaves(board, depth, moves, counts);
+  return counts;
+}
+
+/**
+ * @brief Counts the leaves below each move of the board (divide). The moves
+ * are shared by the threads, each one playing on its own copy of the board.
+ * @param moves: the moves of the board
+ * @param counts: the leaves reached through each move, the move counted
+ */
+template <typename Board>
+void PerftDivide(const Board& board,
+                 std::size_t depth,
+                 std::size_t num_threads,
+                 std::vector<ModelBoard::MoveType>& moves,
+                 std::vector<PerftCounts>& counts) {
+  moves.clear();
+  if(depth > 0 && board.GetCurrentState() == States::OnGoing) {
+    Board(board).GetPossibleMoves(moves);
+  }
+  counts.assign(moves.size(), PerftCounts());
+  std::atomic<std::size_t> next_move(0);
+  auto count_moves = [&]() {
+    Board copy(board);
+    copy.SetRecorder(nullptr);
+    std::size_t i;
+    while((i = next_move++) < moves.size()) {
+      copy.SetMove(moves[i]);
+      counts[i] = Perft(copy, depth - 1);
+      counts[i].moves_++;
+      copy.Undo();
+    }
+  };
+  std::vector<std::thread> threads;
+  for(std::size_t i = 1; i < std::min(num_threads, moves.size()); i++) {
+    threads.push_back(std::thread(count_moves));
+  }
+  count_moves();
+  for(std::thread& thread : threads) {
+    thread.join();
+  }
+}
+
+}  // namespace Core
+#endif  // CONNECTX_PERFT_H_
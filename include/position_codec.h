@@ -0,0 +1,77 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Text and binary encodings of a position.
+//============================================================================
+#ifndef CONNECTX_POSITION_CODEC_H_
+#define CONNECTX_POSITION_CODEC_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "model_board.h"
+
+namespace Core {
+
+/*
+ * A position is independent of the piece IDs: a piece is identified by the
+ * turn of its owner, 1 for the player who moves first, 2 for the next one...
+ * and 0 for an empty cell. The cells are listed with the last axis varying
+ * the fastest, the first axis being the one of the gravity (row 0 on top).
+ *
+ * Text: "<dimensions> <chips to connect> <players> <side to move> <cells>"
+ *   the dimensions are separated by 'x', the side to move is a letter ('a'
+ *   for the first player), the cells are given line by line (a line follows
+ *   the last axis) separated by '/', a piece is a letter and a number counts
+ *   consecutive empty cells. The start of Connect Four is
+ *   "6x7 4 2 a 7/7/7/7/7/7", after the first player drops in the middle
+ *   column "6x7 4 2 b 7/7/7/7/7/3a3".
+ *
+ * Binary: number of dimensions, dimensions (varints), chips to connect,
+ *   players and side to move (one byte each), then the cells packed on the
+ *   smallest number of bits holding the number of players.
+ */
+struct Position {
+  std::vector<std::size_t> dimensions_;
+  uint8_t num_win_connected_ = kDefaultConnectedFour;
+  uint8_t num_players_ = 2;
+  // turn of the player to move, starting at 1
+  uint8_t side_to_move_ = 1;
+  std::vector<uint8_t> cells_;
+};
+
+const char kPositionLineSeparator = '/';
+const char kPositionDimensionSeparator = 'x';
+const char kPositionFirstPlayer = 'a';
+// limits of the shapes read from a text or bytes, the directions of a board
+// grow as 3 to the power of its number of dimensions
+const std::size_t kMaxPositionDimensions = 8;
+const std::size_t kMaxPositionCells = 1 << 14;
+// one letter per player
+const std::size_t kMaxPositionPlayers = 26;
+
+std::size_t GetNumCells(const std::vector<std::size_t>& dimensions);
+/**
+ * @brief Checks the number of dimensions and the number of cells against the
+ * limits of the positions, without overflowing
+ * @return true if the dimensions are within kMaxPositionDimensions and
+ * kMaxPositionCells, none of them being zero
+ */
+bool IsValidShape(const std::vector<std::size_t>& dimensions);
+// Reads the position of a board
+void GetPosition(const ModelBoard& board, Position& position);
+// Sets the position on a board of the same shape and number of players
+bool SetPosition(const Position& position, ModelBoard& board);
+
+std::string SerializePosition(const Position& position);
+std::string SerializePosition(const ModelBoard& board);
+bool ParsePosition(const std::string& text, Position& position);
+
+void EncodePosition(const Position& position, std::string& bytes);
+// Decodes the position starting at offset, which is moved past it
+bool DecodePosition(const std::string& bytes, std::size_t& offset,
+                    Position& position);
+
+}  // namespace Core
+#endif  // CONNECTX_POSITION_CODEC_H_
@@ -0,0 +1,112 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Memory-mapped database of the statistics of positions.
+//============================================================================
+#ifndef CONNECTX_POSITION_DB_H_
+#define CONNECTX_POSITION_DB_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "model_board.h"
+
+namespace Core {
+
+const char kPositionDbMagic[]     = {'C', 'X', 'P', 'D'};
+const uint32_t kPositionDbVersion = 2;
+const std::size_t kPositionDbMaxDimensions = 8;
+
+/*
+ * File layout: a PositionDbHeader followed by 'capacity_' PositionDbEntry.
+ * The entries form an open-addressed hash table (linear probing) indexed by
+ * the canonical key of the positions (see PositionHasher), the key 0 marks an
+ * empty slot. The integers are stored in the byte order of the machine.
+ */
+struct PositionDbHeader {
+  char magic_[4];
+  uint32_t version_;
+  uint32_t num_dimensions_;
+  uint32_t num_win_connected_;
+  // the results depend on the order of the turns
+  uint32_t num_players_;
+  uint32_t dimensions_[kPositionDbMaxDimensions];
+  uint64_t capacity_;
+  uint64_t size_;
+};
+
+// The results are seen from the player who has to move in the position.
+struct PositionStats {
+  uint32_t count_ = 0;
+  uint32_t wins_ = 0;
+  uint32_t losses_ = 0;
+  uint32_t draws_ = 0;
+};
+
+struct PositionDbEntry {
+  uint64_t key_;
+  PositionStats stats_;
+};
+
+enum class GameResult {
+  Unknown,
+  Win,
+  Loss,
+  Draw
+};
+
+/**
+ * @class PositionDatabase
+ * @brief Maps a position database file in memory. The table is not loaded,
+ * a lookup only touches the pages of the slots it probes.
+ * Opened for writing, the file is created with a fixed capacity and the
+ * positions are added with Add.
+ */
+class PositionDatabase {
+ public:
+  PositionDatabase();
+  ~PositionDatabase();
+  PositionDatabase(const PositionDatabase&) = delete;
+  PositionDatabase& operator=(const PositionDatabase&) = delete;
+
+  bool Open(const std::string& path);
+  bool Create(const std::string& path,
+              const std::vector<std::size_t>& dimensions,
+              uint8_t num_win_connected,
+              std::size_t num_players,
+              std::size_t num_positions);
+  void Close();
+  bool IsOpen() const { return header_ != nullptr; }
+
+  bool Find(uint64_t key, PositionStats& stats) const;
+  // Looks up the current position of the board
+  bool Find(const ModelBoard& board, PositionStats& stats) const;
+  // false when the table is full
+  bool Add(uint64_t key, GameResult result);
+
+  bool HasShape(const std::vector<std::size_t>& dimensions,
+                uint8_t num_win_connected,
+                std::size_t num_players) const;
+  std::vector<std::size_t> GetDimensions() const;
+  uint8_t GetNumWinConnected() const {
+    return header_ ? header_->num_win_connected_ : 0;
+  }
+  std::size_t GetNumPlayers() const {
+    return header_ ? header_->num_players_ : 0;
+  }
+  std::size_t GetSize() const { return header_ ? header_->size_ : 0; }
+  std::size_t GetCapacity() const { return header_ ? header_->capacity_ : 0; }
+
+ private:
+  bool Map(int file, std::size_t length, bool writable);
+  std::size_t GetSlot(uint64_t key) const;
+
+  PositionDbHeader* header_;
+  PositionDbEntry* entries_;
+  std::size_t length_;
+  bool writable_;
+};
+
+}  // namespace Core
+#endif  // CONNECTX_POSITION_DB_H_
@@ -0,0 +1,55 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Zobrist hashing of the positions of a board.
+//============================================================================
+#ifndef CONNECTX_POSITION_HASH_H_
+#define CONNECTX_POSITION_HASH_H_
+
+#include <cstdint>
+#include <vector>
+#include "model_board.h"
+
+namespace Core {
+
+/**
+ * @class PositionHasher
+ * @brief Computes a 64-bit key of the cells of a board.
+ * The key of a cell only depends on its coordinates and on the piece ID, the
+ * keys are therefore identical from one process to another and can be stored
+ * in files. The keys of all the mirror images of the board (each axis but the
+ * first one, the gravity, can be reflected) are updated together so the
+ * canonical key of the position is available at any time.
+ * The pieces are identified by the turn of their owner (1 for the player who
+ * started the game, 2 for the next one...) rather than by their ID, so a
+ * position has the same key whoever started the game.
+ */
+class PositionHasher {
+ public:
+  typedef ModelBoard::MoveType    MoveType;
+  typedef ModelBoard::PieceIDType PieceIDType;
+
+  explicit PositionHasher(const std::vector<std::size_t>& dimensions);
+
+  void Clear();
+  // Adds or removes the piece of the player of the turn (starting at 1)
+  void Toggle(const MoveType& position, std::size_t turn);
+  // Key of the board as it is
+  uint64_t GetKey() const { return keys_[0]; }
+  // Smallest key among the mirror images
+  uint64_t GetCanonicalKey() const;
+  // Computes the keys from the cells of the board
+  void Compute(const ModelBoard& board);
+
+  static uint64_t GetCellKey(std::size_t offset, std::size_t turn);
+
+ private:
+  std::vector<std::size_t> dimensions_;
+  std::vector<std::size_t> strides_;
+  // one key per combination of reflected axes
+  std::vector<uint64_t> keys_;
+};
+
+}  // namespace Core
+#endif  // CONNECTX_POSITION_HASH_H_
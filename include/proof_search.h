@@ -0,0 +1,113 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Depth-first proof-number search (df-pn) proving the forced
+//               wins of the player to move.
+//============================================================================
+#ifndef CONNECTX_PROOF_SEARCH_H_
+#define CONNECTX_PROOF_SEARCH_H_
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "model_board.h"
+
+namespace Core {
+
+const std::size_t kDefaultProofTableMegabytes = 8;
+
+enum class ProofStatus {
+  Proven,     // the player to move forces a win
+  Disproven,  // the other players can prevent it (draw or loss)
+  Unknown     // the limits were reached first
+};
+
+// Limits of a proof, a value of zero means no limit
+struct ProofLimits {
+  std::size_t nodes_ = 0;
+  std::chrono::milliseconds time_ = std::chrono::milliseconds(0);
+};
+
+/**
+ * @class ProofSearch
+ * @brief The player to move (the attacker) plays the OR nodes, the other
+ * players the AND nodes: a position is proven when the attacker wins
+ * whatever the others do. Every node has a proof number (the number of
+ * leaves to prove to prove it) and a disproof number; the search always
+ * expands the most proving node, below thresholds so that it only goes back
+ * up when another branch becomes more promising (Nagai's df-pn).
+ * The immediate wins end the nodes without expanding them: a win of the
+ * player to move, two winning cells of the next player, and a single one is
+ * the only move to try.
+ * The numbers are kept in a table of fixed size whose buckets keep the
+ * nodes which cost the most to search. The table remains valid from one
+ * proof to the next for the same shape of board and players.
+ */
+class ProofSearch {
+ public:
+  typedef ModelBoard::MoveType    MoveType;
+  typedef ModelBoard::PieceIDType PieceIDType;
+
+  explicit ProofSearch(std::size_t num_megabytes = kDefaultProofTableMegabytes);
+
+  void Clear();
+  /**
+   * @brief Tries to prove that the player to move of the board wins
+   * @param line: when proven, the moves of a winning line, the attacker's
+   * moves win against every defence and the defence is the one which took
+   * the longest to refute
+   */
+  ProofStatus Solve(const ModelBoard& board,
+                    const ProofLimits& limits,
+                    std::vector<MoveType>& line);
+  // nodes searched by the last proof
+  std::size_t GetNumNodes() const { return num_nodes_; }
+
+ private:
+  struct Numbers {
+    uint32_t proof_;
+    uint32_t disproof_;
+  };
+  struct Entry {
+    uint64_t key_;
+    Numbers numbers_;
+    // nodes searched below the entry, the cheapest entry is replaced
+    uint32_t work_;
+  };
+
+  bool Probe(uint64_t key, Numbers& numbers, uint32_t& work) const;
+  void Store(uint64_t key, const Numbers& numbers, uint32_t work);
+  uint64_t GetKey(const ModelBoard& board) const;
+  /**
+   * @brief Gets the moves of the position, reduced to the block of a
+   * single winning cell of the next player
+   * @return true if the node is decided without expanding it
+   */
+  bool Evaluate(ModelBoard& board,
+                std::vector<MoveType>& moves,
+                Numbers& numbers) const;
+  // Numbers of the position after the move, from the table or (1, 1)
+  Numbers GetChildNumbers(ModelBoard& board, const MoveType& move,
+                          uint32_t& work);
+  void Search(ModelBoard& board, const Numbers& thresholds, Numbers& numbers);
+  bool IsOutOfBudget();
+  void BuildLine(ModelBoard& board, std::vector<MoveType>& line);
+
+  std::unique_ptr<Entry[]> entries_;
+  // number of buckets minus one
+  std::size_t mask_;
+  PieceIDType attacker_;
+  uint64_t attacker_key_;
+  std::size_t num_nodes_;
+  std::size_t max_nodes_;
+  std::chrono::steady_clock::time_point deadline_;
+  // number of nodes at which the clock is read next
+  std::size_t next_clock_nodes_;
+  bool has_deadline_;
+  bool aborted_;
+};
+
+}  // namespace Core
+#endif  // CONNECTX_PROOF_SEARCH_H_
@@ -0,0 +1,149 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Score Four, the 4x4x4 Connect Four of 2 players, on a 64 bit
+//               bitboard with its own alpha-beta search.
+//============================================================================
+#ifndef CONNECTX_SCORE_FOUR_BOARD_H_
+#define CONNECTX_SCORE_FOUR_BOARD_H_
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "intelligent_board.h"
+
+namespace Core {
+
+const std::size_t kScoreFourSize = 4;
+const std::size_t kScoreFourNumCells = 64;
+const std::size_t kScoreFourNumLines = 76;
+
+/**
+ * @class ScoreFourBoard
+ * @brief The cell (z, y, x) of ModelBoard, z being the axis of the gravity,
+ * is the bit z * 16 + y * 4 + x of the pieces of its player. The 76 winning
+ * lines are masks of 4 bits computed once, every cell keeps the masks of the
+ * 4 to 7 lines crossing it: a move wins when one of them is full, and the
+ * cells which would complete a line are found with a few bit operations per
+ * line.
+ * The search is a negamax alpha-beta of the player to move with iterative
+ * deepening. The nodes end at once on a win in one move, play the block of a
+ * single winning cell of the opponent and never play below it. The moves are
+ * ordered by the table move, the killer moves and the history of the
+ * cutoffs. The table keeps the pieces of both players, so a position is
+ * never mistaken for another. Its buckets hold the deepest entry of the
+ * current search and the latest one.
+ */
+class ScoreFourBoard {
+ public:
+  typedef ModelBoard::MoveType MoveType;
+
+  // 4x4x4, 4 connected and 2 players
+  static bool IsSupported(const std::vector<std::size_t>& dimensions,
+                          uint8_t num_win_connected,
+                          std::size_t num_players);
+  // Coordinates of the cell of a bit
+  static MoveType GetMove(uint64_t cell);
+
+  ScoreFourBoard();
+
+  /**
+   * @brief Copies the pieces of a board of the supported shape
+   * @return false if a cell holds a piece of a player unknown to the board
+   */
+  bool SetPosition(const ModelBoard& board);
+  // Drops a piece of the player to move on one of the cells of
+  // GetPlayableCells
+  void Play(uint64_t cell);
+  void Undo();
+  // lowest empty cell of every column which is not full
+  uint64_t GetPlayableCells() const { return playable_; }
+  // true if a line is full or the board is
+  bool IsGameOver() const;
+  // empty cells completing a line of the player to move
+  uint64_t GetWinningCells() const {
+    return GetWinningCells(pieces_[turn_], pieces_[turn_ ^ 1]);
+  }
+  std::size_t GetNumPieces() const { return num_pieces_; }
+
+  /**
+   * @brief Searches the best move of the player to move, as
+   * IntelligentBoard::Search does: the first iteration always completes, a
+   * win is scored std::numeric_limits<int>::max()
+   * @return false if the game is over
+   */
+  bool Search(const SearchLimits& limits,
+              SearchControl* control,
+              const std::function<void(const SearchInfo&)>& info_callback,
+              MoveType& best_move);
+  std::size_t GetNumNodes() const { return num_nodes_; }
+  std::size_t GetNumEvaluations() const { return num_evaluations_; }
+  int GetLastScore() const { return last_score_; }
+  const std::vector<MoveType>& GetPrincipalVariation() const {
+    return principal_variation_;
+  }
+
+ private:
+  enum class Bound : uint8_t { None, Exact, Lower, Upper };
+  struct Entry {
+    uint64_t own_;
+    uint64_t other_;
+    int32_t score_;
+    int8_t depth_;
+    Bound bound_;
+    // bit index of the best move
+    uint8_t move_;
+    // searches are numbered to replace the entries of the previous ones
+    uint8_t age_;
+  };
+
+  static uint64_t GetWinningCells(uint64_t own, uint64_t other);
+  // true if the pieces fill a line crossing the cell of index
+  static bool IsConnected(std::size_t index, uint64_t pieces);
+  int Evaluate();
+  int Negamax(int depth, int alpha, int beta, std::size_t ply);
+  // candidate cells in the order they are searched
+  std::size_t OrderMoves(uint64_t moves, int table_move, std::size_t ply,
+                         uint8_t* ordered) const;
+  // nullptr if the position is not in the table
+  const Entry* Probe(uint64_t own, uint64_t other) const;
+  void Store(const Entry& entry);
+  bool IsInterrupted();
+  void BuildPrincipalVariation(int depth);
+  // the score seen by IntelligentBoard
+  int GetSearchScore(int score) const;
+
+  // pieces of the player of the first turn and of the second one
+  uint64_t pieces_[2];
+  uint64_t playable_;
+  std::size_t turn_;
+  std::size_t num_pieces_;
+  uint8_t history_moves_[kScoreFourNumCells];
+  // two entries per bucket
+  std::unique_ptr<Entry[]> entries_;
+  std::size_t mask_;
+  uint8_t age_;
+  // two moves which caused a cutoff at every ply
+  uint8_t killers_[kScoreFourNumCells + 1][2];
+  // cutoffs caused by every cell, for each player
+  uint32_t history_[2][kScoreFourNumCells];
+  // search in progress
+  SearchControl* control_;
+  std::size_t num_nodes_;
+  std::size_t num_evaluations_;
+  std::size_t max_nodes_;
+  std::chrono::milliseconds movetime_;
+  std::chrono::steady_clock::time_point clock_start_;
+  int iteration_depth_;
+  bool interrupted_;
+  // bit index of the best move of the root
+  uint8_t root_move_;
+  int last_score_;
+  std::vector<MoveType> principal_variation_;
+};
+
+}  // namespace Core
+#endif  // CONNECTX_SCORE_FOUR_BOARD_H_
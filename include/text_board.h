@@ -40,6 +40,16 @@ class TextBoard : public Board<TextPiece> {
   std::size_t GetNumCharLine() {
     return line_length_ - line_indent_.size();
   }
+  // Only the cells of the viewport are rendered. The viewport is sized to fit
+  // max_lines by max_columns characters, the compact mode (one character per
+  // cell) is selected when the full size symbols do not fit.
+        void FitToWindow(std::size_t max_lines, std::size_t max_columns);
+  // Scrolls the viewport the least possible so the position becomes visible
+        void ScrollTo(const std::vector<std::size_t>& model_position);
+  // Scrolls the viewport by a number of rows and columns
+        void Scroll(long long num_rows, long long num_columns);
+        bool IsVisible(const std::vector<std::size_t>& position) const;
+        bool IsCompact() const { return compact_; }
 
     protected:
   // Below are the characters used to draw a board on the console
@@ -55,12 +65,37 @@ class TextBoard : public Board<TextPiece> {
   static const int kTopMargin     = 2;
 
 
+  // The positions given to the public methods are converted to the cells of
+  // the grid, a board of more than 2 dimensions lays its cells out in 2D
+  virtual std::vector<std::size_t> GetGridPosition(
+      const std::vector<std::size_t>& position) const {
+    return position;
+  }
   virtual void ClearBoardStream();
+  // Number of lines printed below the grid by the derived classes
+  virtual std::size_t GetNumExtraLines() const { return 0; }
+  virtual void PrintExtraLines() {}
   virtual void PrintLine(std::size_t cline);
           void PrintEmptyLine(std::size_t lineCount = 1);
           void WriteToCell(const std::string& str);
   virtual void SetChipInc(const std::vector<std::size_t>& position, 
                           int8_t piece_ID = kPieceEmptyCell);
+          void SetHighlighted(const std::vector<std::size_t>& position,
+                              bool highlighted);
+          bool IsGridVisible(const std::vector<std::size_t>& position) const;
+          void RenderViewport();
+          void WriteCell(const std::vector<std::size_t>& position);
+          void SetCellSizes();
+  std::size_t GetCellIndex(const std::vector<std::size_t>& position) const {
+    return position[kfirstAxis] * dimensions_[kSecondAxis] +
+        position[kSecondAxis];
+  }
+  std::size_t GetStreamOffset(const std::vector<std::size_t>& position) const;
+  // true when some cells are outside of the viewport
+  bool IsScrollable() const {
+    return view_size_[kfirstAxis] < dimensions_[kfirstAxis] ||
+        view_size_[kSecondAxis] < dimensions_[kSecondAxis];
+  }
       
   std::stringstream board_stream_;
   std::string previous_;
@@ -71,6 +106,13 @@ class TextBoard : public Board<TextPiece> {
   std::size_t line_length_;
   std::string line_indent_;
   std::pair<int, int> cursor_;
+  // piece ID of every cell of the board, visible or not
+  std::vector<int8_t> cells_;
+  std::vector<bool> highlighted_;
+  // first visible row and column, number of visible rows and columns
+  std::vector<std::size_t> view_origin_;
+  std::vector<std::size_t> view_size_;
+  bool compact_;
 };
 }
 #endif //TEXT_BOARD_H_
@@ -26,14 +26,33 @@ class TextPiece {
   TextPiece() {};
   
   TextPiece(const SymbolType& symbols, int8_t identifier)
-    : symbols_(symbols), identifier_(identifier) {}
+    : symbols_(symbols), identifier_(identifier),
+      compact_symbol_(GetDefaultCompactSymbol(symbols)) {}
+
+  TextPiece(const SymbolType& symbols, int8_t identifier, char compact_symbol)
+    : symbols_(symbols), identifier_(identifier),
+      compact_symbol_(compact_symbol) {}
   
   const SymbolType& GetSymbol() const { return symbols_; }
   int8_t GetIdentifier() const { return identifier_; }
+  // single character used when the board is drawn with one character per cell
+  char GetCompactSymbol() const { return compact_symbol_; }
   
  private:
+  // The first visible character of the symbol is used by default
+  static char GetDefaultCompactSymbol(const SymbolType& symbols) {
+    for(const std::string& line : symbols) {
+      std::size_t pos = line.find_first_not_of(' ');
+      if(pos != std::string::npos) {
+        return line[pos];
+      }
+    }
+    return ' ';
+  }
+
   SymbolType symbols_;
   int8_t   identifier_;
+  char     compact_symbol_;
 };
 }
 #endif //CONNECTFOUR_TEXT_PIECE_H_
\ No newline at end of file
@@ -0,0 +1,92 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Scoped trace spans written as Chrome trace events.
+//============================================================================
+#ifndef CONNECTX_TRACE_H_
+#define CONNECTX_TRACE_H_
+
+#include <cstdint>
+#include <string>
+
+/*
+ * The spans are only recorded when the program is built with CONNECTX_TRACE
+ * defined (make TRACE=1), the macros expand to nothing otherwise:
+ *
+ *   CONNECTX_TRACE_SCOPE("Display");
+ *   CONNECTX_TRACE_SCOPE_ARG("Iteration", "depth", depth);
+ *
+ * A span lasts until the end of the enclosing block. The names must be
+ * string literals, only their address is kept. CONNECTX_TRACE_WRITE() writes
+ * the spans to the file named by the environment variable CONNECTX_TRACE_FILE
+ * (connectx_trace.json by default).
+ */
+#ifdef CONNECTX_TRACE
+#define CONNECTX_TRACE_CONCAT_(a, b) a##b
+#define CONNECTX_TRACE_CONCAT(a, b) CONNECTX_TRACE_CONCAT_(a, b)
+#define CONNECTX_TRACE_SCOPE(name) \
+  Core::TraceScope CONNECTX_TRACE_CONCAT(trace_scope_, __LINE__)(name)
+#define CONNECTX_TRACE_SCOPE_ARG(name, arg_name, arg)                  \
+  Core::TraceScope CONNECTX_TRACE_CONCAT(trace_scope_, __LINE__)(name, \
+                                                                 arg_name, arg)
+#define CONNECTX_TRACE_WRITE() \
+  Core::Tracer::WriteChromeTrace(Core::Tracer::GetOutputPath())
+#else
+#define CONNECTX_TRACE_SCOPE(name) static_cast<void>(0)
+#define CONNECTX_TRACE_SCOPE_ARG(name, arg_name, arg) static_cast<void>(0)
+#define CONNECTX_TRACE_WRITE() static_cast<void>(0)
+#endif
+
+namespace Core {
+
+const char kTraceFileVariable[] = "CONNECTX_TRACE_FILE";
+const char kDefaultTraceFile[] = "connectx_trace.json";
+
+struct TraceEvent {
+  const char* name_;
+  // nullptr without argument
+  const char* arg_name_;
+  int64_t arg_;
+  // microseconds since the first event of the process
+  int64_t start_;
+  int64_t duration_;
+};
+
+/**
+ * @class Tracer
+ * @brief Every thread records its events in its own fixed size buffer
+ * without any lock, the events of a full buffer are dropped and counted.
+ * The buffers outlive their thread so the events of all the threads are
+ * written at the end.
+ */
+class Tracer {
+ public:
+  static int64_t Now();
+  static void Record(const TraceEvent& event);
+  // Writes the events recorded so far in the Chrome trace event format
+  // (chrome://tracing, Perfetto), returns false if the file cannot be written
+  static bool WriteChromeTrace(const std::string& path);
+  // $CONNECTX_TRACE_FILE or kDefaultTraceFile
+  static std::string GetOutputPath();
+};
+
+class TraceScope {
+ public:
+  explicit TraceScope(const char* name,
+                      const char* arg_name = nullptr,
+                      int64_t arg = 0)
+      : event_{name, arg_name, arg, Tracer::Now(), 0} {}
+  ~TraceScope() {
+    event_.duration_ = Tracer::Now() - event_.start_;
+    Tracer::Record(event_);
+  }
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
+
+ private:
+  TraceEvent event_;
+};
+
+}  // namespace Core
+#endif  // CONNECTX_TRACE_H_
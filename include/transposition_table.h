@@ -0,0 +1,131 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Transposition table shared by concurrent searches.
+//============================================================================
+#ifndef CONNECTX_TRANSPOSITION_TABLE_H_
+#define CONNECTX_TRANSPOSITION_TABLE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Core {
+
+const std::size_t kDefaultTableMegabytes = 16;
+// no best move in an entry
+const uint16_t kNoTableMove = 0xFFFF;
+const char kTableFileMagic[]     = {'C', 'X', 'T', 'T'};
+const uint32_t kTableFileVersion = 1;
+const std::size_t kTableFileMaxDimensions = 8;
+const char kTableFileExtension[] = ".cxtt";
+// the entries searched less deep are not saved in the table files
+const int8_t kMinTableFileDepth = 4;
+
+enum class Bound : uint8_t {
+  None,
+  Lower,   // the score is at least the stored one
+  Upper,   // the score is at most the stored one
+  Exact
+};
+
+struct TableEntry {
+  int score_ = 0;
+  int8_t depth_ = 0;
+  Bound bound_ = Bound::None;
+  // column index of the best move (see GetColumnIndex)
+  uint16_t move_ = kNoTableMove;
+};
+
+// The positions and the scores of a table file: its variant, the search of
+// more than two players and the evaluation
+struct TableFileShape {
+  std::vector<std::size_t> dimensions_;
+  uint8_t num_win_connected_ = 0;
+  uint8_t num_players_ = 0;
+  // the value of the MultiPlayerSearch
+  uint32_t multi_player_search_ = 0;
+  // 0 for the patterns, the key of the network otherwise
+  uint64_t evaluation_key_ = 0;
+};
+
+/*
+ * File layout: a TableFileHeader followed by 'num_slots_' slots of two
+ * 64-bit words, the key xor-ed with the data then the data, as they are in
+ * memory. The integers are stored in the byte order of the machine.
+ */
+struct TableFileHeader {
+  char magic_[4];
+  uint32_t version_;
+  uint32_t num_dimensions_;
+  uint32_t num_win_connected_;
+  uint32_t dimensions_[kTableFileMaxDimensions];
+  uint32_t num_players_;
+  uint32_t multi_player_search_;
+  uint64_t evaluation_key_;
+  uint64_t num_slots_;
+};
+
+// "6x7-4-2.cxtt", the key of the network follows the number of players
+std::string GetTableFileName(const TableFileShape& shape);
+
+/**
+ * @class TranspositionTable
+ * @brief Results of the searched positions by Zobrist key. Several threads
+ * can probe and store at the same time without locks: an entry is stored in
+ * two words, the key is saved xor-ed with the data so an entry torn by a
+ * concurrent store does not match its key anymore. An entry always replaces
+ * the one of its slot.
+ * The table can start from the entries of a table file. A file of the size
+ * of the table is mapped copy-on-write: the processes mapping it share its
+ * pages until they store to them.
+ */
+class TranspositionTable {
+ public:
+  explicit TranspositionTable(std::size_t num_megabytes = kDefaultTableMegabytes);
+  ~TranspositionTable();
+  TranspositionTable(const TranspositionTable&) = delete;
+  TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+  // Empties the table, a mapped file is released
+  void Clear();
+  /**
+   * @brief Replaces the entries of the table with the ones of a table file
+   * @return false if the file is missing, damaged or of another shape, the
+   * table is then left as it is
+   */
+  bool Load(const std::string& path, const TableFileShape& shape);
+  /**
+   * @brief Writes the entries searched at least min_depth deep to the file.
+   * The file is replaced at once, the processes which mapped the previous
+   * one keep it. Can be called while the table is searched.
+   */
+  bool Save(const std::string& path,
+            const TableFileShape& shape,
+            int8_t min_depth = kMinTableFileDepth) const;
+  bool IsMapped() const { return mapping_ != nullptr; }
+  bool Probe(uint64_t key, TableEntry& entry) const;
+  void Store(uint64_t key, const TableEntry& entry);
+  std::size_t GetNumSlots() const { return mask_ + 1; }
+
+ private:
+  struct Slot {
+    std::atomic<uint64_t> check_;
+    std::atomic<uint64_t> data_;
+  };
+
+  void Unmap();
+
+  // the slots of heap_slots_ or of the mapping
+  Slot* slots_;
+  std::unique_ptr<Slot[]> heap_slots_;
+  void* mapping_;
+  std::size_t mapping_length_;
+  std::size_t mask_;
+};
+
+}  // namespace Core
+#endif  // CONNECTX_TRANSPOSITION_TABLE_H_
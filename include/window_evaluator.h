@@ -0,0 +1,101 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Evaluation of a board line by line with bit masks computed
+//               with SIMD instructions.
+//============================================================================
+#ifndef CONNECTX_WINDOW_EVALUATOR_H_
+#define CONNECTX_WINDOW_EVALUATOR_H_
+
+#include <cstdint>
+#include <list>
+#include <vector>
+#include "model_board.h"
+
+namespace Core {
+
+enum class InstructionSet { Scalar, Sse2, Avx2 };
+
+/**
+ * @class WindowEvaluator
+ * @brief Computes the same score as the patterns of IntelligentBoard
+ * (EvaluatePatterns) without building strings.
+ * The cells of every line of the board (a line per direction and per cell
+ * starting it) are copied in a byte buffer, each line in a slot of 8, 16, 32
+ * or 64 bytes, the unused bytes acting as a blocked cell. The buffer is
+ * compared with the empty cell and with every piece ID 16 or 32 bytes at a
+ * time, which gives for each of them one bit per cell. The windows of every
+ * line are then scored with bit operations: a window is a run of pieces of
+ * a player separated by fewer than num_win_connected empty cells, with up to
+ * num_win_connected - 1 empty cells on each side.
+ * The evaluator only depends on the shape of the board, it can be shared by
+ * the boards of a same variant; the buffers belong to a Scratch.
+ */
+class WindowEvaluator {
+ public:
+  typedef ModelBoard::PieceIDType    PieceIDType;
+  typedef ModelBoard::DirectionType  DirectionType;
+
+  struct Scratch {
+    std::vector<int8_t> bytes_;
+    std::vector<uint64_t> masks_;
+  };
+
+  /**
+   * @param win_score: score of a window holding a pattern which wins
+   * @param threat_score: score of an open window of the player to move
+   */
+  WindowEvaluator(const std::vector<std::size_t>& dimensions,
+                  const std::list<DirectionType>& directions,
+                  uint8_t num_win_connected,
+                  const std::vector<PieceIDType>& piece_IDs,
+                  int win_score,
+                  int threat_score);
+
+  // The lines must fit in 64 bits and at least 2 pieces must be connected
+  static bool IsSupported(const std::vector<std::size_t>& dimensions,
+                          uint8_t num_win_connected);
+  // The fastest instruction set of the processor
+  static InstructionSet GetBestInstructionSet();
+  static bool IsAvailable(InstructionSet instruction_set);
+  static const char* GetName(InstructionSet instruction_set);
+
+  // The best instruction set is used by default
+  void SetInstructionSet(InstructionSet instruction_set);
+  InstructionSet GetInstructionSet() const { return instruction_set_; }
+
+  /**
+   * @brief Score of the maximizing player minus the scores of the others
+   * @param cells: cells of the board in the order of MultiDimArray
+   */
+  int Evaluate(const PieceIDType* cells,
+               PieceIDType maximizing_chip,
+               PieceIDType next_chip,
+               Scratch& scratch) const;
+
+ private:
+  // Score of the windows of a line, own and empty hold the bits of the line
+  int ScoreLine(uint64_t own, uint64_t empty, bool is_next) const;
+
+  uint8_t num_win_connected_;
+  std::vector<PieceIDType> piece_IDs_;
+  // the empty cell then the piece IDs, as compared with the buffer
+  std::vector<int8_t> values_;
+  int win_score_;
+  int threat_score_;
+  InstructionSet instruction_set_;
+  // bits of a line slot
+  std::size_t slot_size_;
+  std::size_t num_lines_;
+  // size of the byte buffer, a multiple of 64
+  std::size_t num_bytes_;
+  // byte of the buffer of every cell of every line, and the cell
+  std::vector<uint32_t> byte_indexes_;
+  std::vector<uint32_t> cell_offsets_;
+  // value of the unused bytes, neither empty nor a piece ID
+  int8_t padding_;
+};
+
+}  // namespace Core
+#endif  // CONNECTX_WINDOW_EVALUATOR_H_
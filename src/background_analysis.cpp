@@ -0,0 +1,78 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Search deepening on a position in the background while a
+//               human player thinks.
+//============================================================================
+#include "background_analysis.h"
+#include <cassert>
+
+namespace Core {
+
+BackgroundAnalysis::BackgroundAnalysis() {
+}
+
+BackgroundAnalysis::~BackgroundAnalysis() {
+  Stop();
+}
+
+void BackgroundAnalysis::Start(const IntelligentBoard& board) {
+  Stop();
+  assert(board.GetCurrentState() == States::OnGoing);
+  board_.reset(new IntelligentBoard(board));
+  // the copy must not write to the record nor search with the game
+  board_->SetRecorder(nullptr);
+  board_->SetProofSearch(nullptr);
+  board_->SetTranspositionTable(&table_);
+  board_->SetEvaluationCache(&eval_cache_);
+  board_->SetEndgameSolver(&endgame_solver_);
+  board_->SetSearchControl(&control_);
+  board_->SetInfoCallback(
+      [this](const SearchInfo& info) { SetReport(info); });
+  control_.stop_ = false;
+  thread_ = std::thread(&BackgroundAnalysis::Run, this);
+}
+
+void BackgroundAnalysis::Stop() {
+  control_.stop_ = true;
+  if(thread_.joinable()) {
+    thread_.join();
+  }
+  std::lock_guard<std::mutex> lock(report_mutex_);
+  report_ = AnalysisReport();
+}
+
+void BackgroundAnalysis::Clear() {
+  Stop();
+  table_.Clear();
+  eval_cache_.Clear();
+  endgame_solver_.Clear();
+}
+
+AnalysisReport BackgroundAnalysis::GetReport() const {
+  std::lock_guard<std::mutex> lock(report_mutex_);
+  return report_;
+}
+
+void BackgroundAnalysis::Run() {
+  SearchLimits limits;
+  ModelBoard::MoveType best_move;
+  board_->Search(limits, best_move);
+}
+
+// Called by the search on the thread of the analysis
+void BackgroundAnalysis::SetReport(const SearchInfo& info) {
+  if(info.pv_.empty()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(report_mutex_);
+  report_.move_ = info.pv_.front();
+  report_.score_ = info.score_;
+  report_.win_score_ = board_->IsWinScore(info.score_);
+  report_.depth_ = info.depth_;
+  report_.nodes_ = info.nodes_;
+  report_.num_iterations_++;
+}
+
+}  // namespace Core
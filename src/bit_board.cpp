@@ -0,0 +1,88 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Boards of any size and number of dimensions stored as one
+//               bitset per player, with the interface of ModelBoard.
+//============================================================================
+#include "bit_board.h"
+
+namespace Core {
+
+// Strides of the axes in the bits, the last one has no padding
+static std::vector<std::size_t> GetStrides(
+    const std::vector<std::size_t>& dimensions, std::size_t& num_bits) {
+  std::vector<std::size_t> strides(dimensions.size());
+  std::size_t stride = 1;
+  for(std::size_t axis = 0; axis < dimensions.size(); axis++) {
+    strides[axis] = stride;
+    stride *= dimensions[axis] + (axis + 1 < dimensions.size() ? 1 : 0);
+  }
+  num_bits = stride;
+  return strides;
+}
+
+BitBoardLayout::BitBoardLayout(const std::vector<std::size_t>& dimensions,
+                               uint8_t num_win_connected)
+    : dimensions_(dimensions), num_win_connected_(num_win_connected),
+      num_cells_(1) {
+  assert(dimensions.size() > kMinNumDimensions);
+  std::size_t num_bits = 0;
+  strides_ = GetStrides(dimensions, num_bits);
+  coordinates_.resize(num_bits);
+  MoveType position(dimensions.size(), 0);
+  do {
+    coordinates_[GetBit(position)] = position;
+  } while(ModelBoard::NextCoordinates(dimensions, position));
+  for(std::size_t size : dimensions) {
+    num_cells_ *= size;
+  }
+  // the directions of ModelBoard: every step in {-1, 0, 1} of the axes, one
+  // of a step and its opposite
+  std::vector<int> direction(dimensions.size(), -1);
+  while(true) {
+    long long offset = 0;
+    for(std::size_t axis = 0; axis < dimensions.size(); axis++) {
+      offset += direction[axis] * static_cast<long long>(strides_[axis]);
+    }
+    if(offset > 0) {
+      direction_offsets_.push_back(static_cast<std::size_t>(offset));
+    }
+    std::size_t axis = 0;
+    while(axis < direction.size() && direction[axis] == 1) {
+      direction[axis++] = -1;
+    }
+    if(axis == direction.size()) {
+      break;
+    }
+    direction[axis]++;
+  }
+  // one position per column, on the top row, axis 0 having a stride of 1
+  std::vector<std::size_t> column_dimensions(dimensions);
+  column_dimensions[0] = 1;
+  position.assign(dimensions.size(), 0);
+  do {
+    bottom_bits_.push_back(GetBit(position) + dimensions[0] - 1);
+  } while(ModelBoard::NextCoordinates(column_dimensions, position));
+}
+
+std::shared_ptr<const BitBoardLayout> BitBoardLayout::Create(
+    const std::vector<std::size_t>& dimensions, uint8_t num_win_connected) {
+  return std::make_shared<BitBoardLayout>(dimensions, num_win_connected);
+}
+
+std::size_t BitBoardLayout::GetNumBits(
+    const std::vector<std::size_t>& dimensions) {
+  std::size_t num_bits = 0;
+  GetStrides(dimensions, num_bits);
+  return num_bits;
+}
+
+std::size_t BitBoardLayout::GetNumWords(
+    const std::vector<std::size_t>& dimensions) {
+  std::size_t num_words =
+      (GetNumBits(dimensions) + kBitsPerWord - 1) / kBitsPerWord;
+  return num_words <= kMaxBitBoardWords ? num_words : 0;
+}
+
+}  // namespace Core
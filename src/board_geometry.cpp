@@ -0,0 +1,109 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : What the boards of a same shape have in common, computed once
+//               per process.
+//============================================================================
+#include "board_geometry.h"
+#include <cmath>
+#include <mutex>
+#include <numeric>
+#include <queue>
+
+namespace Core {
+
+const std::array<int, BoardGeometry::kNumPossibleMovements>
+    BoardGeometry::kAllMovements = {1, 0, -1};
+
+BoardGeometry::BoardGeometry(const std::vector<std::size_t>& dimensions)
+    : strides_(dimensions.size()) {
+  std::size_t stride = 1;
+  for(std::size_t i = dimensions.size(); i-- > 0;) {
+    strides_[i] = stride;
+    stride *= dimensions[i];
+  }
+  GeneratePossibleInitialMoves(dimensions);
+  DirectionType direction(dimensions.size(), 0);
+  std::size_t num_directions_limit =
+      (std::pow(kNumPossibleMovements, direction.size()) - 1) / 2;
+  GenerateDirections(num_directions_limit, direction, 0, dimensions.size());
+  // the cells of MultiDimArray: the first axis varies the fastest
+  std::vector<SSizeT> axis_offsets(dimensions.size());
+  SSizeT axis_offset = 1;
+  for(std::size_t axis = 0; axis < dimensions.size(); axis++) {
+    axis_offsets[axis] = axis_offset;
+    axis_offset *= dimensions[axis];
+  }
+  for(const DirectionType& direction : directions_) {
+    direction_offsets_.push_back(std::inner_product(
+        direction.begin(), direction.end(), axis_offsets.begin(), SSizeT(0)));
+  }
+}
+
+std::shared_ptr<const BoardGeometry> BoardGeometry::Get(
+    const std::vector<std::size_t>& dimensions) {
+  static std::mutex geometries_mutex;
+  static std::map<std::vector<std::size_t>,
+                  std::shared_ptr<const BoardGeometry> > geometries;
+  std::lock_guard<std::mutex> lock(geometries_mutex);
+  std::shared_ptr<const BoardGeometry>& geometry = geometries[dimensions];
+  if(!geometry) {
+    geometry = std::make_shared<BoardGeometry>(dimensions);
+  }
+  return geometry;
+}
+
+bool BoardGeometry::GenerateDirections(std::size_t num_directions_limit,
+                                       DirectionType& current_direction,
+                                       std::size_t pos,
+                                       std::size_t depth) {
+  bool stop = false;
+  if(directions_.size() >= num_directions_limit) {
+    stop = true;
+  } else if(depth == 0) {
+    directions_.push_back(current_direction);
+    stop = false;
+  } else {
+    for(auto cur_increment : kAllMovements) {
+      current_direction[pos] = cur_increment;
+      if(GenerateDirections(num_directions_limit, current_direction, pos + 1,
+                            depth - 1)) {
+        stop = true;
+        break;
+      }
+    }
+  }
+  return stop;
+}
+
+struct NodePossibleMove {
+  BoardGeometry::CoMoveType possible_move_;
+  std::size_t current_dim_;
+};
+
+void BoardGeometry::GeneratePossibleInitialMoves(
+    const std::vector<std::size_t>& dimensions) {
+  std::queue<NodePossibleMove> nodes;
+  nodes.emplace(NodePossibleMove({{}, 0}));
+  NodePossibleMove curNode, childNode;
+  initial_moves_.clear();
+
+  while(!nodes.empty()) {
+    curNode = nodes.front();
+    if(curNode.current_dim_ == dimensions.size() - 1) {
+      initial_moves_.insert(std::make_pair(curNode.possible_move_,
+                                           dimensions[0] - 1));
+    } else {
+      for(std::size_t i = 0; i < dimensions[curNode.current_dim_ + 1]; i++) {
+        childNode.possible_move_ = curNode.possible_move_;
+        childNode.possible_move_.push_back(i);
+        childNode.current_dim_ = curNode.current_dim_ + 1;
+        nodes.push(childNode);
+      }
+    }
+    nodes.pop();
+  }
+}
+
+}  // namespace Core
@@ -5,16 +5,23 @@
 // Description : Manages user interaction
 //============================================================================
 #include <string.h>
+#include <algorithm>
 #include <chrono>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
 #include <thread>
+#include "background_analysis.h"
 #include "connect_four.h"
 #include "connectx_board.h"
 #include "cursor_console.h"
+#include "endgame_solver.h"
+#include "game_record.h"
 #include "intelligent_board.h"
+#include "layered_board.h"
 #include "margin_board.h"
+#include "proof_search.h"
+#include "trace.h"
 #include "utilities.h"
 
 using namespace Constants;
@@ -28,7 +35,11 @@ ConnectFour::ConnectFour()
     : last_move_(kLastMoveBoardEmpty)
     , running_(true)
     , b_played_(false)
-    , offset_history_count_(0) {
+    , hint_enabled_(false)
+    , num_hint_iterations_(0)
+    , offset_history_count_(0)
+    , num_chips_connected_(kClassicChipsConnected)
+    , analysis_(new Core::BackgroundAnalysis()) {
   commands_.push_back(
       std::bind(&ConnectFour::HandleQuit, this, std::placeholders::_1));
   commands_.push_back(
@@ -39,6 +50,10 @@ ConnectFour::ConnectFour()
       std::bind(&ConnectFour::HandleContinue, this, std::placeholders::_1));
   commands_.push_back(std::bind(&ConnectFour::HandleDifficultyChange, this,
                                 std::placeholders::_1));
+  commands_.push_back(
+      std::bind(&ConnectFour::HandleScroll, this, std::placeholders::_1));
+  commands_.push_back(
+      std::bind(&ConnectFour::HandleHint, this, std::placeholders::_1));
 
   level_names_.push_back(k0EasyLevel);
   level_names_.push_back(k1BeginnerLevel);
@@ -50,6 +65,35 @@ ConnectFour::ConnectFour()
 ConnectFour::~ConnectFour() {
 }
 
+void ConnectFour::SetRecordFile(const std::string& path) {
+  recorder_.reset();
+  record_stream_.reset(
+      new std::ofstream(path, std::ios::binary | std::ios::app));
+  if(record_stream_->is_open()) {
+    recorder_.reset(new Core::GameRecordWriter(*record_stream_));
+  }
+}
+
+// Closes the record of the previous game and starts a new one
+void ConnectFour::RecordNewGame() {
+  if(!recorder_) {
+    return;
+  }
+  Core::GameRecordHeader header;
+  header.variant_ = kGameVariantsEnum[current_options_.kind_];
+  header.dimensions_ = model_board_->GetDimensions();
+  header.num_win_connected_ = num_chips_connected_;
+  header.piece_IDs_ = model_board_->GetPieceIDs();
+  for(auto piece_ID : header.piece_IDs_) {
+    auto it = current_options_.players_.find(piece_ID);
+    assert(it != current_options_.players_.end());
+    header.player_names_.push_back(it->second.GetName());
+  }
+  header.has_move_info_ = true;
+  recorder_->BeginGame(header);
+  model_board_->SetRecorder(recorder_.get());
+}
+
 /**
  * @brief This is the game main loop
  * It displays the instructions
@@ -89,6 +133,7 @@ bool ConnectFour::IsHumanPlayerTurn() const {
  * @return user input string
  */
 std::string ConnectFour::GetInput() {
+  CONNECTX_TRACE_SCOPE("ConnectFour::GetInput");
   if(!IsOnGoing()) {
     std::pair<int, int> current_cursor;
     UI::GetCursorPosition(current_cursor);
@@ -131,18 +176,25 @@ void ConnectFour::PrintWelcomeMsg() {
         << kRestartCmd << kInstructionsMsg_5 << std::endl;
   stemp << kIndentScreen << kInstructionsMsg_6 << kDifficultyCmd
         << kInstructionsMsg_7 << std::endl;
+  stemp << kIndentScreen << kInstructionsMsg_8 << kScrollLeftCmd
+        << kScrollRightCmd << kScrollUpCmd << kScrollDownCmd
+        << kInstructionsMsg_9 << std::endl;
+  stemp << kIndentScreen << kInstructionsMsg_10 << kHintCmd
+        << kInstructionsMsg_11 << std::endl;
   UI::WriteToWindow(stemp);
 }
 
 // Gets user inputs during a game (the column index)
-// the user can also abandon, undo the last move or retstart.
-std::string ConnectFour::GetUserInput() const {
+// the user can also abandon, undo the last move or retstart. The hint is
+// updated while the user types.
+std::string ConnectFour::GetUserInput() {
   std::string user_input;
   std::stringstream s_stream;
   std::size_t temp_value;
   int errors = 0;
   std::pair<int, int> input_position;
   int message_lenght = kIndentScreen.size() + strlen(kEnterMoveMsg);
+  int max_input_size = number_digits(latest_positions_.size());
   UI::GetCursorPosition(input_position);
   do {
     s_stream.clear();
@@ -154,17 +206,25 @@ std::string ConnectFour::GetUserInput() const {
     UI::ClearRemainingWindow();
     UI::SetCursorPosition(input_position.first + message_lenght,
                           input_position.second);
-    UI::GetCharacter(user_input, 1);
+    user_input.clear();
+    while(!UI::ReadCharacters(user_input, max_input_size,
+                              hint_enabled_ ? kHintRefreshDelay : -1)) {
+      RefreshHint();
+    }
     if(user_input.compare(kQuitGameCmdStr) == 0 ||
        user_input.compare(kUndoGameCmdStr) == 0 ||
-       user_input.compare(kRestartCmdStr) == 0) {
+       user_input.compare(kRestartCmdStr) == 0 ||
+       user_input.compare(kScrollLeftCmdStr) == 0 ||
+       user_input.compare(kScrollRightCmdStr) == 0 ||
+       user_input.compare(kScrollUpCmdStr) == 0 ||
+       user_input.compare(kScrollDownCmdStr) == 0 ||
+       user_input.compare(kHintCmdStr) == 0) {
       break;
     }
     s_stream.str(user_input);
     s_stream >> temp_value;
     errors++;
-  } while(!((temp_value > 0 &&
-             temp_value <= model_board_->GetDimensions()[k2ndDim])) ||
+  } while(!((temp_value > 0 && temp_value <= latest_positions_.size())) ||
           s_stream.fail());
 
   return user_input;
@@ -176,14 +236,20 @@ std::string ConnectFour::GetUserInput() const {
  * connected chips
  */
 void ConnectFour::DropChip() {
+  CONNECTX_TRACE_SCOPE("ConnectFour::DropChip");
   Core::ModelBoard::MoveType last_move = model_board_->GetLastMove();
-  std::size_t row = 0;
-  while(row < last_move[k1stDim]) {
-    board_->SetChip({row, last_move[k2ndDim]},
-                    model_board_->GetCurrentChipId());
-    row++;
+  board_->ScrollTo(last_move);
+  Core::ModelBoard::MoveType position(last_move);
+  for(position[k1stDim] = 0; position[k1stDim] < last_move[k1stDim];
+      position[k1stDim]++) {
+    if(!board_->IsVisible(position)) {
+      // rows above the viewport are not animated
+      continue;
+    }
+    board_->SetChip(position, model_board_->GetCurrentChipId());
     board_->DrawBoard();
-    board_->SetChip({row - 1, last_move[k2ndDim]});
+    board_->SetChip(position);
+    CONNECTX_TRACE_SCOPE("AnimationSleep");
     std::this_thread::sleep_for(std::chrono::milliseconds(
         (model_board_->GetAIDepth(model_board_->GetCurrentChipId()) ==
                  Core::kLevelExternalPlayer ?
@@ -202,6 +268,7 @@ void ConnectFour::DropChip() {
 
 // This draws the board on the screen
 void ConnectFour::DrawBoard() {
+  CONNECTX_TRACE_SCOPE("ConnectFour::DrawBoard");
   if(last_move_ >= 0 && b_played_) {
     DropChip();
     if(model_board_->GetCurrentState() == Core::States::Win) {
@@ -245,15 +312,47 @@ void ConnectFour::PrintLastAndPossibleMoves() {
 void ConnectFour::DrawFooter() {
   margin_board_->PrintFooter(model_board_->GetNextChipId(), latest_positions_,
                              last_move_);
+  UpdateHint();
   margin_board_->DrawFooter();
 }
 
+// Starts the analysis of the position for the human player to move and
+// prints its best move in the footer
+void ConnectFour::UpdateHint() {
+  if(!hint_enabled_ || !IsHumanPlayerTurn()) {
+    margin_board_->ClearHint();
+    return;
+  }
+  if(!analysis_->IsStarted()) {
+    analysis_->Start(*model_board_);
+  }
+  Core::AnalysisReport report = analysis_->GetReport();
+  num_hint_iterations_ = report.num_iterations_;
+  if(report.num_iterations_ == 0) {
+    margin_board_->PrintHint();
+  } else {
+    margin_board_->PrintHint(GetColumn(report.move_), report.depth_,
+                             report.score_, report.win_score_);
+  }
+}
+
+// Redraws the hint once the analysis has completed another iteration
+void ConnectFour::RefreshHint() {
+  if(!hint_enabled_ || !analysis_->IsStarted() ||
+     analysis_->GetReport().num_iterations_ == num_hint_iterations_) {
+    return;
+  }
+  UpdateHint();
+  margin_board_->DrawHint();
+}
+
 // Displays the board and all the details on the screen
 void ConnectFour::Display() {
+  CONNECTX_TRACE_SCOPE("ConnectFour::Display");
   DrawBoard();
   std::pair<int, int> origin_cursor;
   UI::GetCursorPosition(origin_cursor);
-  UI::ClearWindowCurrentLine(3);
+  UI::ClearWindowCurrentLine(4);
   UI::SetCursorPosition(origin_cursor.first, origin_cursor.second);
   if(IsOnGoing()) {
     DrawFooter();
@@ -286,6 +385,7 @@ void ConnectFour::ProcessInput(const std::string& input) {
 // Handles the Quit Game command
 bool ConnectFour::HandleQuit(const std::string& command) {
   if(command.compare(kQuitGameCmdStr) == 0) {
+    analysis_->Stop();
     running_ = false;
     return !running_;
   }
@@ -321,10 +421,12 @@ bool ConnectFour::HandleRestart(const std::string& command) {
 }
 
 // Handles the command to undo the last move depending on the state of the game
+// one move of every player is undone so that the same player plays again
 bool ConnectFour::HandleUndo(const std::string& command) {
   if(command.compare(kUndoGameCmdStr) == 0) {
+    analysis_->Stop();
     int undo_counter =
-        std::min(kAtomicUndoCounter,
+        std::min(model_board_->GetPieceIDs().size(),
                  model_board_->GetHistoryCount() - offset_history_count_);
     if(model_board_->GetCurrentState() == Core::States::Win) {
       std::list<Core::ModelBoard::MoveType> win_positions;
@@ -337,7 +439,7 @@ bool ConnectFour::HandleUndo(const std::string& command) {
       model_board_->Undo();
       latest_positions_[last_move_]++;
       if(model_board_->GetHistoryCount() - offset_history_count_ > 0) {
-        last_move_ = model_board_->GetLastMove()[k2ndDim];
+        last_move_ = GetColumn(model_board_->GetLastMove());
       } else {
         last_move_ = kLastMoveBoardEmpty;
       }
@@ -348,26 +450,61 @@ bool ConnectFour::HandleUndo(const std::string& command) {
   return false;
 }
 
+// Handles the commands moving the viewport of large boards
+bool ConnectFour::HandleScroll(const std::string& command) {
+  if(command.compare(kScrollLeftCmdStr) == 0) {
+    board_->Scroll(0, -1);
+  } else if(command.compare(kScrollRightCmdStr) == 0) {
+    board_->Scroll(0, 1);
+  } else if(command.compare(kScrollUpCmdStr) == 0) {
+    board_->Scroll(-1, 0);
+  } else if(command.compare(kScrollDownCmdStr) == 0) {
+    board_->Scroll(1, 0);
+  } else {
+    return false;
+  }
+  return true;
+}
+
+// Shows or hides the hint, the analysis runs only while it is shown
+bool ConnectFour::HandleHint(const std::string& command) {
+  if(command.compare(kHintCmdStr) == 0) {
+    hint_enabled_ = !hint_enabled_;
+    if(!hint_enabled_) {
+      analysis_->Stop();
+    }
+    return true;
+  }
+  return false;
+}
+
 bool ConnectFour::HandleMove(const std::string& command) {
+  analysis_->Stop();
   Core::ModelBoard::MoveType current_move(model_board_->GetDimensions().size());
   if(IsHumanPlayerTurn()) {
     std::size_t col = atoi(command.c_str()) - 1;
     if(latest_positions_[col] > 0) {  // is not full
-      current_move[k2ndDim] = col;
-      current_move[k1stDim] = --latest_positions_[current_move[k2ndDim]];
+      current_move = GetColumnMove(col, --latest_positions_[col]);
       model_board_->SetMove(current_move);
       b_played_ = true;
     }
   } else {
     model_board_->GetAIPlayerMove(current_move,
                                   std::chrono::milliseconds(1000));
+    if(recorder_) {
+      recorder_->SetNextMoveInfo(model_board_->GetLastScore(),
+                                 model_board_->GetActualThinkingTime());
+    }
     model_board_->SetMove(current_move);
-    std::this_thread::sleep_for(std::chrono::milliseconds(kDelayAIPlayer));
-    --latest_positions_[current_move[k2ndDim]];
+    {
+      CONNECTX_TRACE_SCOPE("AIPlayerDelay");
+      std::this_thread::sleep_for(std::chrono::milliseconds(kDelayAIPlayer));
+    }
+    --latest_positions_[GetColumn(current_move)];
     b_played_ = true;
   }
   if(b_played_) {
-    last_move_ = current_move[k2ndDim];
+    last_move_ = GetColumn(current_move);
   }
   return true;
 }
@@ -387,7 +524,9 @@ void ConnectFour::ChangeAIDepthsOptions() {
       }
       ++mit;
     }
-  } else if(kPlayerModeEnum[current_options_.player_mode_] == kTwoAIPlayers) {
+  } else if(kPlayerModeEnum[current_options_.player_mode_] == kTwoAIPlayers ||
+            kPlayerModeEnum[current_options_.player_mode_] ==
+                kThreeAIPlayers) {
     Reset();
     UI::ClearWindowScreen();
     GetAIPlayerLevels();
@@ -408,12 +547,14 @@ void ConnectFour::ChangeAIDepthsOptions() {
 
 void ConnectFour::ConfigureOptions() {
   UI::ClearWindowScreen();
+  UI::SetWindowScrolling(true);
   PrintWelcomeMsg();
   GetVariants();
   GetPlayerConfig();
   GetPlayerDetails();
   GetFirstPlayer();
   GetLevels();
+  UI::SetWindowScrolling(false);
   InitializeGame();
   PrintTopHeader();
   PrintBtmHeader();
@@ -424,7 +565,9 @@ void ConnectFour::ConfigureOptions() {
 void ConnectFour::GetLevels() {
   if(kPlayerModeEnum[current_options_.player_mode_] == kSinglePlayer) {
     GetDifficulty();
-  } else if(kPlayerModeEnum[current_options_.player_mode_] == kTwoAIPlayers) {
+  } else if(kPlayerModeEnum[current_options_.player_mode_] == kTwoAIPlayers ||
+            kPlayerModeEnum[current_options_.player_mode_] ==
+                kThreeAIPlayers) {
     GetAIPlayerLevels();
   }
 }
@@ -449,6 +592,50 @@ void ConnectFour::GetAIPlayerLevels() {
 void ConnectFour::GetVariants() {
   UI::GotoNextWindowLine();
   GetSelectedOptions(kGameVariantsEnum, current_options_.kind_, kChooseKindMsg);
+  if(kGameVariantsEnum[current_options_.kind_] == kCustomConnectX) {
+    GetCustomBoard();
+  }
+}
+
+// Asks for the size of the board and the number of chips to connect
+void ConnectFour::GetCustomBoard() {
+  std::size_t rows, columns, num_connected;
+  std::ostringstream temp_ostream;
+  auto in_range = [](const std::size_t& x) {
+    return (x >= kMinCustomBoardSize && x <= kMaxCustomBoardSize);
+  };
+  UI::GotoNextWindowLine();
+  temp_ostream << kIndentScreen << kCustomRowsMsg << kGetDepthMsg_2
+               << kMinCustomBoardSize << kAndStr << kMaxCustomBoardSize
+               << kGetDepthMsg_3;
+  GetValueFromConsoleUser(rows, temp_ostream.str(), in_range);
+  temp_ostream.str("");
+  temp_ostream << kIndentScreen << kCustomColumnsMsg << kGetDepthMsg_2
+               << kMinCustomBoardSize << kAndStr << kMaxCustomBoardSize
+               << kGetDepthMsg_3;
+  GetValueFromConsoleUser(columns, temp_ostream.str(), in_range);
+  std::size_t max_connected = std::max(rows, columns);
+  temp_ostream.str("");
+  temp_ostream << kIndentScreen << kCustomConnectedMsg << kGetDepthMsg_2
+               << kMinCustomBoardSize << kAndStr << max_connected
+               << kGetDepthMsg_3;
+  GetValueFromConsoleUser(num_connected, temp_ostream.str(),
+                          [max_connected](const std::size_t& x) {
+                            return (x >= kMinCustomBoardSize &&
+                                    x <= max_connected);
+                          });
+  current_options_.custom_dimensions_ = {rows, columns};
+  current_options_.custom_num_connected_ = num_connected;
+}
+
+// Sizes the viewport of the board to the space left by the header and footer
+void ConnectFour::FitBoardToWindow() {
+  std::pair<int, int> window_size;
+  UI::GetWindowSize(window_size);
+  std::size_t lines = std::max(window_size.second, 0);
+  std::size_t columns = std::max(window_size.first, 0);
+  board_->FitToWindow(lines > kMarginWindowLines ? lines - kMarginWindowLines : 0,
+                      columns);
 }
 
 void ConnectFour::GetPlayerConfig() {
@@ -459,11 +646,16 @@ void ConnectFour::GetPlayerConfig() {
 
 void ConnectFour::GetFirstPlayer() {
   UI::GotoNextWindowLine();
-  auto it_player1 = current_options_.players_.find(kFirstPlayerChipId);
-  auto it_player2 = current_options_.players_.find(kFirstPlayerChipId + 1);
-  GetSelectedOptions({it_player1->second.GetName().c_str(),
-                      it_player2->second.GetName().c_str()},
-                     current_options_.firstplayer_, "Who is playing first? ");
+  std::vector<std::string> names;
+  for(const auto& ID_player : current_options_.players_) {
+    names.push_back(ID_player.second.GetName());
+  }
+  std::vector<const char*> options;
+  for(const std::string& name : names) {
+    options.push_back(name.c_str());
+  }
+  GetSelectedOptions(options, current_options_.firstplayer_,
+                     "Who is playing first? ");
 }
 
 void ConnectFour::GetDifficulty() {
@@ -473,9 +665,11 @@ void ConnectFour::GetDifficulty() {
 }
 
 void ConnectFour::Reset() {
+  analysis_->Stop();
   std::fill(latest_positions_.begin(), latest_positions_.end(),
             model_board_->GetDimensions()[k1stDim]);
   model_board_->Reset();
+  RecordNewGame();
   board_->ClearBoard();
   b_played_ = false;
   if(kGameVariantsEnum[current_options_.kind_] == kFiveInRowConnectFour) {
@@ -504,36 +698,43 @@ void ConnectFour::DisplayEndofGame() const {
  * @param num_chips_connected output argument to retrieve the number of chips to
  * connect to win.
  */
-void ConnectFour::InitializeGameVariant(uint8_t& num_chips_connected) {
+void ConnectFour::InitializeGameVariant(uint8_t& num_chips_connected,
+                                        std::vector<std::size_t>& dimensions) {
   UI::TextPiece chip1(UI::TextPiece::SymbolType(KPly1Symbol),
                       kFirstPlayerChipId);
   UI::TextPiece chip2(UI::TextPiece::SymbolType(KPly2Symbol),
                       kFirstPlayerChipId + 1);
   std::map<int8_t, UI::TextPiece> chips = {{chip1.GetIdentifier(), chip1},
                                            {chip2.GetIdentifier(), chip2}};
-  if(kGameVariantsEnum[current_options_.kind_] == kClassicConnectFour) {
-    board_.reset(new UI::ConnectXBoard(
-        chips, {kClassicBoardNumRows, kClassicBoardNumCols}, kIndentScreen));
-
-  } else if(kGameVariantsEnum[current_options_.kind_] ==
-            kFiveInRowConnectFour) {
-    board_.reset(new UI::ConnectXBoard(
-        chips, {kClassicBoardNumRows, kClassicBoardNumCols + 2},
-        kIndentScreen));
+  if(current_options_.players_.size() > 2) {
+    UI::TextPiece chip3(UI::TextPiece::SymbolType(KPly3Symbol),
+                        kFirstPlayerChipId + 2);
+    chips.insert(std::make_pair(chip3.GetIdentifier(), chip3));
+  }
+  dimensions = {kClassicBoardNumRows, kClassicBoardNumCols};
+  if(kGameVariantsEnum[current_options_.kind_] == kFiveInRowConnectFour) {
+    dimensions = {kClassicBoardNumRows, kClassicBoardNumCols + 2};
     num_chips_connected = kClassicChipsConnected + 1;
   } else if(kGameVariantsEnum[current_options_.kind_] == k3By6ConnectThree) {
-    board_.reset(new UI::ConnectXBoard(
-        chips, {KClassic3By6Width, KClassic3By6Height}, kIndentScreen));
+    dimensions = {KClassic3By6Width, KClassic3By6Height};
     num_chips_connected = kClassicChipsConnected - 1;
   } else if(kGameVariantsEnum[current_options_.kind_] == kTenBy7ConnectFour) {
-    board_.reset(new UI::ConnectXBoard(
-        chips, {kClassicBoardNumRows + 1, kClassicBoardNumCols + 3},
-        kIndentScreen));
+    dimensions = {kClassicBoardNumRows + 1, kClassicBoardNumCols + 3};
   } else if(kGameVariantsEnum[current_options_.kind_] == kEightBy8ConnectFour) {
-    board_.reset(new UI::ConnectXBoard(
-        chips, {kClassicBoardNumRows + 2, kClassicBoardNumCols + 1},
-        kIndentScreen));
+    dimensions = {kClassicBoardNumRows + 2, kClassicBoardNumCols + 1};
+  } else if(kGameVariantsEnum[current_options_.kind_] == kScoreFour) {
+    dimensions.assign(3, kScoreFourBoardSize);
+  } else if(kGameVariantsEnum[current_options_.kind_] == kCustomConnectX) {
+    dimensions = current_options_.custom_dimensions_;
+    num_chips_connected = current_options_.custom_num_connected_;
+  }
+  // the planes of a 3D board are drawn side by side
+  if(dimensions.size() > 2) {
+    board_.reset(new UI::LayeredBoard(chips, dimensions, kIndentScreen));
+  } else {
+    board_.reset(new UI::ConnectXBoard(chips, dimensions, kIndentScreen));
   }
+  FitBoardToWindow();
   margin_board_.reset(
       new UI::MarginBoard(current_options_, board_->GetNumCharLine(),
                           level_names_, chips, board_->GetDimensions()));
@@ -541,46 +742,65 @@ void ConnectFour::InitializeGameVariant(uint8_t& num_chips_connected) {
 
 /**
  * @brief Creates the intelligent_board for the ~AI module.
- * the intelligent_board needs to know which side is the computer on (party1 or
- * party2), the difficulty level, the number of pieces to connect to win, and
- * the board's dimension.
+ * the intelligent_board needs to know which sides are the computer's, the
+ * difficulty level, the number of pieces to connect to win, and the board's
+ * dimension. The players keep their order, starting from the first player.
  * @param num_chips_connected  the number of chips to connect to win.
  */
-void ConnectFour::InitializeModel(uint8_t num_chips_connected) {
-  Core::IntelligentBoard::Party party1(kFirstPlayerChipId,
-                                       Core::kLevelExternalPlayer);
-  Core::IntelligentBoard::Party party2(kFirstPlayerChipId + 1,
-                                       Core::kLevelExternalPlayer);
+void ConnectFour::InitializeModel(const std::vector<std::size_t>& dimensions,
+                                  uint8_t num_chips_connected) {
+  std::vector<Core::IntelligentBoard::Party> parties;
+  for(const auto& ID_player : current_options_.players_) {
+    parties.push_back(Core::IntelligentBoard::Party(
+        ID_player.first, Core::kLevelExternalPlayer));
+  }
 
   if(kPlayerModeEnum[current_options_.player_mode_] == kSinglePlayer) {
-    party2.depth_ = kLevelsArray[current_options_.difficulty_];
-  } else if(kPlayerModeEnum[current_options_.player_mode_] == kTwoAIPlayers) {
-    party1.depth_ = current_options_.simulation_depths_[kFirstPlayerChipId];
-    party2.depth_ = current_options_.simulation_depths_[kFirstPlayerChipId + 1];
+    parties[1].depth_ = kLevelsArray[current_options_.difficulty_];
+  } else if(kPlayerModeEnum[current_options_.player_mode_] == kTwoAIPlayers ||
+            kPlayerModeEnum[current_options_.player_mode_] ==
+                kThreeAIPlayers) {
+    for(Core::IntelligentBoard::Party& party : parties) {
+      party.depth_ = current_options_.simulation_depths_[party.chip_id_];
+    }
   }
 
-  if(current_options_.firstplayer_ == 0) {
-    model_board_.reset(new Core::IntelligentBoard(
-        {party1, party2},
-        {board_->GetDimensions()[k1stDim], board_->GetDimensions()[k2ndDim]},
-        num_chips_connected));
+  std::rotate(parties.begin(), parties.begin() + current_options_.firstplayer_,
+              parties.end());
+  // the positions of the previous variant are of no use
+  analysis_->Clear();
+  model_board_.reset(
+      new Core::IntelligentBoard(parties, dimensions, num_chips_connected));
+  if(proof_search_) {
+    proof_search_->Clear();
   } else {
-    model_board_.reset(new Core::IntelligentBoard(
-        {party2, party1},
-        {board_->GetDimensions()[k1stDim], board_->GetDimensions()[k2ndDim]},
-        num_chips_connected));
+    proof_search_.reset(new Core::ProofSearch());
   }
+  model_board_->SetProofSearch(proof_search_.get());
+  if(endgame_solver_) {
+    endgame_solver_->Clear();
+  } else {
+    endgame_solver_.reset(new Core::EndgameSolver());
+  }
+  model_board_->SetEndgameSolver(endgame_solver_.get());
 }
 
 // Initializes the game
 void ConnectFour::InitializeGame() {
   uint8_t num_chips_connected = kClassicChipsConnected;
-  InitializeGameVariant(num_chips_connected);
-  InitializeModel(num_chips_connected);
+  std::vector<std::size_t> dimensions;
+  InitializeGameVariant(num_chips_connected, dimensions);
+  InitializeModel(dimensions, num_chips_connected);
+  num_chips_connected_ = num_chips_connected;
+  RecordNewGame();
   offset_history_count_ = 0;
-  latest_positions_.resize(board_->GetDimensions()[k2ndDim]);
+  std::size_t num_columns = 1;
+  for(std::size_t axis = k2ndDim; axis < dimensions.size(); axis++) {
+    num_columns *= dimensions[axis];
+  }
+  latest_positions_.resize(num_columns);
   std::fill(latest_positions_.begin(), latest_positions_.end(),
-            board_->GetDimensions()[k1stDim]);
+            dimensions[k1stDim]);
   if(kGameVariantsEnum[current_options_.kind_] == kFiveInRowConnectFour) {
     FillForConnectFive();
   }
@@ -600,7 +820,7 @@ void ConnectFour::DisplayNameSizeLimits() {
 // Ask the users for their names depending on the number of players involved
 void ConnectFour::GetPlayerDetails() {
   current_options_.players_.clear();
-  std::string first_player, second_player;
+  std::string first_player, second_player, third_player;
   if(kPlayerModeEnum[current_options_.player_mode_] == kSinglePlayer) {
     DisplayNameSizeLimits();
     GetValueFromConsoleUser(first_player, kIndentScreen + kNameMsg,
@@ -626,12 +846,21 @@ void ConnectFour::GetPlayerDetails() {
   } else if(kPlayerModeEnum[current_options_.player_mode_] == kTwoAIPlayers) {
     first_player = kAIPlayer1NameMsg;
     second_player = kAIPlayer2NameMsg;
+  } else if(kPlayerModeEnum[current_options_.player_mode_] ==
+            kThreeAIPlayers) {
+    first_player = kAIPlayer1NameMsg;
+    second_player = kAIPlayer2NameMsg;
+    third_player = kAIPlayer3NameMsg;
   }
 
   current_options_.players_.insert(
       std::make_pair(kFirstPlayerChipId, Player(first_player)));
   current_options_.players_.insert(std::make_pair(
       static_cast<int8_t>(kFirstPlayerChipId + 1), Player(second_player)));
+  if(!third_player.empty()) {
+    current_options_.players_.insert(std::make_pair(
+        static_cast<int8_t>(kFirstPlayerChipId + 2), Player(third_player)));
+  }
 }
 
 // This method deals specifically with the ConnectFive variant where the first
@@ -653,6 +882,27 @@ void ConnectFour::FillColumn(std::size_t column, std::size_t num_stop_row) {
     board_->SetChip(current_move, model_board_->GetCurrentChipId());
   }
 }
+std::size_t ConnectFour::GetColumn(const std::vector<std::size_t>& move) const {
+  const std::vector<std::size_t>& dimensions = model_board_->GetDimensions();
+  std::size_t column = 0;
+  for(std::size_t axis = k2ndDim; axis < dimensions.size(); axis++) {
+    column = column * dimensions[axis] + move[axis];
+  }
+  return column;
+}
+
+std::vector<std::size_t> ConnectFour::GetColumnMove(std::size_t column,
+                                                    std::size_t row) const {
+  const std::vector<std::size_t>& dimensions = model_board_->GetDimensions();
+  std::vector<std::size_t> move(dimensions.size());
+  move[k1stDim] = row;
+  for(std::size_t axis = dimensions.size() - 1; axis >= k2ndDim; axis--) {
+    move[axis] = column % dimensions[axis];
+    column /= dimensions[axis];
+  }
+  return move;
+}
+
 void ConnectFour::PrepareCursor() {
   board_->PrepareCursor();
 }
@@ -0,0 +1,188 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : C interface of the core library (libconnectx_core).
+//============================================================================
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <new>
+#include "connectx.h"
+#include "engine.h"
+
+using namespace Core;
+
+const long kDefaultSearchTimeMs = 1000;
+
+struct cx_board {
+  Position variant_;
+  std::unique_ptr<IntelligentBoard> board_;
+  std::unique_ptr<TranspositionTable> table_;
+};
+
+// Copies the text like snprintf
+static size_t CopyText(const std::string& source, char* text, size_t size) {
+  if(size > 0) {
+    std::size_t length = std::min(source.size(), size - 1);
+    std::memcpy(text, source.data(), length);
+    text[length] = '\0';
+  }
+  return source.size();
+}
+
+const char* cx_version(void) {
+  static const std::string version =
+      std::to_string(CONNECTX_VERSION_MAJOR) + '.' +
+      std::to_string(CONNECTX_VERSION_MINOR);
+  return version.c_str();
+}
+
+cx_board* cx_board_create(const char* variant) {
+  std::unique_ptr<cx_board> board(new(std::nothrow) cx_board);
+  if(!board || variant == nullptr || !ParseVariant(variant, board->variant_)) {
+    return nullptr;
+  }
+  std::vector<IntelligentBoard::Party> parties;
+  for(uint8_t turn = 1; turn <= board->variant_.num_players_; turn++) {
+    parties.push_back(IntelligentBoard::Party(turn));
+  }
+  board->board_.reset(new(std::nothrow) IntelligentBoard(
+      parties, board->variant_.dimensions_,
+      board->variant_.num_win_connected_));
+  return board->board_ ? board.release() : nullptr;
+}
+
+void cx_board_destroy(cx_board* board) {
+  delete board;
+}
+
+int cx_board_set_table_size(cx_board* board, size_t megabytes) {
+  board->board_->SetTranspositionTable(nullptr);
+  board->table_.reset();
+  if(megabytes > 0) {
+    board->table_.reset(new(std::nothrow) TranspositionTable(megabytes));
+    if(!board->table_) {
+      return CX_ERROR;
+    }
+    board->board_->SetTranspositionTable(board->table_.get());
+  }
+  return CX_OK;
+}
+
+void cx_board_reset(cx_board* board) {
+  board->board_->Reset();
+}
+
+int cx_board_set_position(cx_board* board, const char* position) {
+  Position parsed;
+  if(position == nullptr || !ParsePosition(position, parsed) ||
+     !SetPosition(parsed, *board->board_)) {
+    return CX_ERROR;
+  }
+  return CX_OK;
+}
+
+size_t cx_board_get_position(const cx_board* board, char* text, size_t size) {
+  return CopyText(SerializePosition(*board->board_), text, size);
+}
+
+int cx_board_play(cx_board* board, const char* move) {
+  ModelBoard::CoMoveType column;
+  if(move == nullptr ||
+     !ParseMove(move, board->variant_.dimensions_, column) ||
+     !board->board_->SetMoveInColumn(column)) {
+    return CX_ERROR;
+  }
+  return CX_OK;
+}
+
+int cx_board_undo(cx_board* board) {
+  if(board->board_->GetHistoryCount() == 0) {
+    return CX_ERROR;
+  }
+  board->board_->Undo();
+  return CX_OK;
+}
+
+int cx_board_get_state(const cx_board* board) {
+  switch(board->board_->GetCurrentState()) {
+    case States::Win:
+      return CX_WIN;
+    case States::Draw:
+      return CX_DRAW;
+    default:
+      return CX_ONGOING;
+  }
+}
+
+int cx_board_get_player(const cx_board* board) {
+  const std::vector<ModelBoard::PieceIDType>& piece_IDs =
+      board->board_->GetPieceIDs();
+  return std::find(piece_IDs.begin(), piece_IDs.end(),
+                   board->board_->GetNextChipId()) -
+         piece_IDs.begin() + 1;
+}
+
+// A search without any limit lasts kDefaultSearchTimeMs
+static SearchLimits GetSearchLimits(const cx_limits* limits) {
+  SearchLimits search_limits;
+  if(limits != nullptr) {
+    if(limits->depth > 0) {
+      search_limits.depth_ = std::min<int>(limits->depth, kMaxSearchDepth);
+    }
+    search_limits.nodes_ = limits->nodes;
+    search_limits.movetime_ =
+        std::chrono::milliseconds(std::max(limits->movetime_ms, 0L));
+  }
+  if(limits == nullptr ||
+     (limits->depth <= 0 && limits->nodes == 0 && limits->movetime_ms <= 0)) {
+    search_limits.movetime_ = std::chrono::milliseconds(kDefaultSearchTimeMs);
+  }
+  return search_limits;
+}
+
+int cx_board_search(cx_board* board,
+                    const cx_limits* limits,
+                    char* move,
+                    size_t size,
+                    int* score) {
+  ModelBoard::MoveType best_move;
+  if(!board->board_->Search(GetSearchLimits(limits), best_move)) {
+    return CX_ERROR;
+  }
+  if(move != nullptr) {
+    CopyText(FormatMove(best_move), move, size);
+  }
+  if(score != nullptr) {
+    *score = board->board_->GetLastScore();
+  }
+  return CX_OK;
+}
+
+int cx_board_search_lines(cx_board* board,
+                          const cx_limits* limits,
+                          size_t num_lines,
+                          char* moves,
+                          size_t size,
+                          int* scores) {
+  SearchLimits search_limits = GetSearchLimits(limits);
+  search_limits.multi_pv_ = num_lines;
+  ModelBoard::MoveType best_move;
+  if(!board->board_->Search(search_limits, best_move)) {
+    return CX_ERROR;
+  }
+  const std::vector<RankedMove>& ranked_moves =
+      board->board_->GetRankedMoves();
+  std::size_t num_ranked = std::min(num_lines, ranked_moves.size());
+  for(std::size_t line = 0; line < num_ranked; line++) {
+    if(moves != nullptr) {
+      CopyText(FormatMove(ranked_moves[line].move_), moves + line * size,
+               size);
+    }
+    if(scores != nullptr) {
+      scores[line] = ranked_moves[line].score_;
+    }
+  }
+  return static_cast<int>(num_ranked);
+}
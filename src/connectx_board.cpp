@@ -5,6 +5,7 @@
 // Description :
 //============================================================================
 #include <algorithm>
+#include <iomanip>
 #include <iterator>
 #include <memory>
 #include "connectx_board.h"
@@ -15,65 +16,116 @@ ConnectXBoard::ConnectXBoard(const std::map<int8_t, TextPiece>& chips,
                              const std::vector<std::size_t>& dimensions,
                              const std::string& line_indent)
     : TextBoard(chips, dimensions, line_indent) {
-  PrintColumnNumber();
+  RenderViewport();
 }
 
 void ConnectXBoard::SetConnectedChips(const std::list<std::vector<std::size_t> >& positions, int8_t piece_ID) {
   std::for_each(positions.begin(), positions.end(), [this, piece_ID](const std::vector<std::size_t>& val) {
-    ChangeBackgroundCell(val, piece_ID, kEmptyChar, kDotChar);
+    ChangeBackgroundCell(val, piece_ID, true);
   });
 }
 
 void ConnectXBoard::UnSetConnectedChips(const std::list<std::vector<std::size_t> >& positions, int8_t piece_ID) {
   std::for_each(positions.begin(), positions.end(), [this, piece_ID](const std::vector<std::size_t>& val) {
-    ChangeBackgroundCell(val, piece_ID, kDotChar, kEmptyChar);
+    ChangeBackgroundCell(val, piece_ID, false);
   });
 }
 
-void ConnectXBoard::ChangeBackgroundCell(const std::vector<std::size_t>& position,
-                                         int8_t piece_ID,
-                                         char replaced_char,
-                                         char new_char) {
+void ConnectXBoard::ChangeBackgroundCell(
+    const std::vector<std::size_t>& model_position,
+    int8_t piece_ID,
+    bool highlighted) {
+  std::vector<std::size_t> position = GetGridPosition(model_position);
   assert(position.size() == kMaxDimensions);
-  board_stream_.seekp(0, board_stream_.beg);
-  std::size_t pos = (position[kfirstAxis] * line_length_ * (h_cell_size_)) + kTopMargin + 1 + line_indent_.size() +
-                    position[kSecondAxis] * (l_cell_size_ + 1);
-  board_stream_.seekp(pos, board_stream_.beg);
-  std::string temp;
-  if(piece_ID != kPieceEmptyCell) {
-    auto it = chips_.find(piece_ID);
-    if(it != chips_.end()) {
-      auto array_string = it->second.GetSymbol();
-      for(std::size_t i = 0; i < array_string.size(); i++) {
-        temp = array_string[i];
-        std::replace(temp.begin(), temp.end(), replaced_char, new_char);
-        board_stream_ << temp;
-        board_stream_.seekp(line_length_ - l_cell_size_, board_stream_.cur);
-      }
-    }
+  if(piece_ID != kPieceEmptyCell && chips_.find(piece_ID) != chips_.end()) {
+    cells_[GetCellIndex(position)] = piece_ID;
+    SetHighlighted(position, highlighted);
   }
 }
 
+// The column numbers are printed below the grid. In compact mode, a column is
+// one character wide so the numbers are printed vertically, one line per digit.
 void ConnectXBoard::PrintColumnNumber() {
-  assert(number_digits(dimensions_[kSecondAxis]) < l_cell_size_ - 1);
+  std::size_t first_col = view_origin_[kSecondAxis];
+  std::size_t last_col = first_col + view_size_[kSecondAxis];
+  if(compact_) {
+    std::size_t divisor = 1;
+    for(std::size_t d = 1; d < number_digits(GetMaxColumnLabel()); d++) {
+      divisor *= 10;
+    }
+    for(; divisor > 0; divisor /= 10) {
+      board_stream_ << line_indent_;
+      for(std::size_t k = first_col; k < last_col; k++) {
+        board_stream_ << kVerticalLine;
+        std::size_t label = GetColumnLabel(k);
+        if(label > 0 && label >= divisor) {
+          board_stream_ << static_cast<char>('0' + label / divisor % 10);
+        } else {
+          board_stream_ << kEmptyChar;
+        }
+      }
+      board_stream_ << kVerticalLine;
+      PrintEmptyLine(1);
+    }
+    return;
+  }
+  assert(number_digits(GetMaxColumnLabel()) < l_cell_size_ - 1);
   std::string temp_str;
   std::string temp_str_r;
   board_stream_ << line_indent_;
   std::size_t tmp_col;
-  for(std::size_t k = 0; k < dimensions_[kSecondAxis]; k++) {
-    tmp_col = k + 1;
+  for(std::size_t k = first_col; k < last_col; k++) {
+    tmp_col = GetColumnLabel(k);
+    if(tmp_col == 0) {
+      board_stream_ << kVerticalLine << empty_cell_string_;
+      continue;
+    }
     std::size_t pos_digit = (l_cell_size_ - number_digits(tmp_col)) / 2;
     std::size_t num_digit_right = l_cell_size_ - number_digits(tmp_col) - pos_digit;
     temp_str.resize(pos_digit, kEmptyChar);
     temp_str_r.resize(num_digit_right, kEmptyChar);
-    board_stream_ << kVerticalLine << temp_str << (k + 1) << temp_str_r;
+    board_stream_ << kVerticalLine << temp_str << tmp_col << temp_str_r;
   }
   board_stream_ << kVerticalLine;
   PrintEmptyLine(1);
 }
 
-void ConnectXBoard::ClearBoard() {
-  TextBoard::ClearBoard();
+// Prints the range of rows and columns shown when the board does not fit in
+// the window. The numbers are padded so the line keeps the same length.
+void ConnectXBoard::PrintViewportRange() {
+  if(!IsScrollable()) {
+    return;
+  }
+  int rows_width = number_digits(dimensions_[kfirstAxis]);
+  int cols_width = number_digits(dimensions_[kSecondAxis]);
+  board_stream_ << line_indent_ << Constants::kRowsRangeMsg
+                << std::setw(rows_width) << view_origin_[kfirstAxis] + 1
+                << Constants::kRangeSeparator << std::setw(rows_width)
+                << view_origin_[kfirstAxis] + view_size_[kfirstAxis]
+                << Constants::kRangeOfMsg << dimensions_[kfirstAxis]
+                << Constants::kColumnsRangeMsg << std::setw(cols_width)
+                << view_origin_[kSecondAxis] + 1 << Constants::kRangeSeparator
+                << std::setw(cols_width)
+                << view_origin_[kSecondAxis] + view_size_[kSecondAxis]
+                << Constants::kRangeOfMsg << dimensions_[kSecondAxis];
+  PrintEmptyLine(1);
+}
+
+std::size_t ConnectXBoard::GetMaxColumnLabel() const {
+  std::size_t max_label = 0;
+  for(std::size_t k = 0; k < dimensions_[kSecondAxis]; k++) {
+    max_label = std::max(max_label, GetColumnLabel(k));
+  }
+  return max_label;
+}
+
+std::size_t ConnectXBoard::GetNumExtraLines() const {
+  // column numbers and range of the viewport
+  return (compact_ ? number_digits(GetMaxColumnLabel()) : 1) + 1;
+}
+
+void ConnectXBoard::PrintExtraLines() {
   PrintColumnNumber();
+  PrintViewportRange();
 }
 }  // namespace UI
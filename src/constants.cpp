@@ -16,18 +16,26 @@ extern const char kEightBy8ConnectFour[] = "8-by-8 Connect"
 extern const char kFiveInRowConnectFour[] = "Five-in-a-Row";
 extern const char k3By6ConnectThree[] = "3-by-6 Connect "
                                         "Three";
+extern const char kScoreFour[] = "4-by-4-by-4 Score"
+                                 " Four";
+extern const char kCustomConnectX[] = "Custom board";
 extern const std::vector<const char *> kGameVariantsEnum = {kClassicConnectFour, k3By6ConnectThree,
                                                             kFiveInRowConnectFour, kTenBy7ConnectFour,
-                                                            kEightBy8ConnectFour};
+                                                            kEightBy8ConnectFour, kScoreFour,
+                                                            kCustomConnectX};
 extern const std::size_t KClassic3By6Height = 6;
 extern const std::size_t KClassic3By6Width = 3;
+extern const std::size_t kScoreFourBoardSize = 4;
 extern const std::size_t k1stDim = 0;
 extern const std::size_t k2ndDim = 1;
 extern const char kSinglePlayer[] = "Single Player";
 extern const char kTwoPlayers[] = "Two Players";
 extern const char kTwoAIPlayers[] = "Two Simulated"
                                     " Players";
-extern const std::vector<const char *> kPlayerModeEnum = {kSinglePlayer, kTwoPlayers, kTwoAIPlayers};
+extern const char kThreeAIPlayers[] = "Three Simulated"
+                                      " Players";
+extern const std::vector<const char *> kPlayerModeEnum = {kSinglePlayer, kTwoPlayers, kTwoAIPlayers,
+                                                          kThreeAIPlayers};
 extern const char kColonPoint[] = ": ";
 extern const char k0EasyLevel[] = "Beginner";
 extern const char k1BeginnerLevel[] = "Intermediate";
@@ -58,6 +66,7 @@ extern const char kEnterMoveMsg[] = "Type a column"
                                     " press Enter: ";
 extern const char kAIPlayer1NameMsg[] = "Mushu";
 extern const char kAIPlayer2NameMsg[] = "Pippin";
+extern const char kAIPlayer3NameMsg[] = "Merry";
 extern const char kGetDepthMsg_1[] = "Enter thinking"
                                      " depth of ";
 extern const char kGetDepthMsg_2[] = " (value between ";
@@ -100,13 +109,15 @@ extern const char kTok1Star[] = " *   * ";
 extern const char kTok3Stars[] = "  ***  ";
 extern const char kEvenBubbles[] = "  ooo  ";
 extern const char kOddBubble[] = " o   o ";
+extern const char kTokCrossSides[] = " x   x ";
+extern const char kTokCrossMiddle[] = "   x   ";
 extern const std::vector<std::string> KPly1Symbol = {kTok1Star, kTok3Stars, kTok1Star};
 extern const std::vector<std::string> KPly2Symbol = {kEvenBubbles, kOddBubble, kEvenBubbles};
+extern const std::vector<std::string> KPly3Symbol = {kTokCrossSides, kTokCrossMiddle, kTokCrossSides};
 extern const char kLastMoveMsg[] = "Opponent's "
                                    "last move: ";
 extern const char kTurnMsg1[] = "'s turn";
 extern const int kLastMoveBoardEmpty = -999;
-extern const std::size_t kAtomicUndoCounter = 2;
 extern const char kEndOfGameMsg_1[] = "Quit or Continue "
                                       "(type '";
 extern const char kEndOfGameMsg_2[] = "' or '";
@@ -156,4 +167,43 @@ extern const char kIDPlayerMap[] = "All players "
                                    "std::map "
                                    "current_options_."
                                    "players_.";
+extern const char kScrollLeftCmd = '<';
+extern const char kScrollLeftCmdStr[] = {kScrollLeftCmd, kNullChar};
+extern const char kScrollRightCmd = '>';
+extern const char kScrollRightCmdStr[] = {kScrollRightCmd, kNullChar};
+extern const char kScrollUpCmd = '^';
+extern const char kScrollUpCmdStr[] = {kScrollUpCmd, kNullChar};
+extern const char kScrollDownCmd = 'v';
+extern const char kScrollDownCmdStr[] = {kScrollDownCmd, kNullChar};
+extern const char kInstructionsMsg_8[] = "On large boards, "
+                                         "press '";
+extern const char kInstructionsMsg_9[] = "' to scroll.";
+extern const char kHintCmd = 'h';
+extern const char kHintCmdStr[] = {kHintCmd, kNullChar};
+extern const char kInstructionsMsg_10[] = "During your turn,"
+                                          " press '";
+extern const char kInstructionsMsg_11[] = "' to show or hide"
+                                          " the hints.";
+extern const char kHintMsg[] = "Hint: ";
+extern const char kHintThinkingMsg[] = "thinking...";
+extern const char kHintDepthMsg[] = " depth ";
+extern const char kHintWinMsg[] = "win";
+extern const char kHintLossMsg[] = "loss";
+// milliseconds between two updates of the hint while the user types
+extern const int kHintRefreshDelay = 100;
+extern const char kRowsRangeMsg[] = "Rows ";
+extern const char kColumnsRangeMsg[] = ", columns ";
+extern const char kRangeSeparator[] = "-";
+extern const char kRangeOfMsg[] = " of ";
+// lines of the window used by the header, the footer and the input prompt
+extern const std::size_t kMarginWindowLines = 13;
+extern const std::size_t kMinCustomBoardSize = 3;
+extern const std::size_t kMaxCustomBoardSize = 99;
+extern const char kCustomRowsMsg[] = "Enter the number"
+                                     " of rows";
+extern const char kCustomColumnsMsg[] = "Enter the number"
+                                        " of columns";
+extern const char kCustomConnectedMsg[] = "Enter the number"
+                                          " of chips to "
+                                          "connect";
 }  // namespace Constants
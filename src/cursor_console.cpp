@@ -5,6 +5,7 @@
 //============================================================================
 #include <assert.h>
 #include <curses.h>
+#include <cctype>
 #include <cstring>
 #include <iostream>
 #include <memory>
@@ -27,6 +28,11 @@ void GetCursorPosition(std::pair<int, int>& cursor) {
   getsyx(cursor.second, cursor.first);
 }
 
+// first is the number of columns, second the number of lines.
+void GetWindowSize(std::pair<int, int>& size) {
+  getmaxyx(stdscr, size.second, size.first);
+}
+
 void ClearWindowCurrentLine() {
   clrtoeol();
 }
@@ -64,12 +70,21 @@ void ClearWindowScreen() {
 
 void EnterGameMode() {
   initscr();
+#ifdef PDCURSES
+  // the console is resized on Windows, the terminal size is used otherwise and
+  // large boards are displayed through a viewport.
   resize_term(kWindowLines, kWindowColumns);
+#endif
   scrollok(stdscr, false);
   SetCursorPosition(0, 0);
   RefreshWindow();
 }
 
+// The options are asked on a scrolling window, the board is drawn on a fixed one
+void SetWindowScrolling(bool enabled) {
+  scrollok(stdscr, enabled);
+}
+
 void CloseWindow() {
   endwin();
 }
@@ -107,4 +122,41 @@ void GetCharacter(std::string& input, int n) {
   input = std::string(buffer_input);
 }
 
+// Appends the keys typed within milliseconds (-1 waits for a key) to input, at
+// most n characters, and echoes them. Returns true once the line is entered,
+// the caller can update the window between two calls while the user types.
+bool ReadCharacters(std::string& input, int n, int milliseconds) {
+  assert(n > 0);
+  keypad(stdscr, TRUE);
+  cbreak();
+  noecho();
+  timeout(milliseconds);
+  bool entered = false;
+  int key = getch();
+  while(key != ERR) {
+    if(key == kNewLine || key == '\r' || key == KEY_ENTER) {
+      entered = true;
+      break;
+    }
+    if(key == KEY_BACKSPACE || key == '\b' || key == 127) {
+      if(!input.empty()) {
+        input.erase(input.size() - 1);
+        printw("\b \b");
+      }
+    } else if(key < 256 && isprint(key) &&
+              input.size() < static_cast<std::size_t>(n)) {
+      input += static_cast<char>(key);
+      addch(key);
+    }
+    // the keys already typed are read at once
+    timeout(0);
+    key = getch();
+  }
+  timeout(-1);
+  echo();
+  nocbreak();
+  refresh();
+  return entered;
+}
+
 }  // namespace UI
@@ -0,0 +1,294 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Exact search of the endgames of two players, to the end of
+//               the game.
+//============================================================================
+#include "endgame_solver.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <limits>
+
+namespace Core {
+
+static const std::size_t kEndgameBucketSize = 2;
+// the clock and the stop flag are read once every kEndgameClockNodes nodes
+static const std::size_t kEndgameClockNodes = 1024;
+// weights of the order of the moves
+static const int kEndgameThreatScore = 16;
+static const int kEndgameGiftScore = -1024;
+
+enum EndgameBound : uint8_t {
+  kEndgameExact,
+  kEndgameLower,  // the value is at least the one of the entry
+  kEndgameUpper   // the value is at most the one of the entry
+};
+
+// The number of buckets is the largest power of two that fits
+EndgameSolver::EndgameSolver(std::size_t num_megabytes)
+    : num_cells_(0), num_nodes_(0), max_nodes_(0), has_deadline_(false),
+      stop_(nullptr), aborted_(false) {
+  std::size_t num_buckets = 1;
+  while(num_buckets * 2 * kEndgameBucketSize * sizeof(Entry) <=
+        (num_megabytes << 20)) {
+    num_buckets *= 2;
+  }
+  entries_.reset(new Entry[num_buckets * kEndgameBucketSize]);
+  mask_ = num_buckets - 1;
+  Clear();
+}
+
+void EndgameSolver::Clear() {
+  for(std::size_t i = 0; i < (mask_ + 1) * kEndgameBucketSize; i++) {
+    entries_[i] = Entry{0, 0, kEndgameExact, 0, 0};
+  }
+}
+
+bool EndgameSolver::Probe(uint64_t key, Entry& entry) const {
+  const Entry* bucket = &entries_[(key & mask_) * kEndgameBucketSize];
+  for(std::size_t i = 0; i < kEndgameBucketSize; i++) {
+    if(bucket[i].key_ == key) {
+      entry = bucket[i];
+      return true;
+    }
+  }
+  return false;
+}
+
+// The first entry of a bucket keeps the position with the most empty cells,
+// the second one takes the others
+void EndgameSolver::Store(const Entry& entry) {
+  Entry* bucket = &entries_[(entry.key_ & mask_) * kEndgameBucketSize];
+  if(bucket[0].key_ == entry.key_ ||
+     entry.num_empty_cells_ >= bucket[0].num_empty_cells_) {
+    bucket[0] = entry;
+  } else {
+    bucket[1] = entry;
+  }
+}
+
+// 0 marks the empty entries
+uint64_t EndgameSolver::GetKey(const ModelBoard& board) const {
+  uint64_t key = board.GetHashKey();
+  return key == 0 ? 1 : key;
+}
+
+int EndgameSolver::ScoreMove(ModelBoard& board, const MoveType& move) const {
+  PieceIDType chip = board.GetNextChipId();
+  int score = 0;
+  board.SetMove(move);
+  // the cell above the move becomes playable
+  if(move[0] > 0) {
+    MoveType above = move;
+    above[0]--;
+    if(board.IsWinningMove(above, board.GetNextChipId())) {
+      score += kEndgameGiftScore;
+    }
+  }
+  for(const MoveType& cell : empty_cells_) {
+    if(board.GetPiece(cell) == kEmptyPosition &&
+       board.IsWinningMove(cell, chip)) {
+      score += kEndgameThreatScore;
+    }
+  }
+  board.Undo();
+  const std::vector<std::size_t>& dimensions = board.GetDimensions();
+  for(std::size_t axis = 1; axis < move.size(); axis++) {
+    int distance = 2 * static_cast<int>(move[axis]) -
+                   static_cast<int>(dimensions[axis] - 1);
+    score -= std::abs(distance);
+  }
+  return score;
+}
+
+bool EndgameSolver::GetOrderedMoves(ModelBoard& board, int table_move,
+                                    std::vector<MoveType>& moves,
+                                    std::vector<uint8_t>& order,
+                                    int& value) const {
+  board.GetPossibleMoves(moves);
+  order.clear();
+  PieceIDType chip = board.GetNextChipId();
+  for(std::size_t i = 0; i < moves.size(); i++) {
+    if(board.IsWinningMove(moves[i], chip)) {
+      order.assign(1, static_cast<uint8_t>(i));
+      value = 1;
+      return true;
+    }
+  }
+  const std::vector<PieceIDType>& piece_IDs = board.GetPieceIDs();
+  PieceIDType next_chip = piece_IDs[0] == chip ? piece_IDs[1] : piece_IDs[0];
+  for(std::size_t i = 0; i < moves.size(); i++) {
+    if(board.IsWinningMove(moves[i], next_chip)) {
+      order.push_back(static_cast<uint8_t>(i));
+      if(order.size() > 1) {
+        value = -1;
+        return true;
+      }
+    }
+  }
+  // a single win of the next player is the only move to try
+  if(!order.empty()) {
+    return false;
+  }
+  std::vector<int> scores(moves.size());
+  for(std::size_t i = 0; i < moves.size(); i++) {
+    order.push_back(static_cast<uint8_t>(i));
+    scores[i] = static_cast<int>(i) == table_move
+                    ? std::numeric_limits<int>::max()
+                    : ScoreMove(board, moves[i]);
+  }
+  std::stable_sort(order.begin(), order.end(),
+                   [&scores](uint8_t left, uint8_t right) {
+                     return scores[left] > scores[right];
+                   });
+  return false;
+}
+
+bool EndgameSolver::IsOutOfBudget() {
+  if(aborted_) {
+    return true;
+  }
+  if(max_nodes_ > 0 && num_nodes_ >= max_nodes_) {
+    aborted_ = true;
+  } else if(num_nodes_ % kEndgameClockNodes == 0 &&
+            ((stop_ != nullptr && *stop_) ||
+             (has_deadline_ &&
+              std::chrono::steady_clock::now() >= deadline_))) {
+    aborted_ = true;
+  }
+  return aborted_;
+}
+
+// Fail-soft alpha-beta, the values are -1, 0 and 1 so that a window of
+// (-1, 1) is the whole one
+int EndgameSolver::Search(ModelBoard& board, int alpha, int beta,
+                          uint8_t& best_move) {
+  num_nodes_++;
+  best_move = 0;
+  if(IsOutOfBudget()) {
+    return 0;
+  }
+  uint64_t key = GetKey(board);
+  uint8_t num_empty_cells = static_cast<uint8_t>(std::min<std::size_t>(
+      num_cells_ - board.GetNumPieces(), 255));
+  int table_move = -1;
+  Entry entry;
+  if(Probe(key, entry)) {
+    table_move = entry.move_;
+    if(entry.bound_ == kEndgameExact ||
+       (entry.bound_ == kEndgameLower && entry.value_ >= beta) ||
+       (entry.bound_ == kEndgameUpper && entry.value_ <= alpha)) {
+      best_move = entry.move_;
+      return entry.value_;
+    }
+  }
+  std::vector<MoveType> moves;
+  std::vector<uint8_t> order;
+  int value = 0;
+  if(GetOrderedMoves(board, table_move, moves, order, value)) {
+    best_move = order.front();
+    Store(Entry{key, static_cast<int8_t>(value), kEndgameExact, best_move,
+                num_empty_cells});
+    return value;
+  }
+  int best_value = -2;
+  uint8_t child_move = 0;
+  for(uint8_t index : order) {
+    board.SetMove(moves[index]);
+    // the immediate wins were found, the move can only fill the board
+    value = board.GetCurrentState() == States::Draw
+                ? 0
+                : -Search(board, -beta, -std::max(alpha, best_value),
+                          child_move);
+    board.Undo();
+    if(aborted_) {
+      return 0;
+    }
+    if(value > best_value) {
+      best_value = value;
+      best_move = index;
+      if(best_value >= beta) {
+        break;
+      }
+    }
+  }
+  uint8_t bound = best_value >= beta    ? kEndgameLower
+                  : best_value <= alpha ? kEndgameUpper
+                                        : kEndgameExact;
+  Store(Entry{key, static_cast<int8_t>(best_value), bound, best_move,
+              num_empty_cells});
+  return best_value;
+}
+
+// The best replies are the moves of the table, the line stops early if its
+// positions were replaced
+void EndgameSolver::BuildLine(ModelBoard& board, std::vector<MoveType>& line) {
+  std::vector<MoveType> moves;
+  Entry entry;
+  while(board.GetCurrentState() == States::OnGoing &&
+        Probe(GetKey(board), entry)) {
+    board.GetPossibleMoves(moves);
+    if(entry.move_ >= moves.size()) {
+      break;
+    }
+    line.push_back(moves[entry.move_]);
+    board.SetMove(moves[entry.move_]);
+  }
+}
+
+EndgameResult EndgameSolver::Solve(const ModelBoard& board,
+                                   const EndgameLimits& limits,
+                                   std::vector<MoveType>& line) {
+  line.clear();
+  num_nodes_ = 0;
+  if(board.GetCurrentState() == States::Win) {
+    return EndgameResult::Loss;
+  }
+  if(board.GetCurrentState() == States::Draw) {
+    return EndgameResult::Draw;
+  }
+  assert(board.GetPieceIDs().size() == 2);
+  ModelBoard solve_board(board);
+  // the simulated moves must not be recorded
+  solve_board.SetRecorder(nullptr);
+  const std::vector<std::size_t>& dimensions = solve_board.GetDimensions();
+  num_cells_ = 1;
+  for(std::size_t size : dimensions) {
+    num_cells_ *= size;
+  }
+  empty_cells_.clear();
+  MoveType cell(dimensions.size(), 0);
+  for(std::size_t i = 0; i < num_cells_; i++) {
+    if(solve_board.GetPiece(cell) == kEmptyPosition) {
+      empty_cells_.push_back(cell);
+    }
+    for(std::size_t axis = 0; axis < cell.size(); axis++) {
+      if(++cell[axis] < dimensions[axis]) {
+        break;
+      }
+      cell[axis] = 0;
+    }
+  }
+  max_nodes_ = limits.nodes_;
+  has_deadline_ = limits.time_.count() > 0;
+  deadline_ = std::chrono::steady_clock::now() + limits.time_;
+  stop_ = limits.stop_;
+  aborted_ = false;
+  uint8_t best_move = 0;
+  int value = Search(solve_board, -1, 1, best_move);
+  if(aborted_) {
+    return EndgameResult::Unknown;
+  }
+  std::vector<MoveType> moves;
+  solve_board.GetPossibleMoves(moves);
+  line.push_back(moves[best_move]);
+  solve_board.SetMove(moves[best_move]);
+  BuildLine(solve_board, line);
+  return value > 0   ? EndgameResult::Win
+         : value < 0 ? EndgameResult::Loss
+                     : EndgameResult::Draw;
+}
+
+}  // namespace Core
@@ -0,0 +1,622 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Text protocol, modelled on UCI, to drive the AI.
+//============================================================================
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include "engine.h"
+
+namespace Core {
+
+const long kMaxTableMegabytes = 1 << 16;
+const long kMaxMultiPV = 256;
+const long kMaxEndgameCells = 64;
+
+// FNV-1a of the bytes of the file, 0 if it cannot be read
+static uint64_t GetFileKey(const std::string& path) {
+  std::ifstream input(path, std::ios::binary);
+  if(!input) {
+    return 0;
+  }
+  uint64_t key = 14695981039346656037ULL;
+  for(std::istreambuf_iterator<char> it(input), end; it != end; ++it) {
+    key = (key ^ static_cast<unsigned char>(*it)) * 1099511628211ULL;
+  }
+  return key;
+}
+
+Engine::Engine(std::ostream& output)
+    : output_(output)
+    , dimensions_({6, 7})
+    , num_connected_(kDefaultConnectedFour)
+    , num_players_(2)
+    , table_(new TranspositionTable())
+    , eval_cache_(new EvaluationCache())
+    , proof_search_(new ProofSearch())
+    , endgame_solver_(new EndgameSolver())
+    , table_read_only_(false)
+    , table_saved_(std::chrono::steady_clock::now())
+    , network_key_(0)
+    , multi_player_search_name_(kAutoMultiPlayerSearch)
+    , multi_pv_(1)
+    , endgame_cells_(kDefaultEndgameCells)
+    , infinite_(false) {
+  CreateBoard();
+}
+
+Engine::~Engine() {
+  Stop();
+  SaveTable();
+}
+
+void Engine::CreateBoard() {
+  std::vector<IntelligentBoard::Party> parties;
+  for(uint8_t turn = 1; turn <= num_players_; turn++) {
+    parties.push_back(IntelligentBoard::Party(turn));
+  }
+  board_.reset(new IntelligentBoard(parties, dimensions_, num_connected_));
+  board_->SetSearchControl(&control_);
+  board_->SetTranspositionTable(table_.get());
+  board_->SetEvaluationCache(eval_cache_.get());
+  board_->SetEndgameSolver(endgame_solver_.get());
+  board_->SetEndgameCells(endgame_cells_);
+  MultiPlayerSearch search;
+  if(ParseMultiPlayerSearch(multi_player_search_name_, search)) {
+    board_->SetMultiPlayerSearch(search);
+  }
+  if(network_ && !board_->SetNeuralNetwork(network_)) {
+    Send("info string the network is not made for the variant, the patterns "
+         "evaluate the positions");
+  }
+  // the keys of another variant mean other positions, and the scores of
+  // another network other evaluations
+  ReloadTable();
+  eval_cache_->Clear();
+  proof_search_->Clear();
+  endgame_solver_->Clear();
+  board_->SetInfoCallback([this](const SearchInfo& info) { SendInfo(info); });
+}
+
+bool Engine::Execute(const std::string& command) {
+  std::istringstream arguments(command);
+  std::string name;
+  arguments >> name;
+  if(name.empty()) {
+    return true;
+  } else if(name == "uci") {
+    SendIdentity();
+  } else if(name == "isready") {
+    Send("readyok");
+  } else if(name == "setoption") {
+    Stop();
+    SetOption(arguments);
+  } else if(name == "ucinewgame") {
+    Stop();
+    board_->Reset();
+    ReloadTable();
+    proof_search_->Clear();
+    endgame_solver_->Clear();
+  } else if(name == "position") {
+    Stop();
+    SetUpPosition(arguments);
+  } else if(name == "go") {
+    Stop();
+    Go(arguments);
+  } else if(name == "prove") {
+    Stop();
+    Prove(arguments);
+  } else if(name == "stop") {
+    Stop();
+  } else if(name == "ponderhit") {
+    PonderHit();
+  } else if(name == "d") {
+    Send(SerializePosition(*board_));
+  } else if(name == "quit") {
+    Stop();
+    return false;
+  } else {
+    Send("info string unknown command " + name);
+  }
+  return true;
+}
+
+void Engine::Finish() {
+  {
+    std::lock_guard<std::mutex> lock(search_mutex_);
+    if(infinite_ || control_.pondering_) {
+      control_.stop_ = true;
+      control_.pondering_ = false;
+    }
+  }
+  search_condition_.notify_all();
+  if(search_thread_.joinable()) {
+    search_thread_.join();
+  }
+}
+
+void Engine::SendIdentity() {
+  Send(std::string("id name ") + kEngineName);
+  Send(std::string("id author ") + kEngineAuthor);
+  Send(std::string("option name Variant type string default ") +
+       kDefaultVariant);
+  Send("option name Hash type spin default " +
+       std::to_string(kDefaultTableMegabytes) + " min 1 max " +
+       std::to_string(kMaxTableMegabytes));
+  Send("option name EvalFile type string default <empty>");
+  Send(std::string("option name MultiPlayer type combo default ") +
+       kAutoMultiPlayerSearch + " var " + kAutoMultiPlayerSearch +
+       " var paranoid var maxn var brs");
+  Send("option name MultiPV type spin default 1 min 1 max " +
+       std::to_string(kMaxMultiPV));
+  Send("option name EndgameCells type spin default " +
+       std::to_string(kDefaultEndgameCells) + " min 0 max " +
+       std::to_string(kMaxEndgameCells));
+  Send("option name TableDirectory type string default <empty>");
+  Send("option name TableReadOnly type check default false");
+  Send("uciok");
+}
+
+void Engine::SetOption(std::istringstream& arguments) {
+  std::string word, name, value;
+  arguments >> word;
+  if(word != "name") {
+    Send("info string invalid option");
+    return;
+  }
+  while(arguments >> word && word != "value") {
+    name += (name.empty() ? "" : " ") + word;
+  }
+  std::getline(arguments >> std::ws, value);
+  if(name == "Variant") {
+    if(!SetVariant(value)) {
+      Send("info string invalid variant " + value);
+    }
+  } else if(name == "Hash") {
+    long megabytes = std::atol(value.c_str());
+    if(megabytes < 1 || megabytes > kMaxTableMegabytes) {
+      Send("info string invalid hash size " + value);
+      return;
+    }
+    SaveTable();
+    table_.reset(new TranspositionTable(megabytes));
+    board_->SetTranspositionTable(table_.get());
+    if(!table_directory_.empty()) {
+      table_->Load(GetTableFilePath(), table_shape_);
+    }
+  } else if(name == "MultiPV") {
+    long num_lines = std::atol(value.c_str());
+    if(num_lines < 1 || num_lines > kMaxMultiPV) {
+      Send("info string invalid number of lines " + value);
+      return;
+    }
+    multi_pv_ = static_cast<std::size_t>(num_lines);
+  } else if(name == "EndgameCells") {
+    long num_cells = std::atol(value.c_str());
+    if(num_cells < 0 || num_cells > kMaxEndgameCells) {
+      Send("info string invalid number of cells " + value);
+      return;
+    }
+    endgame_cells_ = static_cast<std::size_t>(num_cells);
+    board_->SetEndgameCells(endgame_cells_);
+  } else if(name == "EvalFile") {
+    SetEvalFile(value);
+  } else if(name == "MultiPlayer") {
+    MultiPlayerSearch search;
+    if(value != kAutoMultiPlayerSearch &&
+       !ParseMultiPlayerSearch(value, search)) {
+      Send("info string invalid multi-player search " + value);
+      return;
+    }
+    multi_player_search_name_ = value;
+    board_->SetMultiPlayerSearch(value == kAutoMultiPlayerSearch ?
+        GetDefaultMultiPlayerSearch(num_players_) : search);
+    // the scores of another search
+    ReloadTable();
+  } else if(name == "TableDirectory") {
+    SaveTable();
+    table_directory_ = value == "<empty>" ? std::string() : value;
+    if(!table_directory_.empty() &&
+       !table_->Load(GetTableFilePath(), table_shape_)) {
+      Send("info string no table file " + GetTableFilePath());
+    }
+  } else if(name == "TableReadOnly") {
+    if(value != "true" && value != "false") {
+      Send("info string invalid value " + value);
+      return;
+    }
+    table_read_only_ = value == "true";
+  } else {
+    Send("info string unknown option " + name);
+  }
+}
+
+void Engine::SetEvalFile(const std::string& path) {
+  if(path.empty() || path == "<empty>") {
+    network_.reset();
+  } else {
+    std::shared_ptr<NeuralNetwork> network(new NeuralNetwork());
+    if(!network->Load(path)) {
+      Send("info string invalid network " + path);
+      return;
+    }
+    network_ = network;
+    network_key_ = GetFileKey(path);
+  }
+  CreateBoard();
+}
+
+bool Engine::SetVariant(const std::string& text) {
+  Position variant;
+  if(!ParseVariant(text, variant)) {
+    return false;
+  }
+  dimensions_ = variant.dimensions_;
+  num_connected_ = variant.num_win_connected_;
+  num_players_ = variant.num_players_;
+  CreateBoard();
+  return true;
+}
+
+void Engine::SetUpPosition(std::istringstream& arguments) {
+  std::string word;
+  arguments >> word;
+  if(word == "startpos") {
+    board_->Reset();
+  } else if(word == "fen") {
+    std::string text;
+    for(int i = 0; i < kPositionNumWords && arguments >> word; i++) {
+      text += word + ' ';
+    }
+    Position position;
+    if(!ParsePosition(text, position)) {
+      Send("info string invalid position " + text);
+      return;
+    }
+    if(position.dimensions_ != dimensions_ ||
+       position.num_win_connected_ != num_connected_ ||
+       position.num_players_ != num_players_) {
+      dimensions_ = position.dimensions_;
+      num_connected_ = position.num_win_connected_;
+      num_players_ = position.num_players_;
+      CreateBoard();
+    }
+    if(!SetPosition(position, *board_)) {
+      Send("info string invalid position " + text);
+      return;
+    }
+  } else {
+    Send("info string invalid position");
+    return;
+  }
+  arguments >> word;
+  if(word != "moves") {
+    return;
+  }
+  ModelBoard::CoMoveType column;
+  while(arguments >> word) {
+    if(board_->GetCurrentState() != States::OnGoing ||
+       !ParseMove(word, dimensions_, column) ||
+       !board_->SetMoveInColumn(column)) {
+      Send("info string illegal move " + word);
+      return;
+    }
+  }
+}
+
+void Engine::Go(std::istringstream& arguments) {
+  SearchLimits limits;
+  bool infinite, ponder;
+  bool has_limit = ParseSearchLimits(arguments, limits, infinite, ponder);
+  limits.multi_pv_ = multi_pv_;
+  control_.stop_ = false;
+  control_.pondering_ = ponder;
+  infinite_ = infinite || !has_limit;
+  search_thread_ = std::thread(&Engine::RunSearch, this, limits);
+}
+
+void Engine::Prove(std::istringstream& arguments) {
+  ProofLimits limits;
+  if(!ParseProofLimits(arguments, limits)) {
+    limits.time_ = std::chrono::milliseconds(kDefaultProofMilliseconds);
+  }
+  std::vector<MoveType> line;
+  auto start = std::chrono::steady_clock::now();
+  ProofStatus status = proof_search_->Solve(*board_, limits, line);
+  auto time = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+  Send(FormatProof(status, proof_search_->GetNumNodes(), time, line));
+}
+
+void Engine::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(search_mutex_);
+    control_.stop_ = true;
+    control_.pondering_ = false;
+  }
+  search_condition_.notify_all();
+  if(search_thread_.joinable()) {
+    search_thread_.join();
+  }
+}
+
+void Engine::PonderHit() {
+  {
+    std::lock_guard<std::mutex> lock(search_mutex_);
+    control_.pondering_ = false;
+  }
+  search_condition_.notify_all();
+}
+
+void Engine::RunSearch(SearchLimits limits) {
+  MoveType best_move;
+  bool has_move = board_->Search(limits, best_move);
+  {
+    // a search ending by itself waits for ponderhit or stop
+    std::unique_lock<std::mutex> lock(search_mutex_);
+    search_condition_.wait(lock, [this] {
+      return control_.stop_ || (!infinite_ && !control_.pondering_);
+    });
+  }
+  Send(FormatBestMove(has_move, best_move, board_->GetPrincipalVariation()));
+  if(std::chrono::steady_clock::now() - table_saved_ >=
+     std::chrono::seconds(kTableFileSaveSeconds)) {
+    SaveTable();
+  }
+}
+
+TableFileShape Engine::GetTableFileShape() const {
+  TableFileShape shape;
+  shape.dimensions_ = dimensions_;
+  shape.num_win_connected_ = num_connected_;
+  shape.num_players_ = num_players_;
+  shape.multi_player_search_ =
+      static_cast<uint32_t>(board_->GetMultiPlayerSearch());
+  shape.evaluation_key_ = board_->GetNeuralNetwork() ? network_key_ : 0;
+  return shape;
+}
+
+std::string Engine::GetTableFilePath() const {
+  return table_directory_ + '/' + GetTableFileName(table_shape_);
+}
+
+void Engine::ReloadTable() {
+  SaveTable();
+  table_->Clear();
+  table_shape_ = GetTableFileShape();
+  if(!table_directory_.empty()) {
+    table_->Load(GetTableFilePath(), table_shape_);
+  }
+}
+
+void Engine::SaveTable() {
+  table_saved_ = std::chrono::steady_clock::now();
+  if(table_directory_.empty() || table_read_only_ ||
+     table_shape_.dimensions_.empty()) {
+    return;
+  }
+  if(!table_->Save(GetTableFilePath(), table_shape_)) {
+    Send("info string cannot save the table file " + GetTableFilePath());
+  }
+}
+
+void Engine::SendInfo(const SearchInfo& info) {
+  Send(FormatInfo(info, *board_));
+}
+
+void Engine::Send(const std::string& line) {
+  std::lock_guard<std::mutex> lock(output_mutex_);
+  output_ << line << std::endl;
+}
+
+bool ParseVariant(const std::string& text, Position& variant) {
+  std::istringstream arguments(text);
+  std::string dimensions_text;
+  long num_connected = 0, num_players = 2;
+  arguments >> dimensions_text >> num_connected;
+  if(!arguments) {
+    return false;
+  }
+  if(!(arguments >> num_players)) {
+    num_players = 2;
+  }
+  std::vector<std::size_t> dimensions;
+  std::istringstream dimensions_stream(dimensions_text);
+  std::string dimension;
+  while(std::getline(dimensions_stream, dimension,
+                     kPositionDimensionSeparator)) {
+    // strtol saturates the numbers which are too large, unlike atol
+    long value = std::strtol(dimension.c_str(), nullptr, 10);
+    if(value <= 0) {
+      return false;
+    }
+    dimensions.push_back(value);
+  }
+  // the same limits as the positions, the board allocates every cell
+  if(!IsValidShape(dimensions) ||
+     num_connected <= kDefaultMinNumConnected || num_connected > UINT8_MAX ||
+     num_players <= kDefaultNumChips || num_players > kEngineMaxPlayers) {
+    return false;
+  }
+  variant.dimensions_ = dimensions;
+  variant.num_win_connected_ = num_connected;
+  variant.num_players_ = num_players;
+  variant.side_to_move_ = 1;
+  variant.cells_.assign(GetNumCells(dimensions), 0);
+  return true;
+}
+
+std::string FormatVariant(const Position& variant) {
+  std::string text;
+  for(std::size_t dimension : variant.dimensions_) {
+    if(!text.empty()) {
+      text += kPositionDimensionSeparator;
+    }
+    text += std::to_string(dimension);
+  }
+  return text + ' ' + std::to_string(variant.num_win_connected_) + ' ' +
+         std::to_string(variant.num_players_);
+}
+
+std::string FormatMove(const ModelBoard::MoveType& move) {
+  std::string text;
+  for(std::size_t i = 1; i < move.size(); i++) {
+    if(i > 1) {
+      text += kMoveCoordinateSeparator;
+    }
+    text += std::to_string(move[i] + 1);
+  }
+  return text;
+}
+
+bool ParseMove(const std::string& text,
+               const std::vector<std::size_t>& dimensions,
+               ModelBoard::CoMoveType& column) {
+  std::istringstream stream(text);
+  std::string coordinate;
+  column.clear();
+  while(std::getline(stream, coordinate, kMoveCoordinateSeparator)) {
+    std::size_t axis = column.size() + 1;
+    long value = std::atol(coordinate.c_str());
+    if(axis >= dimensions.size() || value < 1 ||
+       static_cast<std::size_t>(value) > dimensions[axis]) {
+      return false;
+    }
+    column.push_back(value - 1);
+  }
+  return column.size() == dimensions.size() - 1;
+}
+
+bool ParseSearchLimits(std::istream& arguments,
+                       SearchLimits& limits,
+                       bool& infinite,
+                       bool& ponder) {
+  bool has_limit = false;
+  std::string word;
+  long value;
+  infinite = false;
+  ponder = false;
+  while(arguments >> word) {
+    if(word == "infinite") {
+      infinite = true;
+    } else if(word == "ponder") {
+      ponder = true;
+    } else if(arguments >> value && value > 0) {
+      if(word == "depth") {
+        limits.depth_ = std::min<long>(value, kMaxSearchDepth);
+      } else if(word == "nodes") {
+        limits.nodes_ = value;
+      } else if(word == "movetime") {
+        limits.movetime_ = std::chrono::milliseconds(value);
+      } else {
+        continue;
+      }
+      has_limit = true;
+    } else {
+      arguments.clear();
+    }
+  }
+  return has_limit;
+}
+
+bool ParseProofLimits(std::istream& arguments, ProofLimits& limits) {
+  bool has_limit = false;
+  std::string word;
+  long value;
+  while(arguments >> word) {
+    if(!(arguments >> value) || value <= 0) {
+      arguments.clear();
+      continue;
+    }
+    if(word == "nodes") {
+      limits.nodes_ = value;
+    } else if(word == "movetime") {
+      limits.time_ = std::chrono::milliseconds(value);
+    } else {
+      continue;
+    }
+    has_limit = true;
+  }
+  return has_limit;
+}
+
+std::string FormatProof(ProofStatus status,
+                        std::size_t nodes,
+                        std::chrono::milliseconds time,
+                        const std::vector<ModelBoard::MoveType>& line) {
+  std::ostringstream text;
+  text << "proof "
+       << (status == ProofStatus::Proven
+               ? "win"
+               : (status == ProofStatus::Disproven ? "nowin" : "unknown"))
+       << " nodes " << nodes << " time " << time.count();
+  if(!line.empty()) {
+    text << " pv";
+    for(const ModelBoard::MoveType& move : line) {
+      text << ' ' << FormatMove(move);
+    }
+  }
+  return text.str();
+}
+
+// true if the moves are legal and the last one ends the game with a win
+static bool IsWinningLine(const ModelBoard& board,
+                          const std::vector<ModelBoard::MoveType>& line) {
+  ModelBoard line_board(board);
+  line_board.SetRecorder(nullptr);
+  std::vector<ModelBoard::MoveType> moves;
+  for(const ModelBoard::MoveType& move : line) {
+    line_board.GetPossibleMoves(moves);
+    if(std::find(moves.begin(), moves.end(), move) == moves.end()) {
+      return false;
+    }
+    line_board.SetMove(move);
+  }
+  return line_board.GetCurrentState() == States::Win;
+}
+
+// The distance of a win is only known from a principal variation which
+// reaches it, the scores of the wins do not hold it
+std::string FormatInfo(const SearchInfo& info, const IntelligentBoard& board) {
+  std::ostringstream line;
+  line << "info depth " << static_cast<int>(info.depth_);
+  if(info.multi_pv_ > 0) {
+    line << " multipv " << info.multi_pv_;
+  }
+  line << " score ";
+  if(!board.IsWinScore(info.score_)) {
+    line << "cp " << info.score_;
+  } else if(IsWinningLine(board, info.pv_)) {
+    std::size_t num_players = board.GetPieceIDs().size();
+    long num_moves = (info.pv_.size() + num_players - 1) / num_players;
+    line << "mate " << (info.score_ > 0 ? num_moves : -num_moves);
+  } else {
+    line << "cp " << (info.score_ > 0 ? kWinCentipawns : -kWinCentipawns);
+  }
+  long long time = info.time_.count();
+  line << " nodes " << info.nodes_ << " nps "
+       << info.nodes_ * 1000 / std::max(time, 1LL) << " time " << time
+       << " pv";
+  for(const ModelBoard::MoveType& move : info.pv_) {
+    line << ' ' << FormatMove(move);
+  }
+  return line.str();
+}
+
+std::string FormatBestMove(bool has_move,
+                           const ModelBoard::MoveType& best_move,
+                           const std::vector<ModelBoard::MoveType>& pv) {
+  if(!has_move) {
+    return "bestmove (none)";
+  }
+  std::string line = "bestmove " + FormatMove(best_move);
+  if(pv.size() > 1 && pv.front() == best_move) {
+    line += " ponder " + FormatMove(pv[1]);
+  }
+  return line;
+}
+
+}  // namespace Core
@@ -0,0 +1,447 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Serves the AI to many games over a Unix domain socket.
+//============================================================================
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+#include "engine_server.h"
+
+namespace Core {
+
+const int kListenBacklog = 1024;
+const int kPollTimeoutMs = 100;
+const std::size_t kReceiveSize = 4096;
+// a connection sending a longer line is closed
+const std::size_t kMaxLineSize = 1 << 16;
+
+// The table file of a variant, the positions are evaluated by the patterns
+// and searched by the default search of the number of players
+static TableFileShape GetTableFileShape(const std::string& variant_name) {
+  TableFileShape shape;
+  Position variant;
+  if(!ParseVariant(variant_name, variant)) {
+    return shape;
+  }
+  shape.dimensions_ = variant.dimensions_;
+  shape.num_win_connected_ = variant.num_win_connected_;
+  shape.num_players_ = variant.num_players_;
+  shape.multi_player_search_ = static_cast<uint32_t>(
+      GetDefaultMultiPlayerSearch(variant.num_players_));
+  return shape;
+}
+
+// Removes the pieces of a position
+static void ClearPosition(Position& position) {
+  std::fill(position.cells_.begin(), position.cells_.end(), 0);
+  position.side_to_move_ = 1;
+}
+
+EngineServer::Session::Session(int socket)
+    : socket_(socket), scheduled_(false) {
+  ParseVariant(kDefaultVariant, base_);
+}
+
+EngineServer::Session::~Session() {
+  close(socket_);
+}
+
+EngineServer::EngineServer(const ServerOptions& options)
+    : options_(options), listen_socket_(-1), running_(false),
+      num_variant_uses_(0) {
+}
+
+EngineServer::~EngineServer() {
+  running_ = false;
+  queue_condition_.notify_all();
+  for(std::thread& worker : workers_) {
+    worker.join();
+  }
+  SaveTables();
+  if(listen_socket_ >= 0) {
+    close(listen_socket_);
+    unlink(socket_path_.c_str());
+  }
+}
+
+bool EngineServer::Listen(const std::string& socket_path) {
+  sockaddr_un address;
+  if(socket_path.size() >= sizeof(address.sun_path)) {
+    return false;
+  }
+  std::memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  std::strcpy(address.sun_path, socket_path.c_str());
+  listen_socket_ = socket(AF_UNIX, SOCK_STREAM, 0);
+  if(listen_socket_ < 0) {
+    return false;
+  }
+  unlink(socket_path.c_str());
+  if(bind(listen_socket_, reinterpret_cast<sockaddr*>(&address),
+          sizeof(address)) < 0 ||
+     listen(listen_socket_, kListenBacklog) < 0) {
+    close(listen_socket_);
+    listen_socket_ = -1;
+    return false;
+  }
+  socket_path_ = socket_path;
+  return true;
+}
+
+void EngineServer::Run() {
+  assert(listen_socket_ >= 0);
+  running_ = true;
+  for(std::size_t i = 0; i < std::max<std::size_t>(options_.num_workers_, 1);
+      i++) {
+    workers_.push_back(std::thread(&EngineServer::RunWorker, this));
+  }
+  std::vector<pollfd> sockets;
+  tables_saved_ = std::chrono::steady_clock::now();
+  while(running_) {
+    if(std::chrono::steady_clock::now() - tables_saved_ >=
+       std::chrono::seconds(kTableFileSaveSeconds)) {
+      SaveTables();
+    }
+    sockets.assign(1, {listen_socket_, POLLIN, 0});
+    for(auto& session : sessions_) {
+      sockets.push_back({session.first, POLLIN, 0});
+    }
+    if(poll(sockets.data(), sockets.size(), kPollTimeoutMs) <= 0) {
+      continue;
+    }
+    for(std::size_t i = 1; i < sockets.size(); i++) {
+      if(sockets[i].revents != 0) {
+        auto session = sessions_[sockets[i].fd];
+        if(!Receive(session)) {
+          Close(session);
+        }
+      }
+    }
+    if(sockets[0].revents & POLLIN) {
+      Accept();
+    }
+  }
+  std::lock_guard<std::mutex> lock(queue_mutex_);
+  queue_.clear();
+  sessions_.clear();
+}
+
+void EngineServer::Accept() {
+  int socket = accept(listen_socket_, nullptr, nullptr);
+  if(socket >= 0) {
+    sessions_[socket] = std::make_shared<Session>(socket);
+  }
+}
+
+// The complete lines are queued, returns false if the connection is closed
+bool EngineServer::Receive(const std::shared_ptr<Session>& session) {
+  char buffer[kReceiveSize];
+  ssize_t size = recv(session->socket_, buffer, sizeof(buffer), 0);
+  if(size <= 0) {
+    return false;
+  }
+  session->input_.append(buffer, size);
+  auto now = std::chrono::steady_clock::now();
+  std::size_t start = 0, end;
+  std::lock_guard<std::mutex> lock(queue_mutex_);
+  while((end = session->input_.find('\n', start)) != std::string::npos) {
+    session->commands_.push_back(
+        {session->input_.substr(start, end - start), now});
+    start = end + 1;
+  }
+  session->input_.erase(0, start);
+  if(!session->scheduled_ && !session->commands_.empty()) {
+    session->scheduled_ = true;
+    queue_.push_back(session);
+    queue_condition_.notify_one();
+  }
+  return session->input_.size() <= kMaxLineSize;
+}
+
+// The session is destroyed once the worker executing its command is done
+void EngineServer::Close(const std::shared_ptr<Session>& session) {
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    session->commands_.clear();
+  }
+  sessions_.erase(session->socket_);
+}
+
+void EngineServer::RunWorker() {
+  Boards boards;
+  while(true) {
+    std::shared_ptr<Session> session;
+    Command command;
+    {
+      std::unique_lock<std::mutex> lock(queue_mutex_);
+      queue_condition_.wait(lock,
+                            [this] { return !running_ || !queue_.empty(); });
+      if(!running_) {
+        return;
+      }
+      session = queue_.front();
+      queue_.pop_front();
+      if(session->commands_.empty()) {
+        session->scheduled_ = false;
+        continue;
+      }
+      command = session->commands_.front();
+      session->commands_.pop_front();
+    }
+    Execute(*session, command, boards);
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    if(session->commands_.empty()) {
+      session->scheduled_ = false;
+    } else {
+      queue_.push_back(session);
+      queue_condition_.notify_one();
+    }
+  }
+}
+
+void EngineServer::Execute(Session& session,
+                           const Command& command,
+                           Boards& boards) {
+  std::istringstream arguments(command.line_);
+  std::string name;
+  arguments >> name;
+  if(name.empty()) {
+    return;
+  } else if(name == "isready") {
+    Send(session, "readyok");
+  } else if(name == "setoption") {
+    std::string word, option, value;
+    arguments >> word;
+    if(word == "name") {
+      while(arguments >> word && word != "value") {
+        option += (option.empty() ? "" : " ") + word;
+      }
+    }
+    std::getline(arguments >> std::ws, value);
+    if(option != "Variant" || !ParseVariant(value, session.base_)) {
+      Send(session, "info string invalid option " + command.line_);
+    }
+    session.moves_.clear();
+  } else if(name == "ucinewgame") {
+    ClearPosition(session.base_);
+    session.moves_.clear();
+  } else if(name == "position") {
+    SetUpPosition(session, arguments);
+  } else if(name == "go") {
+    Go(session, command, arguments, boards);
+  } else if(name == "quit") {
+    shutdown(session.socket_, SHUT_RDWR);
+  } else {
+    Send(session, "info string unknown command " + name);
+  }
+}
+
+// The moves are checked by the search
+void EngineServer::SetUpPosition(Session& session,
+                                 std::istringstream& arguments) {
+  std::string word;
+  arguments >> word;
+  session.moves_.clear();
+  if(word == "startpos") {
+    ClearPosition(session.base_);
+  } else if(word == "fen") {
+    std::string text, part;
+    for(int i = 0; i < kPositionNumWords && arguments >> part; i++) {
+      text += part + ' ';
+    }
+    Position position;
+    if(!ParsePosition(text, position)) {
+      Send(session, "info string invalid position " + text);
+      return;
+    }
+    session.base_ = position;
+  } else {
+    Send(session, "info string invalid position");
+    return;
+  }
+  arguments >> word;
+  if(word != "moves") {
+    return;
+  }
+  ModelBoard::CoMoveType column;
+  while(arguments >> word) {
+    if(!ParseMove(word, session.base_.dimensions_, column)) {
+      Send(session, "info string illegal move " + word);
+      return;
+    }
+    session.moves_.push_back(column);
+  }
+}
+
+void EngineServer::Go(Session& session,
+                      const Command& command,
+                      std::istringstream& arguments,
+                      Boards& boards) {
+  SearchLimits limits;
+  bool infinite, ponder;
+  bool has_limit = ParseSearchLimits(arguments, limits, infinite, ponder);
+  std::chrono::milliseconds budget = options_.max_budget_;
+  if(limits.movetime_.count() > 0) {
+    budget = std::min(budget, limits.movetime_);
+  } else if(!has_limit || infinite) {
+    budget = std::min(budget, options_.default_budget_);
+  }
+  auto waited = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - command.received_);
+  limits.movetime_ =
+      std::max(budget - waited, std::chrono::milliseconds(1));
+
+  IntelligentBoard& board = GetBoard(session.base_, boards);
+  bool valid = SetPosition(session.base_, board);
+  for(std::size_t i = 0; valid && i < session.moves_.size(); i++) {
+    valid = board.GetCurrentState() == States::OnGoing &&
+            board.SetMoveInColumn(session.moves_[i]);
+  }
+  if(!valid) {
+    Send(session, "info string illegal position");
+    Send(session, FormatBestMove(false, ModelBoard::MoveType(),
+                                 std::vector<ModelBoard::MoveType>()));
+    return;
+  }
+  SearchInfo last_info = {0, 0, 0, std::chrono::milliseconds(0),
+                          std::vector<ModelBoard::MoveType>(), 0};
+  board.SetInfoCallback(
+      [&last_info](const SearchInfo& info) { last_info = info; });
+  ModelBoard::MoveType best_move;
+  bool has_move = board.Search(limits, best_move);
+  board.SetInfoCallback(nullptr);
+  if(has_move) {
+    Send(session, FormatInfo(last_info, board));
+  }
+  Send(session,
+       FormatBestMove(has_move, best_move, board.GetPrincipalVariation()));
+}
+
+// The boards of the variants freed by the server are freed with them
+IntelligentBoard& EngineServer::GetBoard(const Position& variant,
+                                         Boards& boards) {
+  std::string name = FormatVariant(variant);
+  VariantTables tables = GetVariantTables(name);
+  {
+    std::lock_guard<std::mutex> lock(tables_mutex_);
+    for(auto it = boards.begin(); it != boards.end();) {
+      if(it->first != name && variants_.count(it->first) == 0) {
+        it = boards.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  WorkerBoard& worker_board = boards[name];
+  if(!worker_board.board_) {
+    std::vector<IntelligentBoard::Party> parties;
+    for(uint8_t turn = 1; turn <= variant.num_players_; turn++) {
+      parties.push_back(IntelligentBoard::Party(turn));
+    }
+    worker_board.board_.reset(new IntelligentBoard(
+        parties, variant.dimensions_, variant.num_win_connected_));
+  }
+  // the variant may have been freed and created again since the last search
+  if(worker_board.tables_.table_ != tables.table_) {
+    worker_board.tables_ = tables;
+    worker_board.board_->SetTranspositionTable(tables.table_.get());
+    worker_board.board_->SetEvaluationCache(tables.eval_cache_.get());
+  }
+  return *worker_board.board_;
+}
+
+// The table file is read and written outside of the lock, the other workers
+// keep searching. Two workers may create the tables of a same new variant,
+// the first one stored is kept.
+EngineServer::VariantTables EngineServer::GetVariantTables(
+    const std::string& variant) {
+  {
+    std::lock_guard<std::mutex> lock(tables_mutex_);
+    auto it = variants_.find(variant);
+    if(it != variants_.end()) {
+      it->second.last_used_ = ++num_variant_uses_;
+      return it->second.tables_;
+    }
+  }
+  VariantTables tables;
+  tables.table_ =
+      std::make_shared<TranspositionTable>(options_.table_megabytes_);
+  tables.eval_cache_ = std::make_shared<EvaluationCache>();
+  if(!options_.table_directory_.empty()) {
+    TableFileShape shape = GetTableFileShape(variant);
+    tables.table_->Load(
+        options_.table_directory_ + '/' + GetTableFileName(shape), shape);
+  }
+  std::string freed_variant;
+  VariantTables freed_tables;
+  {
+    std::lock_guard<std::mutex> lock(tables_mutex_);
+    LiveVariant& live_variant = variants_[variant];
+    if(!live_variant.tables_.table_) {
+      live_variant.tables_ = tables;
+    }
+    live_variant.last_used_ = ++num_variant_uses_;
+    tables = live_variant.tables_;
+    if(variants_.size() > std::max<std::size_t>(options_.max_variants_, 1)) {
+      auto oldest = variants_.begin();
+      for(auto it = variants_.begin(); it != variants_.end(); ++it) {
+        if(it->second.last_used_ < oldest->second.last_used_) {
+          oldest = it;
+        }
+      }
+      freed_variant = oldest->first;
+      freed_tables = oldest->second.tables_;
+      variants_.erase(oldest);
+    }
+  }
+  if(freed_tables.table_ && !options_.table_directory_.empty() &&
+     !options_.table_read_only_) {
+    std::lock_guard<std::mutex> lock(save_mutex_);
+    TableFileShape shape = GetTableFileShape(freed_variant);
+    freed_tables.table_->Save(
+        options_.table_directory_ + '/' + GetTableFileName(shape), shape);
+  }
+  return tables;
+}
+
+// The workers keep searching, the entries torn by their stores are not
+// found in the files
+void EngineServer::SaveTables() {
+  tables_saved_ = std::chrono::steady_clock::now();
+  if(options_.table_directory_.empty() || options_.table_read_only_) {
+    return;
+  }
+  std::map<std::string, VariantTables> tables;
+  {
+    std::lock_guard<std::mutex> lock(tables_mutex_);
+    for(const auto& variant : variants_) {
+      tables[variant.first] = variant.second.tables_;
+    }
+  }
+  std::lock_guard<std::mutex> lock(save_mutex_);
+  for(const auto& variant_tables : tables) {
+    TableFileShape shape = GetTableFileShape(variant_tables.first);
+    variant_tables.second.table_->Save(
+        options_.table_directory_ + '/' + GetTableFileName(shape), shape);
+  }
+}
+
+void EngineServer::Send(Session& session, const std::string& line) {
+  std::string data = line + '\n';
+  std::size_t sent = 0;
+  while(sent < data.size()) {
+    ssize_t size = send(session.socket_, data.data() + sent,
+                        data.size() - sent, MSG_NOSIGNAL);
+    if(size <= 0) {
+      return;
+    }
+    sent += size;
+  }
+}
+
+}  // namespace Core
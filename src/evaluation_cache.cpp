@@ -0,0 +1,30 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Static evaluations of the positions shared by concurrent
+//               searches.
+//============================================================================
+#include "evaluation_cache.h"
+
+namespace Core {
+
+// The number of slots is the largest power of two that fits
+EvaluationCache::EvaluationCache(std::size_t num_kilobytes) {
+  std::size_t num_slots = 1;
+  while(num_slots * 2 * sizeof(std::atomic<uint64_t>) <=
+        (num_kilobytes << 10)) {
+    num_slots *= 2;
+  }
+  slots_.reset(new std::atomic<uint64_t>[num_slots]);
+  mask_ = num_slots - 1;
+  Clear();
+}
+
+void EvaluationCache::Clear() {
+  for(std::size_t i = 0; i <= mask_; i++) {
+    slots_[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+}  // namespace Core
@@ -0,0 +1,115 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Pool of memory of a game and the allocator of the containers
+//               of the boards allocating in it.
+//============================================================================
+#include "game_arena.h"
+#include <algorithm>
+#include <cassert>
+
+namespace Core {
+
+static const std::size_t kArenaAlignment = 16;
+static const std::size_t kArenaSmallSize = 256;
+static const std::size_t kArenaLargeSize = 4096;
+// the cells larger than a block get a block of their own
+static const std::size_t kArenaBlockSize = 512;
+// the header of a block keeps the alignment of the cells
+static const std::size_t kArenaBlockHeaderSize = 32;
+
+GameArena::GameArena()
+    : last_block_(nullptr), next_(nullptr), end_(nullptr),
+      num_reserved_bytes_(0), num_used_bytes_(0) {
+  std::fill(free_cells_, free_cells_ + kNumSizeClasses, nullptr);
+  static_assert(sizeof(Block) <= kArenaBlockHeaderSize,
+                "the header of a block is too small");
+}
+
+GameArena::~GameArena() {
+  while(last_block_ != nullptr) {
+    Block* previous = last_block_->previous_;
+    ::operator delete(last_block_);
+    last_block_ = previous;
+  }
+}
+
+// 16 classes of 16 bytes, then 512, 1024, 2048 and 4096 bytes
+std::size_t GameArena::GetSizeClass(std::size_t size) {
+  if(size <= kArenaSmallSize) {
+    return size == 0 ? 0 : (size - 1) / kArenaAlignment;
+  }
+  if(size > kArenaLargeSize) {
+    return kNumSizeClasses;
+  }
+  std::size_t size_class = kArenaSmallSize / kArenaAlignment;
+  for(std::size_t class_size = 2 * kArenaSmallSize; class_size < size;
+      class_size *= 2) {
+    size_class++;
+  }
+  return size_class;
+}
+
+std::size_t GameArena::GetClassSize(std::size_t size_class) {
+  std::size_t num_small_classes = kArenaSmallSize / kArenaAlignment;
+  if(size_class < num_small_classes) {
+    return (size_class + 1) * kArenaAlignment;
+  }
+  return (2 * kArenaSmallSize) << (size_class - num_small_classes);
+}
+
+void GameArena::AddBlock(std::size_t min_size) {
+  std::size_t size = std::max(kArenaBlockSize, min_size);
+  Block* block = static_cast<Block*>(
+      ::operator new(kArenaBlockHeaderSize + size));
+  block->previous_ = last_block_;
+  block->size_ = size;
+  last_block_ = block;
+  next_ = reinterpret_cast<char*>(block) + kArenaBlockHeaderSize;
+  end_ = next_ + size;
+  num_reserved_bytes_ += kArenaBlockHeaderSize + size;
+}
+
+void* GameArena::Allocate(std::size_t size) {
+  std::size_t size_class = GetSizeClass(size);
+  if(size_class == kNumSizeClasses) {
+    num_reserved_bytes_ += size;
+    num_used_bytes_ += size;
+    return ::operator new(size);
+  }
+  std::size_t class_size = GetClassSize(size_class);
+  num_used_bytes_ += class_size;
+  FreeCell* cell = free_cells_[size_class];
+  if(cell != nullptr) {
+    free_cells_[size_class] = cell->next_;
+    return cell;
+  }
+  if(static_cast<std::size_t>(end_ - next_) < class_size) {
+    // the end of the block is lost, it is smaller than the cell
+    AddBlock(class_size);
+  }
+  void* memory = next_;
+  next_ += class_size;
+  return memory;
+}
+
+void GameArena::Deallocate(void* memory, std::size_t size) {
+  if(memory == nullptr) {
+    return;
+  }
+  std::size_t size_class = GetSizeClass(size);
+  if(size_class == kNumSizeClasses) {
+    assert(num_reserved_bytes_ >= size);
+    num_reserved_bytes_ -= size;
+    num_used_bytes_ -= size;
+    ::operator delete(memory);
+    return;
+  }
+  num_used_bytes_ -= GetClassSize(size_class);
+  FreeCell* cell = static_cast<FreeCell*>(memory);
+  cell->next_ = free_cells_[size_class];
+  free_cells_[size_class] = cell;
+}
+
+}  // namespace Core
@@ -0,0 +1,301 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Binary game records, streaming writer and reader.
+//============================================================================
+#include <algorithm>
+#include <cstring>
+#include "game_record.h"
+#include "position_codec.h"
+
+namespace Core {
+
+// Varint of the values which do not fit in 7 bits
+const uint8_t kVarintMoreBit  = 0x80;
+const uint8_t kVarintDataBits = 0x7F;
+const int kVarintMaxShift     = 63;
+
+static uint64_t ZigZagEncode(int value) {
+  return (static_cast<uint64_t>(value) << 1) ^
+         static_cast<uint64_t>(static_cast<int64_t>(value) >> 63);
+}
+
+static int ZigZagDecode(uint64_t value) {
+  return static_cast<int>(static_cast<int64_t>(value >> 1) ^
+                          -static_cast<int64_t>(value & 1));
+}
+
+void WriteVarint(std::ostream& stream, uint64_t value) {
+  char bytes[10];
+  std::size_t size = 0;
+  while(value >= kVarintMoreBit) {
+    bytes[size++] = static_cast<char>((value & kVarintDataBits) | kVarintMoreBit);
+    value >>= 7;
+  }
+  bytes[size++] = static_cast<char>(value);
+  stream.write(bytes, size);
+}
+
+bool ReadVarint(std::streambuf& buffer, uint64_t& value) {
+  value = 0;
+  for(int shift = 0; shift <= kVarintMaxShift; shift += 7) {
+    std::streambuf::int_type byte = buffer.sbumpc();
+    if(byte == std::streambuf::traits_type::eof()) {
+      return false;
+    }
+    value |= static_cast<uint64_t>(byte & kVarintDataBits) << shift;
+    if(!(byte & kVarintMoreBit)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// The first axis is the one of the gravity, the remaining coordinates
+// identify the column. The second axis varies the fastest.
+std::size_t GetColumnIndex(const std::vector<std::size_t>& dimensions,
+                           const ModelBoard::MoveType& move) {
+  std::size_t index = 0, multiplier = 1;
+  for(std::size_t i = 1; i < dimensions.size(); i++) {
+    index += move[i] * multiplier;
+    multiplier *= dimensions[i];
+  }
+  return index;
+}
+
+void GetColumn(const std::vector<std::size_t>& dimensions,
+               std::size_t index,
+               ModelBoard::CoMoveType& column) {
+  column.resize(dimensions.size() - 1);
+  for(std::size_t i = 1; i < dimensions.size(); i++) {
+    column[i - 1] = index % dimensions[i];
+    index /= dimensions[i];
+  }
+}
+
+GameRecordWriter::GameRecordWriter(std::ostream& stream)
+    : stream_(stream)
+    , has_move_info_(false)
+    , game_open_(false)
+    , next_score_(0)
+    , next_think_time_ms_(0) {
+}
+
+GameRecordWriter::~GameRecordWriter() {
+  EndGame();
+}
+
+void GameRecordWriter::BeginGame(const GameRecordHeader& header) {
+  assert(header.dimensions_.size() > kMinNumDimensions);
+  assert(header.player_names_.empty() ||
+         header.player_names_.size() == header.piece_IDs_.size());
+  EndGame();
+  dimensions_ = header.dimensions_;
+  has_move_info_ = header.has_move_info_;
+  stream_.write(kGameRecordMagic, sizeof(kGameRecordMagic));
+  stream_.put(static_cast<char>(kGameRecordVersion));
+  stream_.put(static_cast<char>(has_move_info_ ? kRecordMoveInfo : 0));
+  WriteVarint(stream_, header.variant_.size());
+  stream_.write(header.variant_.data(), header.variant_.size());
+  WriteVarint(stream_, dimensions_.size());
+  for(std::size_t dim : dimensions_) {
+    WriteVarint(stream_, dim);
+  }
+  stream_.put(static_cast<char>(header.num_win_connected_));
+  WriteVarint(stream_, header.piece_IDs_.size());
+  for(std::size_t i = 0; i < header.piece_IDs_.size(); i++) {
+    stream_.put(static_cast<char>(header.piece_IDs_[i]));
+    const std::string name =
+        header.player_names_.empty() ? std::string() : header.player_names_[i];
+    WriteVarint(stream_, name.size());
+    stream_.write(name.data(), name.size());
+  }
+  game_open_ = true;
+}
+
+void GameRecordWriter::EndGame() {
+  if(game_open_) {
+    WriteVarint(stream_, kEndOfGameCode);
+    stream_.flush();
+    game_open_ = false;
+  }
+}
+
+void GameRecordWriter::WriteMove(const ModelBoard::MoveType& move) {
+  if(!game_open_) {
+    return;
+  }
+  WriteVarint(stream_, GetColumnIndex(dimensions_, move) + kFirstColumnCode);
+  if(has_move_info_) {
+    WriteVarint(stream_, ZigZagEncode(next_score_));
+    WriteVarint(stream_, next_think_time_ms_);
+  }
+  next_score_ = 0;
+  next_think_time_ms_ = 0;
+}
+
+void GameRecordWriter::WriteUndo() {
+  if(game_open_) {
+    WriteVarint(stream_, kUndoCode);
+  }
+}
+
+void GameRecordWriter::SetNextMoveInfo(
+    int score,
+    const std::chrono::milliseconds& think_time) {
+  next_score_ = score;
+  next_think_time_ms_ = static_cast<uint32_t>(think_time.count());
+}
+
+GameRecordReader::GameRecordReader(std::istream& stream)
+    : buffer_(*stream.rdbuf())
+    , num_columns_(0)
+    , has_move_info_(false)
+    , game_open_(false)
+    , failed_(false) {
+}
+
+bool GameRecordReader::ReadString(std::string& value) {
+  uint64_t size;
+  if(!ReadVarint(buffer_, size) || size > kMaxRecordStringSize) {
+    return false;
+  }
+  value.resize(size);
+  return size == 0 ||
+         buffer_.sgetn(&value[0], size) == static_cast<std::streamsize>(size);
+}
+
+bool GameRecordReader::ReadHeader(GameRecordHeader& header) {
+  SkipGame();
+  failed_ = false;
+  char magic[sizeof(kGameRecordMagic)];
+  std::streamsize size = buffer_.sgetn(magic, sizeof(magic));
+  if(size == 0) {
+    return false;  // end of the stream
+  }
+  failed_ = true;
+  if(size != sizeof(magic) ||
+     std::memcmp(magic, kGameRecordMagic, sizeof(magic)) != 0 ||
+     buffer_.sbumpc() != kGameRecordVersion) {
+    return false;
+  }
+  std::streambuf::int_type flags = buffer_.sbumpc();
+  uint64_t value;
+  if(flags == std::streambuf::traits_type::eof() ||
+     !ReadString(header.variant_) || !ReadVarint(buffer_, value) ||
+     value <= kMinNumDimensions || value > kMaxPositionDimensions) {
+    return false;
+  }
+  header.has_move_info_ = (flags & kRecordMoveInfo) != 0;
+  header.dimensions_.resize(value);
+  for(std::size_t& dim : header.dimensions_) {
+    if(!ReadVarint(buffer_, value) || value == 0 ||
+       value > kMaxPositionCells) {
+      return false;
+    }
+    dim = value;
+  }
+  std::streambuf::int_type num_connected = buffer_.sbumpc();
+  if(!IsValidShape(header.dimensions_) ||
+     num_connected == std::streambuf::traits_type::eof() ||
+     num_connected <= kDefaultMinNumConnected ||
+     !ReadVarint(buffer_, value) || value <= kDefaultNumChips ||
+     value > kMaxPositionPlayers) {
+    return false;
+  }
+  header.num_win_connected_ = static_cast<uint8_t>(num_connected);
+  header.piece_IDs_.resize(value);
+  header.player_names_.resize(value);
+  for(std::size_t i = 0; i < header.piece_IDs_.size(); i++) {
+    std::streambuf::int_type piece_ID = buffer_.sbumpc();
+    if(piece_ID == std::streambuf::traits_type::eof() ||
+       !ReadString(header.player_names_[i])) {
+      return false;
+    }
+    header.piece_IDs_[i] = static_cast<ModelBoard::PieceIDType>(piece_ID);
+  }
+  // the pieces must be told apart from each other and from the empty cells
+  std::vector<ModelBoard::PieceIDType> piece_IDs = header.piece_IDs_;
+  std::sort(piece_IDs.begin(), piece_IDs.end());
+  if(std::binary_search(piece_IDs.begin(), piece_IDs.end(), kEmptyPosition) ||
+     std::adjacent_find(piece_IDs.begin(), piece_IDs.end()) !=
+         piece_IDs.end()) {
+    return false;
+  }
+  dimensions_ = header.dimensions_;
+  num_columns_ = 1;
+  for(std::size_t i = 1; i < dimensions_.size(); i++) {
+    num_columns_ *= dimensions_[i];
+  }
+  has_move_info_ = header.has_move_info_;
+  game_open_ = true;
+  failed_ = false;
+  return true;
+}
+
+bool GameRecordReader::ReadMove(GameRecordMove& move) {
+  uint64_t code;
+  if(!game_open_) {
+    return false;
+  }
+  if(!ReadVarint(buffer_, code)) {
+    failed_ = true;
+    game_open_ = false;
+    return false;
+  }
+  if(code == kEndOfGameCode) {
+    game_open_ = false;
+    return false;
+  }
+  move.undo_ = code == kUndoCode;
+  move.score_ = 0;
+  move.think_time_ms_ = 0;
+  if(move.undo_) {
+    return true;
+  }
+  move.column_ = code - kFirstColumnCode;
+  if(has_move_info_) {
+    uint64_t score, think_time;
+    if(!ReadVarint(buffer_, score) || !ReadVarint(buffer_, think_time)) {
+      failed_ = true;
+      game_open_ = false;
+      return false;
+    }
+    move.score_ = ZigZagDecode(score);
+    move.think_time_ms_ = static_cast<uint32_t>(think_time);
+  }
+  return true;
+}
+
+bool GameRecordReader::Replay(ModelBoard& board) {
+  assert(board.GetDimensions() == dimensions_);
+  GameRecordMove move;
+  while(ReadMove(move)) {
+    if(move.undo_) {
+      board.Undo();
+      continue;
+    }
+    if(move.column_ >= num_columns_) {
+      failed_ = true;
+      SkipGame();
+      return false;
+    }
+    GetColumn(dimensions_, move.column_, column_);
+    if(board.GetCurrentState() != States::OnGoing ||
+       !board.SetMoveInColumn(column_)) {
+      failed_ = true;
+      SkipGame();
+      return false;
+    }
+  }
+  return !failed_;
+}
+
+void GameRecordReader::SkipGame() {
+  GameRecordMove move;
+  while(ReadMove(move)) {
+  }
+}
+
+}  // namespace Core
@@ -5,25 +5,81 @@
 // Description :
 //============================================================================
 #include "intelligent_board.h"
+#include <mutex>
 #include <random>
+#include "game_record.h"
+#include "position_hash.h"
+#include "score_four_board.h"
+#include "trace.h"
 
 namespace Core {
 
+const char* const kMultiPlayerSearchNames[] = {"paranoid", "maxn", "brs"};
+
+// max-n wins the matches of bench against the two others, even with half
+// of their nodes
+MultiPlayerSearch GetDefaultMultiPlayerSearch(std::size_t num_players) {
+  return num_players > 2 ? MultiPlayerSearch::MaxN :
+                           MultiPlayerSearch::Paranoid;
+}
+
+const char* GetMultiPlayerSearchName(MultiPlayerSearch search) {
+  return kMultiPlayerSearchNames[static_cast<int>(search)];
+}
+
+bool ParseMultiPlayerSearch(const std::string& name,
+                            MultiPlayerSearch& search) {
+  for(int i = 0; i < 3; i++) {
+    if(name == kMultiPlayerSearchNames[i]) {
+      search = static_cast<MultiPlayerSearch>(i);
+      return true;
+    }
+  }
+  return false;
+}
+
 IntelligentBoard::IntelligentBoard(const std::vector<Party>& parties,
                                    const std::vector<std::size_t>& dimensions,
                                    uint8_t num_connected)
     : ModelBoard(std::vector<PieceIDType>(parties.begin(), parties.end()),
                  dimensions,
-                 num_connected) {
+                 num_connected),
+      piece_positions_(std::less<PieceIDType>(),
+                       ArenaAllocator<std::pair<const PieceIDType,
+                                                PositionList> >(arena_)) {
   for(auto it = parties.begin(); it != parties.end(); it++) {
     if(it->depth_ > 0) {
       intelligent_pieces_.insert(std::make_pair(it->chip_id_, it->depth_));
     }
   }
-  std::for_each(piece_IDs_.begin(), piece_IDs_.end(),
-                [this](const PieceIDType& chip) { piece_positions_[chip]; });
-  InitPatterns();
+  std::size_t num_chip_pieces =
+      (board_.capacity() + piece_IDs_.size() - 1) / piece_IDs_.size();
+  for(PieceIDType chip : piece_IDs_) {
+    auto it = piece_positions_.insert(std::make_pair(
+        chip, PositionList(ArenaAllocator<std::size_t>(arena_)))).first;
+    it->second.reserve(num_chip_pieces);
+  }
+  patterns_ = GetPatterns(num_connected);
   thinking_time_ = std::chrono::milliseconds(0);
+  last_score_ = 0;
+  num_evaluations_ = 0;
+  control_ = nullptr;
+  num_nodes_ = 0;
+  max_nodes_ = 0;
+  movetime_ = std::chrono::milliseconds(0);
+  iteration_depth_ = 0;
+  interrupted_ = false;
+  table_ = nullptr;
+  eval_cache_ = nullptr;
+  num_eval_cache_hits_ = 0;
+  num_eval_cache_misses_ = 0;
+  proof_search_ = nullptr;
+  endgame_solver_ = nullptr;
+  endgame_cells_ = kDefaultEndgameCells;
+  multi_player_search_ = GetDefaultMultiPlayerSearch(piece_IDs_.size());
+  maximizing_key_ = 0;
+  score_four_search_ = true;
+  window_evaluator_ = GetWindowEvaluator();
 }
 
 void IntelligentBoard::SetAIDepth(PieceIDType piece_ID, int8_t depth) {
@@ -52,75 +108,347 @@ int8_t IntelligentBoard::GetAIDepth(PieceIDType piece_ID) const {
 
 void IntelligentBoard::SetMoveInc(const MoveType& move) {
   ModelBoard::SetMoveInc(move);
-  piece_positions_[GetCurrentChipId()].push_back(move);
+  piece_positions_[GetCurrentChipId()].push_back(board_.GetOffset(move));
+  if(network_) {
+    accumulator_.AddPiece(*network_, network_->GetCellIndex(move),
+                          GetTurn(GetCurrentChipId()));
+  }
 }
 
 void IntelligentBoard::GetAIPlayerMove(
     MoveType& ai_move,
     const std::chrono::milliseconds& thinking_time) {
+  CONNECTX_TRACE_SCOPE("IntelligentBoard::GetAIPlayerMove");
   DepthType max_depth = intelligent_pieces_[GetNextChipId()];
   assert(max_depth > 0);  // Is it the turn of an AI player?
   std::vector<MoveType> candidates;
   GetPossibleMoves(candidates);
-  IntelligentBoard grid_candidate(*this);
-  std::vector<MoveType> movess;
-  grid_candidate.GetPossibleMoves(movess);
-  EvaluationResult solution;
-  int maxCandidate = 0;
-  num_evaluations_ = 0;
-  prev_best_move_ = -1;
   auto start = std::chrono::steady_clock::now();
-  if(GetHistoryCount() < 2 and max_depth < 5) {
-    maxCandidate = GetMaxCandidate(candidates);
-  } else {
-    solution = IterativeDeepening(grid_candidate, max_depth, thinking_time);
+  if(GetNumPieces() < 2 and max_depth < 5) {
+    num_evaluations_ = 0;
+    last_score_ = 0;
+    ai_move = candidates[GetMaxCandidate(candidates)];
+  } else if(!SolveAIPlayerMove(ai_move, thinking_time / kProofTimeDivisor)) {
+    SearchLimits limits;
+    limits.depth_ = max_depth;
+    limits.soft_time_ = thinking_time;
+    Search(limits, ai_move);
     auto end = std::chrono::steady_clock::now();
     thinking_time_ =
         std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
-    if(solution.best_candidate_ >= 0) {
-      maxCandidate = solution.best_candidate_;
+  }
+}
+
+bool IntelligentBoard::SolveAIPlayerMove(
+    MoveType& ai_move,
+    const std::chrono::milliseconds& proof_time) {
+  if(proof_search_ == nullptr || proof_time.count() <= 0) {
+    return false;
+  }
+  ProofLimits limits;
+  limits.time_ = proof_time;
+  std::vector<MoveType> line;
+  auto start = std::chrono::steady_clock::now();
+  if(proof_search_->Solve(*this, limits, line) != ProofStatus::Proven ||
+     line.empty()) {
+    return false;
+  }
+  ai_move = line.front();
+  num_evaluations_ = 0;
+  num_nodes_ = proof_search_->GetNumNodes();
+  last_score_ = kPlayerWon;
+  principal_variation_ = line;
+  thinking_time_ = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+  return true;
+}
+
+// The solver stops with the search; while pondering it has no deadline, the
+// clock of the search does not run
+bool IntelligentBoard::SolveEndgame(const SearchLimits& limits,
+                                    MoveType& best_move) {
+  std::size_t num_empty_cells = board_.capacity() - GetNumPieces();
+  if(endgame_solver_ == nullptr || limits.multi_pv_ > 1 ||
+     piece_IDs_.size() != 2 || num_empty_cells > endgame_cells_) {
+    return false;
+  }
+  EndgameLimits endgame_limits;
+  endgame_limits.nodes_ = limits.nodes_;
+  if(control_ == nullptr || !control_->pondering_) {
+    endgame_limits.time_ = (limits.movetime_.count() > 0 ? limits.movetime_
+                                                         : limits.soft_time_) /
+                           kEndgameTimeDivisor;
+  }
+  endgame_limits.stop_ = control_ != nullptr ? &control_->stop_ : nullptr;
+  std::vector<MoveType> line;
+  auto start = std::chrono::steady_clock::now();
+  EndgameResult result = endgame_solver_->Solve(*this, endgame_limits, line);
+  if(result == EndgameResult::Unknown) {
+    return false;
+  }
+  best_move = line.front();
+  num_nodes_ = endgame_solver_->GetNumNodes();
+  last_score_ = result == EndgameResult::Win    ? kPlayerWon
+                : result == EndgameResult::Loss ? -kPlayerWon
+                                                : 0;
+  principal_variation_ = line;
+  ranked_moves_.push_back({best_move, last_score_, principal_variation_});
+  if(info_callback_) {
+    DepthType depth = static_cast<DepthType>(std::min<std::size_t>(
+        num_empty_cells, kMaxSearchDepth));
+    info_callback_({depth, last_score_, num_nodes_,
+                    std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::steady_clock::now() - start),
+                    principal_variation_, 0});
+  }
+  return true;
+}
+
+bool IntelligentBoard::Search(const SearchLimits& limits, MoveType& best_move) {
+  CONNECTX_TRACE_SCOPE("IntelligentBoard::Search");
+  std::vector<MoveType> candidates;
+  GetPossibleMoves(candidates);
+  principal_variation_.clear();
+  ranked_moves_.clear();
+  if(GetCurrentState() != States::OnGoing || candidates.empty()) {
+    return false;
+  }
+  num_evaluations_ = 0;
+  num_eval_cache_hits_ = 0;
+  num_eval_cache_misses_ = 0;
+  num_nodes_ = 0;
+  last_score_ = 0;
+  // the search would not tell a win in one move from a later one
+  Threats threats;
+  FindThreats(threats);
+  if(threats.num_wins_ > 0) {
+    best_move = threats.win_;
+    num_nodes_ = 1;
+    last_score_ = kPlayerWon;
+    principal_variation_.assign(1, best_move);
+    ranked_moves_.push_back({best_move, last_score_, principal_variation_});
+    if(info_callback_) {
+      info_callback_({1, last_score_, num_nodes_,
+                      std::chrono::milliseconds(0), principal_variation_, 0});
+    }
+    return true;
+  }
+  // the endgame is solved to the end of the game, the depth does not limit it
+  if(SolveEndgame(limits, best_move)) {
+    return true;
+  }
+  if(score_four_search_ && limits.multi_pv_ <= 1 &&
+     ScoreFourBoard::IsSupported(GetDimensions(), num_win_connected_,
+                                 piece_IDs_.size())) {
+    // the boards which never search do not allocate the table
+    if(!score_four_board_) {
+      score_four_board_ = std::make_shared<ScoreFourBoard>();
+    }
+    if(score_four_board_->SetPosition(*this)) {
+      score_four_board_->Search(limits, control_, info_callback_, best_move);
+      num_nodes_ = score_four_board_->GetNumNodes();
+      num_evaluations_ = score_four_board_->GetNumEvaluations();
+      last_score_ = score_four_board_->GetLastScore();
+      principal_variation_ = score_four_board_->GetPrincipalVariation();
+      ranked_moves_.push_back({best_move, last_score_, principal_variation_});
+      return true;
+    }
+  }
+  IntelligentBoard grid_candidate(*this);
+  // the simulated moves must not be recorded
+  grid_candidate.SetRecorder(nullptr);
+  EvaluationResult solution = IterativeDeepening(grid_candidate, limits);
+  num_eval_cache_hits_ = grid_candidate.num_eval_cache_hits_;
+  num_eval_cache_misses_ = grid_candidate.num_eval_cache_misses_;
+  last_score_ = solution.score_;
+  best_move = candidates[std::max(solution.best_candidate_, 0)];
+  // the other moves lose at once, they only tie with the block when the
+  // position is lost anyway
+  if(threats.num_blocks_ > 0 && best_move != threats.block_) {
+    best_move = threats.block_;
+    principal_variation_.assign(1, best_move);
+    auto it = std::find_if(ranked_moves_.begin(), ranked_moves_.end(),
+                           [&best_move](const RankedMove& ranked_move) {
+                             return ranked_move.move_ == best_move;
+                           });
+    if(it != ranked_moves_.end()) {
+      std::rotate(ranked_moves_.begin(), it, it + 1);
+    } else {
+      ranked_moves_.insert(ranked_moves_.begin(),
+                           {best_move, last_score_, principal_variation_});
     }
   }
-  ai_move = candidates[maxCandidate];
+  return true;
 }
 
 IntelligentBoard::EvaluationResult IntelligentBoard::IterativeDeepening(
     IntelligentBoard& grid_candidate,
-    DepthType depth,
-    const std::chrono::milliseconds& thinking_time) {
-  DepthType l_depth = 0;
-  EvaluationResult solution;
+    const SearchLimits& limits) {
+  // searching deeper than the number of empty cells gives the same result
+  DepthType depth = static_cast<DepthType>(std::min<std::size_t>(
+      limits.depth_, board_.capacity() - GetNumPieces()));
+  EvaluationResult solution = {-1, 0}, iteration;
   prev_best_move_ = -1;
+  max_nodes_ = limits.nodes_;
+  movetime_ = limits.movetime_;
+  interrupted_ = false;
+  pv_table_.assign(depth + 1, std::vector<MoveType>());
+  maxn_scores_.assign(depth + 2, std::vector<int>(piece_IDs_.size(), 0));
+  // a cell two past the last one
+  maximizing_key_ = PositionHasher::GetCellKey(
+      board_.capacity() + 1,
+      std::find(piece_IDs_.begin(), piece_IDs_.end(), GetNextChipId()) -
+          piece_IDs_.begin() + 1);
+  // the scores of the best reply search are not the paranoid ones
+  if(IsBestReplySearch()) {
+    maximizing_key_ ^= PositionHasher::GetCellKey(board_.capacity() + 2, 1);
+  }
+  // the lines of a multi-PV search are searched one after the other, each
+  // without the moves of the lines before it, with the whole window so that
+  // their scores are exact. They share the table and the evaluation cache.
+  std::vector<MoveType> root_moves;
+  grid_candidate.GetPossibleMoves(root_moves);
+  std::size_t num_lines = IsMaxNSearch() ? 1 : std::max<std::size_t>(
+      1, std::min(limits.multi_pv_, root_moves.size()));
+  // index in root_moves of the move of every line of the last iteration
+  std::vector<int> best_candidates, line_candidates;
+  std::vector<RankedMove> lines;
+  std::vector<std::size_t> order;
   auto start = std::chrono::steady_clock::now();
-  for(; l_depth < depth; ++l_depth) {
-    solution = FindMove(grid_candidate, l_depth + 1, -kPlayerWon, kPlayerWon,
-                        GetNextChipId());
-
-    if(l_depth > 0) {
-      if(solution.best_candidate_ == 0) {
-        solution.best_candidate_ = prev_best_move_;
-      } else if(solution.best_candidate_ == prev_best_move_) {
-        solution.best_candidate_ = 0;
+  clock_start_ = start;
+  for(iteration_depth_ = 1; iteration_depth_ <= depth; ++iteration_depth_) {
+    CONNECTX_TRACE_SCOPE_ARG("IterativeDeepening", "depth", iteration_depth_);
+    lines.clear();
+    line_candidates.clear();
+    excluded_root_moves_.clear();
+    for(std::size_t line = 0; line < num_lines; line++) {
+      // the move of the line in the last iteration is tried first
+      int hint = line < best_candidates.size() ? best_candidates[line] : -1;
+      if(hint > -1 && std::find(excluded_root_moves_.begin(),
+                                excluded_root_moves_.end(),
+                                root_moves[hint]) !=
+                          excluded_root_moves_.end()) {
+        hint = -1;
+      }
+      prev_best_move_ = hint;
+      if(IsMaxNSearch()) {
+        int best_candidate =
+            FindMaxNMove(grid_candidate, iteration_depth_, 0);
+        iteration = {best_candidate, GetMaxNScore(maxn_scores_[0])};
+      } else {
+        iteration = FindMove(grid_candidate, iteration_depth_, -kPlayerWon,
+                             kPlayerWon, GetNextChipId());
       }
+      if(interrupted_) {
+        break;
+      }
+      // the hint was swapped with the first move
+      int candidate = iteration.best_candidate_;
+      if(hint > -1 && candidate == 0) {
+        candidate = hint;
+      } else if(hint > -1 && candidate == hint) {
+        candidate = 0;
+      }
+      std::vector<MoveType> pv = pv_table_[0];
+      // all the moves left lose, the first one is ranked
+      if(candidate < 0) {
+        candidate = 0;
+        while(std::find(excluded_root_moves_.begin(),
+                        excluded_root_moves_.end(), root_moves[candidate]) !=
+              excluded_root_moves_.end()) {
+          candidate++;
+        }
+        pv.assign(1, root_moves[candidate]);
+      }
+      lines.push_back({root_moves[candidate], iteration.score_, pv});
+      line_candidates.push_back(candidate);
+      excluded_root_moves_.push_back(root_moves[candidate]);
+    }
+    excluded_root_moves_.clear();
+    if(interrupted_) {
+      break;
+    }
+    // a line may find more than the one before it in the table
+    order.resize(lines.size());
+    for(std::size_t line = 0; line < lines.size(); line++) {
+      order[line] = line;
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [&lines](std::size_t left, std::size_t right) {
+                       return lines[left].score_ > lines[right].score_;
+                     });
+    ranked_moves_.clear();
+    best_candidates.clear();
+    for(std::size_t line : order) {
+      ranked_moves_.push_back(lines[line]);
+      best_candidates.push_back(line_candidates[line]);
     }
+    solution = {best_candidates[0], ranked_moves_[0].score_};
+    principal_variation_ = ranked_moves_[0].pv_;
     auto end = std::chrono::steady_clock::now();
-    if(std::chrono::duration_cast<std::chrono::milliseconds>(end - start) >=
-       thinking_time) {
+    if(info_callback_) {
+      for(std::size_t line = 0; line < ranked_moves_.size(); line++) {
+        info_callback_({iteration_depth_, ranked_moves_[line].score_,
+                        num_nodes_,
+                        std::chrono::duration_cast<std::chrono::milliseconds>(
+                            end - start),
+                        ranked_moves_[line].pv_,
+                        num_lines > 1 ? line + 1 : 0});
+      }
+    }
+    if(limits.soft_time_.count() > 0 &&
+       std::chrono::duration_cast<std::chrono::milliseconds>(end - start) >=
+           limits.soft_time_) {
+      break;
+    }
+    // a win or a loss is certain for every line
+    if(std::all_of(ranked_moves_.begin(), ranked_moves_.end(),
+                   [this](const RankedMove& ranked_move) {
+                     return IsWinScore(ranked_move.score_);
+                   })) {
       break;
     }
-    prev_best_move_ = solution.best_candidate_;
   }
-
   return solution;
 }
 
+bool IntelligentBoard::IsSearchInterrupted() {
+  const std::size_t kCheckMask = 0x3FF;
+  // the first iteration always completes to have a move to play
+  if(interrupted_ || iteration_depth_ <= 1) {
+    return interrupted_;
+  }
+  if(max_nodes_ > 0 && num_nodes_ >= max_nodes_) {
+    interrupted_ = true;
+  } else if((num_nodes_ & kCheckMask) == 0) {
+    auto now = std::chrono::steady_clock::now();
+    if(control_ != nullptr) {
+      interrupted_ = control_->stop_;
+      if(control_->pondering_) {
+        clock_start_ = now;
+      }
+    }
+    if(movetime_.count() > 0 && now - clock_start_ >= movetime_) {
+      interrupted_ = true;
+    }
+  }
+  return interrupted_;
+}
+
 IntelligentBoard::EvaluationResult IntelligentBoard::FindMove(
     IntelligentBoard& grid_candidate,
     DepthType depth,
     int alpha,
     int beta,
     PieceIDType maximizing_chip) {
-  int best_score, best_candidate = -1, score, last_move_index;
+  int best_score, best_candidate = -1, score,
+      last_move_index = prev_best_move_;
+  std::size_t ply = iteration_depth_ - depth;
+  pv_table_[ply].clear();
+  num_nodes_++;
+  if(IsSearchInterrupted()) {
+    return {-1, 0};
+  }
   if(grid_candidate.GetCurrentState() == States::Win) {
     score = kPlayerWon;
     if(grid_candidate.GetCurrentChipId() != maximizing_chip) {
@@ -131,80 +459,427 @@ IntelligentBoard::EvaluationResult IntelligentBoard::FindMove(
     return {-1, 0};
   }
 
+  // the best reply search alternates the moves of the maximizing player and
+  // the ones of any of the opponents, whoever's turn it is
+  bool best_reply = IsBestReplySearch();
+  bool maximizing = best_reply ? ply % 2 == 0 :
+                                 grid_candidate.GetNextChipId() == maximizing_chip;
+  // the immediate wins decide the node, the root still needs its candidate
+  Threats threats;
+  if(best_reply) {
+    threats.num_wins_ = 0;
+    threats.num_blocks_ = 0;
+    for(PieceIDType chip : piece_IDs_) {
+      if(ply > 0 && (chip == maximizing_chip) == maximizing &&
+         grid_candidate.HasWinningMove(chip)) {
+        return {-1, GetWinScore(chip, maximizing_chip)};
+      }
+    }
+  } else {
+    grid_candidate.FindThreats(threats);
+    if(ply > 0 && threats.num_wins_ > 0) {
+      return {-1,
+              GetWinScore(grid_candidate.GetNextChipId(), maximizing_chip)};
+    } else if(ply > 0 && threats.num_blocks_ > 1) {
+      return {-1, GetWinScore(threats.block_chip_, maximizing_chip)};
+    }
+  }
+
   if(depth == 0) {
     score = grid_candidate.EvaluateGrid(maximizing_chip);
     num_evaluations_++;
     return {-1, score};
   }
 
-  if(grid_candidate.GetNextChipId() == maximizing_chip) {
-    best_score = -kPlayerWon;
-    std::vector<MoveType> moves;
+  uint64_t key = 0;
+  TableEntry entry;
+  bool has_entry = false;
+  const int alpha_start = alpha, beta_start = beta;
+  if(table_ != nullptr) {
+    key = grid_candidate.GetHashKey() ^ maximizing_key_;
+    if(best_reply && !maximizing) {
+      key ^= PositionHasher::GetCellKey(board_.capacity() + 2, 2);
+    }
+    has_entry = table_->Probe(key, entry);
+    // the root needs its best candidate
+    if(has_entry && ply > 0 && entry.depth_ >= depth &&
+       (entry.bound_ == Bound::Exact ||
+        (entry.bound_ == Bound::Lower && entry.score_ >= beta) ||
+        (entry.bound_ == Bound::Upper && entry.score_ <= alpha))) {
+      return {-1, entry.score_};
+    }
+  }
+  std::vector<MoveType> moves;
+  // the player of every move, the opponents of the best reply search play
+  // out of turn
+  std::vector<PieceIDType> move_chips;
+  PieceIDType next_chip = grid_candidate.GetNextChipId();
+  // with more than 2 players, an opponent may leave the win to the next one
+  if(ply > 0 && threats.num_blocks_ == 1 &&
+     (piece_IDs_.size() == 2 ||
+      grid_candidate.GetNextChipId() == maximizing_chip ||
+      threats.block_chip_ == maximizing_chip)) {
+    moves.assign(1, threats.block_);
+  } else {
     grid_candidate.GetPossibleMoves(moves);
-    last_move_index = prev_best_move_;
+  }
+  if(best_reply && maximizing) {
+    move_chips.assign(moves.size(), maximizing_chip);
+  } else if(best_reply) {
+    std::vector<MoveType> cells;
+    cells.swap(moves);
+    for(PieceIDType chip : piece_IDs_) {
+      if(chip != maximizing_chip) {
+        moves.insert(moves.end(), cells.begin(), cells.end());
+        move_chips.insert(move_chips.end(), cells.size(), chip);
+      }
+    }
+  }
+  // the best move of the table is tried first, the root uses the best move
+  // of the previous iteration
+  if(has_entry && ply > 0 && entry.move_ != kNoTableMove) {
+    for(std::size_t candID = 1; candID < moves.size(); candID++) {
+      if(GetColumnIndex(board_.GetDimensions(), moves[candID]) ==
+         entry.move_) {
+        std::swap(moves[0], moves[candID]);
+        if(best_reply) {
+          std::swap(move_chips[0], move_chips[candID]);
+        }
+        break;
+      }
+    }
+  }
+
+  EvaluationResult result;
+  if(maximizing) {
+    best_score = -kPlayerWon;
     if(prev_best_move_ > -1) {
       std::swap(moves[0], moves[prev_best_move_]);
       prev_best_move_ = -1;
     }
-    for(std::size_t candID = 0; candID < moves.size(); candID++) {
-      grid_candidate.SetMoveInc(moves[candID]);
-      score = FindMove(grid_candidate, depth - 1, alpha, beta, maximizing_chip)
-                  .score_;
-      grid_candidate.Undo();
-      if(score > best_score) {
-        best_score = score;
-        best_candidate = candID;
-        alpha = std::max(alpha, best_score);
-        if(best_score == kPlayerWon) {
-          break;
-        }
+  } else {
+    best_score = kPlayerWon;
+  }
+  for(std::size_t candID = 0; candID < moves.size(); candID++) {
+    if(ply == 0 && std::find(excluded_root_moves_.begin(),
+                             excluded_root_moves_.end(), moves[candID]) !=
+                       excluded_root_moves_.end()) {
+      continue;
+    }
+    if(best_reply) {
+      grid_candidate.SetNextChipId(move_chips[candID]);
+    }
+    grid_candidate.SetMoveInc(moves[candID]);
+    score = FindMove(grid_candidate, depth - 1, alpha, beta, maximizing_chip)
+                .score_;
+    grid_candidate.Undo();
+    if(best_reply) {
+      grid_candidate.SetNextChipId(next_chip);
+    }
+    if(maximizing && score > best_score) {
+      best_score = score;
+      best_candidate = candID;
+      UpdatePrincipalVariation(ply, moves[candID]);
+      alpha = std::max(alpha, best_score);
+      if(best_score == kPlayerWon) {
+        break;
       }
-      if(beta <= alpha) {
+    } else if(!maximizing && score < best_score) {
+      best_score = score;
+      best_candidate = candID;
+      UpdatePrincipalVariation(ply, moves[candID]);
+      beta = std::min(beta, best_score);
+      if(best_score == -kPlayerWon) {
         break;
       }
     }
+    if(beta <= alpha) {
+      break;
+    }
+  }
+  if(maximizing) {
     prev_best_move_ = last_move_index;
-    return {best_candidate, best_score};
+  }
+  result = {best_candidate, best_score};
+  // the score of a root without some of its moves is not the one of the
+  // position
+  if(table_ != nullptr && !interrupted_ &&
+     (ply > 0 || excluded_root_moves_.empty())) {
+    entry.score_ = best_score;
+    entry.depth_ = depth;
+    if(IsWinScore(best_score)) {
+      entry.bound_ = Bound::Exact;
+    } else if(best_score >= beta_start) {
+      entry.bound_ = Bound::Lower;
+    } else if(best_score <= alpha_start) {
+      entry.bound_ = Bound::Upper;
+    } else {
+      entry.bound_ = Bound::Exact;
+    }
+    entry.move_ = best_candidate < 0 ?
+                      kNoTableMove :
+                      static_cast<uint16_t>(GetColumnIndex(
+                          board_.GetDimensions(), moves[best_candidate]));
+    table_->Store(key, entry);
+  }
+  return result;
+}
+
+int IntelligentBoard::FindMaxNMove(IntelligentBoard& grid_candidate,
+                                   DepthType depth,
+                                   int parent_bound) {
+  std::size_t ply = iteration_depth_ - depth;
+  std::vector<int>& scores = maxn_scores_[ply];
+  pv_table_[ply].clear();
+  num_nodes_++;
+  if(IsSearchInterrupted()) {
+    return -1;
+  }
+  if(grid_candidate.GetCurrentState() != States::OnGoing) {
+    bool won = grid_candidate.GetCurrentState() == States::Win;
+    std::size_t winner = GetTurn(grid_candidate.GetCurrentChipId());
+    for(std::size_t turn = 0; turn < scores.size(); turn++) {
+      scores[turn] = won ? (turn == winner ? kMaxNScoreSum : 0) :
+                           kMaxNScoreSum / static_cast<int>(scores.size());
+    }
+    return -1;
+  }
+  PieceIDType next_chip = grid_candidate.GetNextChipId();
+  Threats threats;
+  grid_candidate.FindThreats(threats);
+  if(ply > 0 && (threats.num_wins_ > 0 || threats.num_blocks_ > 1)) {
+    std::size_t winner =
+        GetTurn(threats.num_wins_ > 0 ? next_chip : threats.block_chip_);
+    std::fill(scores.begin(), scores.end(), 0);
+    scores[winner] = kMaxNScoreSum;
+    return -1;
+  }
+  if(depth == 0) {
+    grid_candidate.EvaluateMaxN(scores);
+    num_evaluations_ += scores.size();
+    return -1;
+  }
+
+  // the player who lets the next one win gets nothing, blocking is not worse
+  std::vector<MoveType> moves;
+  if(ply > 0 && threats.num_blocks_ == 1) {
+    moves.assign(1, threats.block_);
   } else {
-    best_score = kPlayerWon;
-    std::vector<MoveType> moves;
     grid_candidate.GetPossibleMoves(moves);
-    for(std::size_t candID = 0; candID < moves.size(); candID++) {
-      grid_candidate.SetMoveInc(moves[candID]);
-      score = FindMove(grid_candidate, depth - 1, alpha, beta, maximizing_chip)
-                  .score_;
-      grid_candidate.Undo();
-      if(score < best_score) {
-        best_score = score;
-        best_candidate = candID;
-        beta = std::min(beta, best_score);
-        if(best_score == -kPlayerWon) {
-          break;
-        }
-      }
-      if(beta <= alpha) {
-        break;
-      }
+  }
+  int last_move_index = prev_best_move_;
+  if(prev_best_move_ > -1) {
+    std::swap(moves[0], moves[prev_best_move_]);
+    prev_best_move_ = -1;
+  }
+  std::size_t turn = GetTurn(next_chip);
+  int best_candidate = -1;
+  const std::vector<int>& child_scores = maxn_scores_[ply + 1];
+  for(std::size_t candID = 0; candID < moves.size(); candID++) {
+    grid_candidate.SetMoveInc(moves[candID]);
+    FindMaxNMove(grid_candidate, depth - 1,
+                 best_candidate < 0 ? 0 : scores[turn]);
+    grid_candidate.Undo();
+    if(interrupted_) {
+      break;
     }
-    return {best_candidate, best_score};
+    if(best_candidate < 0 || child_scores[turn] > scores[turn]) {
+      scores = child_scores;
+      best_candidate = candID;
+      UpdatePrincipalVariation(ply, moves[candID]);
+    }
+    // the player of the parent gets at most what is left, which is no more
+    // than the share it already has elsewhere
+    if(scores[turn] >= kMaxNScoreSum - parent_bound) {
+      break;
+    }
+  }
+  prev_best_move_ = last_move_index;
+  return best_candidate;
+}
+
+// The score of a player seen from every player is shifted to be positive,
+// the shares are in proportion and a leaf never gives all of the sum
+void IntelligentBoard::EvaluateMaxN(std::vector<int>& scores) {
+  std::vector<long long> values(piece_IDs_.size());
+  for(std::size_t turn = 0; turn < piece_IDs_.size(); turn++) {
+    values[turn] = EvaluateGrid(piece_IDs_[turn]);
+  }
+  long long min_value = *std::min_element(values.begin(), values.end());
+  long long sum = 0;
+  for(long long& value : values) {
+    value -= min_value - 1;
+    sum += value;
+  }
+  for(std::size_t turn = 0; turn < piece_IDs_.size(); turn++) {
+    scores[turn] = static_cast<int>(values[turn] * (kMaxNScoreSum - 1) / sum);
+  }
+}
+
+// The share of the player to move around the even share, in thousandths of
+// the sum
+int IntelligentBoard::GetMaxNScore(const std::vector<int>& scores) const {
+  std::size_t turn = GetTurn(GetNextChipId());
+  if(scores[turn] == kMaxNScoreSum) {
+    return kPlayerWon;
+  } else if(std::find(scores.begin(), scores.end(), kMaxNScoreSum) !=
+            scores.end()) {
+    return -kPlayerWon;
   }
-  return {1, 1};
+  return static_cast<int>(
+      (static_cast<long long>(scores[turn]) * scores.size() - kMaxNScoreSum) *
+      kPlayerMaxScore / kMaxNScoreSum);
+}
+
+bool IntelligentBoard::HasWinningMove(PieceIDType chip) const {
+  MoveType cell(board_.GetDimensions().size());
+  for(const auto& column : possible_moves_) {
+    cell[0] = column.second;
+    std::copy(column.first.begin(), column.first.end(), cell.begin() + 1);
+    if(IsWinningMove(cell, chip)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void IntelligentBoard::FindThreats(Threats& threats) const {
+  threats.num_wins_ = 0;
+  threats.num_blocks_ = 0;
+  PieceIDType next_chip = GetNextChipId();
+  threats.block_chip_ =
+      piece_IDs_[(GetTurn(next_chip) + 1) % piece_IDs_.size()];
+  MoveType cell(board_.GetDimensions().size());
+  for(const auto& column : possible_moves_) {
+    cell[0] = column.second;
+    std::copy(column.first.begin(), column.first.end(), cell.begin() + 1);
+    if(IsWinningMove(cell, next_chip)) {
+      threats.num_wins_++;
+      threats.win_ = cell;
+      return;
+    }
+    if(threats.num_blocks_ < 2 && IsWinningMove(cell, threats.block_chip_)) {
+      threats.num_blocks_++;
+      threats.block_ = cell;
+    }
+  }
+}
+
+void IntelligentBoard::UpdatePrincipalVariation(std::size_t ply,
+                                                const MoveType& move) {
+  pv_table_[ply].assign(1, move);
+  pv_table_[ply].insert(pv_table_[ply].end(), pv_table_[ply + 1].begin(),
+                        pv_table_[ply + 1].end());
 }
 
 void IntelligentBoard::Reset() {
   ModelBoard::Reset();
-  piece_positions_.clear();
+  for(auto& positions : piece_positions_) {
+    positions.second.clear();
+  }
+  if(network_) {
+    accumulator_.Reset(*network_);
+  }
+}
+
+// The positions of the pieces used by the evaluation are rebuilt from the cells
+bool IntelligentBoard::SetPosition(const std::vector<PieceIDType>& cells,
+                                   PieceIDType next_chip) {
+  bool result = ModelBoard::SetPosition(cells, next_chip);
+  for(auto& positions : piece_positions_) {
+    positions.second.clear();
+  }
+  MoveType position(board_.GetDimensions().size(), 0);
+  do {
+    if(board_[position] != kEmptyPosition) {
+      piece_positions_[board_[position]].push_back(board_.GetOffset(position));
+    }
+  } while(NextCoordinates(board_.GetDimensions(), position));
+  RefreshAccumulator();
+  return result;
+}
+
+bool IntelligentBoard::SetNeuralNetwork(
+    const std::shared_ptr<const NeuralNetwork>& network) {
+  if(network &&
+     !network->HasShape(GetDimensions(), num_win_connected_,
+                        piece_IDs_.size())) {
+    return false;
+  }
+  network_ = network;
+  RefreshAccumulator();
+  return true;
+}
+
+void IntelligentBoard::RefreshAccumulator() {
+  if(!network_) {
+    return;
+  }
+  accumulator_.Reset(*network_);
+  for(const auto& positions : piece_positions_) {
+    std::size_t turn = GetTurn(positions.first);
+    for(std::size_t offset : positions.second) {
+      accumulator_.AddPiece(
+          *network_, network_->GetCellIndex(board_.GetPosition(offset)), turn);
+    }
+  }
+}
+
+std::size_t IntelligentBoard::GetTurn(PieceIDType chip) const {
+  return std::find(piece_IDs_.begin(), piece_IDs_.end(), chip) -
+         piece_IDs_.begin();
 }
 
 void IntelligentBoard::Undo() {
+  if(GetHistoryCount() == 0) {
+    return;
+  }
   ModelBoard::Undo();
   auto it = piece_positions_.find(GetNextChipId());
   if(piece_positions_.end() != it) {
+    if(network_) {
+      accumulator_.RemovePiece(
+          *network_,
+          network_->GetCellIndex(board_.GetPosition(it->second.back())),
+          GetTurn(GetNextChipId()));
+    }
     it->second.pop_back();
   }
 }
 
+// The maximizing chip is keyed like a piece in a cell past the one of the
+// player to move
 int IntelligentBoard::EvaluateGrid(PieceIDType maximizing_chip) {
+  if(eval_cache_ == nullptr) {
+    return EvaluateCells(maximizing_chip);
+  }
+  uint64_t key = GetHashKey() ^
+                 PositionHasher::GetCellKey(board_.capacity() + 1,
+                                            GetTurn(maximizing_chip) + 1);
+  int score;
+  if(eval_cache_->Probe(key, score)) {
+    num_eval_cache_hits_++;
+    return score;
+  }
+  num_eval_cache_misses_++;
+  score = EvaluateCells(maximizing_chip);
+  eval_cache_->Store(key, score);
+  return score;
+}
+
+int IntelligentBoard::EvaluateCells(PieceIDType maximizing_chip) {
+  if(network_) {
+    return accumulator_.Evaluate(*network_, GetTurn(maximizing_chip),
+                                 GetTurn(GetNextChipId()));
+  }
+  if(window_evaluator_) {
+    return window_evaluator_->Evaluate(board_.data(), maximizing_chip,
+                                       GetNextChipId(), window_scratch_);
+  }
+  return EvaluatePatterns(maximizing_chip);
+}
+
+int IntelligentBoard::EvaluatePatterns(PieceIDType maximizing_chip) {
   int final_score =
       EvalPieceType(piece_positions_[maximizing_chip], maximizing_chip);
   auto mit = piece_positions_.begin();
@@ -219,11 +894,16 @@ int IntelligentBoard::EvaluateGrid(PieceIDType maximizing_chip) {
   return final_score;
 }
 
-int IntelligentBoard::EvalPieceType(const std::list<MoveType>& moves,
+int IntelligentBoard::EvalPieceType(const PositionList& offsets,
                                     PieceIDType chip_evaluated) {
   const std::list<DirectionType>& ref_directions = GetDirections();
   auto it_dir = ref_directions.begin();
-  std::list<MoveType>::const_iterator it_pos;
+  std::vector<MoveType> moves;
+  moves.reserve(offsets.size());
+  for(std::size_t offset : offsets) {
+    moves.push_back(board_.GetPosition(offset));
+  }
+  std::vector<MoveType>::const_iterator it_pos;
   MultiDimArray<PieceIDType> visiting_grid(board_.GetDimensions());
   int score = 0;
   while(it_dir != ref_directions.end()) {
@@ -299,8 +979,8 @@ int Core::IntelligentBoard::ExploreConnectedPieces(
 }
 
 bool IntelligentBoard::CheckPattern(const std::string& curr_pattern) {
-  auto it = patterns_.begin();
-  while(it != patterns_.end()) {
+  auto it = patterns_->begin();
+  while(it != patterns_->end()) {
     if(curr_pattern.size() >= (*it).size() &&
        curr_pattern.find(*it) != std::string::npos) {
       return true;
@@ -313,33 +993,65 @@ bool IntelligentBoard::CheckPattern(const std::string& curr_pattern) {
 int IntelligentBoard::GetMaxCandidate(const std::vector<MoveType>& candidates) {
   static std::random_device rd;
   static std::mt19937 mt(rd());
-  static std::uniform_int_distribution<int> distribution(0, candidates.size());
+  std::uniform_int_distribution<int> distribution(0, candidates.size() - 1);
   return distribution(mt);
 }
 
-void Core::IntelligentBoard::InitPatterns() {
+std::shared_ptr<const WindowEvaluator>
+IntelligentBoard::GetWindowEvaluator() const {
+  typedef std::pair<std::vector<std::size_t>,
+                    std::pair<uint8_t, std::vector<PieceIDType> > > Key;
+  static std::mutex evaluators_mutex;
+  static std::map<Key, std::shared_ptr<const WindowEvaluator> > evaluators;
+  if(!WindowEvaluator::IsSupported(GetDimensions(), num_win_connected_)) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(evaluators_mutex);
+  std::shared_ptr<const WindowEvaluator>& evaluator = evaluators[Key(
+      GetDimensions(), std::make_pair(num_win_connected_, piece_IDs_))];
+  if(!evaluator) {
+    evaluator = std::make_shared<WindowEvaluator>(
+        GetDimensions(), GetDirections(), num_win_connected_, piece_IDs_,
+        kPlayerMaxScore, kPlayerMidScore);
+  }
+  return evaluator;
+}
+
+std::shared_ptr<const std::list<std::string> > IntelligentBoard::GetPatterns(
+    uint8_t num_win_connected) {
+  static std::mutex patterns_mutex;
+  static std::map<uint8_t, std::shared_ptr<std::list<std::string> > >
+      all_patterns;
+  std::lock_guard<std::mutex> lock(patterns_mutex);
+  std::shared_ptr<std::list<std::string> >& patterns =
+      all_patterns[num_win_connected];
+  if(patterns) {
+    return patterns;
+  }
+  patterns = std::make_shared<std::list<std::string> >();
   std::string temp;
-  std::string range_1(num_win_connected_ - 1, kOccupiedPlace);
-  std::string range_2(num_win_connected_ - 2, kOccupiedPlace);
+  std::string range_1(num_win_connected - 1, kOccupiedPlace);
+  std::string range_2(num_win_connected - 2, kOccupiedPlace);
 
   temp += kEmptyPlace;
   temp += range_1;
   temp += kEmptyPlace;
-  patterns_.push_back(temp);
+  patterns->push_back(temp);
 
   temp = kOccupiedPlace;
   temp += kEmptyPlace;
   temp += range_2;
   temp += kEmptyPlace;
   temp += kOccupiedPlace;
-  patterns_.push_back(temp);
+  patterns->push_back(temp);
 
   temp = range_2;
   temp += kEmptyPlace;
   temp += kOccupiedPlace;
   temp += kEmptyPlace;
   temp += range_2;
-  patterns_.push_back(temp);
+  patterns->push_back(temp);
+  return patterns;
 }
 
 }  // namespace Core
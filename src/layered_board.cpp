@@ -0,0 +1,52 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : LayeredBoard draws a 3D board as its vertical planes side by
+//               side.
+//============================================================================
+#include "layered_board.h"
+
+namespace UI {
+LayeredBoard::LayeredBoard(const std::map<int8_t, TextPiece>& chips,
+                           const std::vector<std::size_t>& dimensions,
+                           const std::string& line_indent)
+    : ConnectXBoard(chips, GetGridDimensions(dimensions), line_indent),
+      layer_dimensions_(dimensions) {
+  RenderViewport();
+}
+
+// The planes and the columns separating them
+std::vector<std::size_t> LayeredBoard::GetGridDimensions(
+    const std::vector<std::size_t>& dimensions) {
+  assert(dimensions.size() == kNumLayerDimensions);
+  return {dimensions[0], dimensions[1] * (dimensions[2] + 1) - 1};
+}
+
+std::vector<std::size_t> LayeredBoard::GetGridPosition(
+    const std::vector<std::size_t>& position) const {
+  assert(position.size() == kNumLayerDimensions);
+  return {position[0], position[1] * (layer_dimensions_[2] + 1) + position[2]};
+}
+
+std::size_t LayeredBoard::GetColumnLabel(std::size_t column) const {
+  if(IsSeparator(column)) {
+    return 0;
+  }
+  std::size_t width = layer_dimensions_[2] + 1;
+  return column / width * layer_dimensions_[2] + column % width + 1;
+}
+
+// The separators have no border at the bottom
+void LayeredBoard::PrintLine(std::size_t cline) {
+  const std::string& cell_string =
+      cline < h_cell_size_ - 1 ? empty_cell_string_ : lower_cell_string_;
+  for(std::size_t k = 0; k < view_size_[kSecondAxis]; k++) {
+    board_stream_ << kVerticalLine
+                  << (IsSeparator(view_origin_[kSecondAxis] + k)
+                          ? empty_cell_string_
+                          : cell_string);
+  }
+  board_stream_ << kVerticalLine << std::endl;
+}
+}  // namespace UI
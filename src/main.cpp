@@ -6,9 +6,15 @@
 //============================================================================
 #include "connect_four.h"
 #include <cstdlib>
+#include "trace.h"
 
-int main() {
+// An optional argument is the file where the games are recorded
+int main(int argc, char* argv[]) {
   ConnectFour game;
+  if(argc > 1) {
+    game.SetRecordFile(argv[1]);
+  }
   game.Play();
+  CONNECTX_TRACE_WRITE();
   return EXIT_SUCCESS;
 }
@@ -4,6 +4,7 @@
 // Copyright   : Copyright (c) 2019, Franck Nassé. All rights reserved.
 // Description : MarginBoard prints the header and footer of the board
 //============================================================================
+#include <cstdlib>
 #include <iostream>
 #include <map>
 #include "constants.h"
@@ -24,7 +25,8 @@ MarginBoard::MarginBoard(const GameOptions& options,
     , width_(width)
     , level_names_(level_names)
     , chips_(chips)
-    , dimensions_(dimensions) {
+    , dimensions_(dimensions)
+    , hint_line_(-1) {
 }
 
 MarginBoard::~MarginBoard() {
@@ -35,37 +37,58 @@ void MarginBoard::DrawHeader() {
   UI::WriteToWindow(header_btm_stream_);
 }
 
+// Spaces between count items of total width spread over width, the
+// remainder goes to the last space
+static std::vector<std::size_t> GetSpaces(std::size_t width,
+                                          std::size_t total,
+                                          std::size_t count) {
+  std::size_t free_width = width > total ? width - total : 0;
+  std::vector<std::size_t> spaces(count - 1, free_width / (count - 1));
+  spaces.back() += free_width % (count - 1);
+  return spaces;
+}
+
 // Prints the header of the board.
-// prints the players' names on both sides.
+// prints the players' names from the left side to the right side.
 void MarginBoard::PrintTopHeader() {
   header_top_stream_.str(kEmptyNullStr);
-  std::string smiddle(
-      std::max<int>(
-          0, width_ - 2 * chips_[kFirstPlayerChipId].GetSymbol()[0].size()),
-      kEmptyChar);
-  std::map<int8_t, Player>::const_iterator it_player1 =
-      options_.players_.find(kFirstPlayerChipId);
-  auto it_player2 = options_.players_.find(kFirstPlayerChipId + 1);
+  std::size_t const num_players = options_.players_.size();
+  std::size_t const symbol_width =
+      chips_[kFirstPlayerChipId].GetSymbol()[0].size();
+  std::vector<std::size_t> symbol_spaces =
+      GetSpaces(width_, num_players * symbol_width, num_players);
 
   std::size_t const num_rows = chips_[kFirstPlayerChipId].GetSymbol().size();
   for(std::size_t j = 0; j < num_rows; j++) {
-    header_top_stream_ << kIndentScreen
-                       << chips_[kFirstPlayerChipId].GetSymbol()[j] << smiddle
-                       << chips_[kFirstPlayerChipId + 1].GetSymbol()[j]
-                       << std::endl;
+    header_top_stream_ << kIndentScreen;
+    std::size_t i = 0;
+    for(auto& ID_chip : chips_) {
+      if(i > 0) {
+        header_top_stream_ << std::string(symbol_spaces[i - 1], kEmptyChar);
+      }
+      header_top_stream_ << ID_chip.second.GetSymbol()[j];
+      i++;
+    }
+    header_top_stream_ << std::endl;
   }
   header_top_stream_ << std::endl;
-  std::string smiddlename(
-      std::max<int>(
-          0, dimensions_[k2ndDim] *
-                     (chips_[kFirstPlayerChipId].GetSymbol()[0].size() + 1) -
-                 (it_player1->second.GetName().size() +
-                  it_player2->second.GetName().size())),
-      kEmptyChar);
-
-  header_top_stream_ << kIndentScreen << kEmptyChar
-                     << it_player1->second.GetName() << smiddlename
-                     << it_player2->second.GetName();
+  // width_ is the width of the viewport which can be smaller than the board
+  std::size_t names_width = 0;
+  for(const auto& ID_player : options_.players_) {
+    names_width += ID_player.second.GetName().size();
+  }
+  std::vector<std::size_t> name_spaces =
+      GetSpaces(std::max<int>(0, width_ - 2), names_width, num_players);
+
+  header_top_stream_ << kIndentScreen << kEmptyChar;
+  std::size_t i = 0;
+  for(const auto& ID_player : options_.players_) {
+    if(i > 0) {
+      header_top_stream_ << std::string(name_spaces[i - 1], kEmptyChar);
+    }
+    header_top_stream_ << ID_player.second.GetName();
+    i++;
+  }
 }
 
 // Prints the footer of the board
@@ -80,14 +103,17 @@ void MarginBoard::PrintBtmHeader() {
     temp_str.resize(std::max<int>(0, (board_width - temp_msg.size()) / 2),
                     kEmptyChar);
     header_btm_stream_ << kIndentScreen << temp_str << temp_msg;
-  } else if(kPlayerModeEnum[options_.player_mode_] == kTwoAIPlayers) {
-    std::map<int8_t, int8_t>::const_iterator it_depth_player1 =
-        options_.simulation_depths_.find(kFirstPlayerChipId);
-    auto it_depth_player2 =
-        options_.simulation_depths_.find(kFirstPlayerChipId + 1);
+  } else if(kPlayerModeEnum[options_.player_mode_] == kTwoAIPlayers ||
+            kPlayerModeEnum[options_.player_mode_] == kThreeAIPlayers) {
     std::stringstream ss;
-    ss << kDepthsAIMsg1 << static_cast<int>(it_depth_player1->second)
-       << kDepthsAIMsg2 << static_cast<int>(it_depth_player2->second);
+    ss << kDepthsAIMsg1;
+    for(auto it_depth = options_.simulation_depths_.begin();
+        it_depth != options_.simulation_depths_.end(); ++it_depth) {
+      if(it_depth != options_.simulation_depths_.begin()) {
+        ss << kDepthsAIMsg2;
+      }
+      ss << static_cast<int>(it_depth->second);
+    }
     temp_msg = ss.str();
     temp_str.resize(std::max<int>(0, (board_width - temp_msg.size()) / 2),
                     kEmptyChar);
@@ -130,6 +156,63 @@ void MarginBoard::PrintFooter(int8_t current_piece,
 
 void MarginBoard::DrawFooter() {
   UI::WriteToWindow(footer_stream_);
+  std::pair<int, int> cursor;
+  UI::GetCursorPosition(cursor);
+  hint_line_ = cursor.second;
+  UI::WriteToWindow(hint_);
+  UI::GotoNextWindowLine();
+}
+
+void MarginBoard::PrintHint() {
+  hint_ = kIndentScreen + kHintMsg + kHintThinkingMsg;
+}
+
+// Half of the bar on each side of the middle, a score of kHintBarScale
+// fills half of the half
+static const int kHintBarHalfWidth = 10;
+static const int kHintBarScale = 200;
+
+void MarginBoard::PrintHint(std::size_t column,
+                            int depth,
+                            int score,
+                            bool win_score) {
+  long long magnitude = std::llabs(score);
+  int num_filled =
+      win_score ? kHintBarHalfWidth :
+                  static_cast<int>((kHintBarHalfWidth * magnitude +
+                                    (magnitude + kHintBarScale) / 2) /
+                                   (magnitude + kHintBarScale));
+  std::string bar(2 * kHintBarHalfWidth + 1, '.');
+  bar[kHintBarHalfWidth] = '|';
+  for(int i = 1; i <= num_filled; i++) {
+    bar[score > 0 ? kHintBarHalfWidth + i : kHintBarHalfWidth - i] = '#';
+  }
+  std::stringstream stemp;
+  stemp << kIndentScreen << kHintMsg << column + 1 << " [" << bar << "] ";
+  if(win_score) {
+    stemp << (score > 0 ? kHintWinMsg : kHintLossMsg);
+  } else {
+    stemp << (score > 0 ? "+" : "") << score;
+  }
+  stemp << kHintDepthMsg << depth;
+  hint_ = stemp.str();
+}
+
+void MarginBoard::ClearHint() {
+  hint_.clear();
+}
+
+void MarginBoard::DrawHint() {
+  if(hint_line_ < 0) {
+    return;
+  }
+  std::pair<int, int> cursor;
+  UI::GetCursorPosition(cursor);
+  UI::SetCursorPosition(0, hint_line_);
+  UI::ClearWindowCurrentLine();
+  UI::WriteToWindow(hint_);
+  UI::SetCursorPosition(cursor.first, cursor.second);
+  UI::RefreshWindow();
 }
 
 }  // namespace UI
\ No newline at end of file
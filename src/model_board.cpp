@@ -4,15 +4,12 @@
 // Copyright   : Copyright (c) 2016, Franck Nassé. All rights reserved.
 // Description :
 //============================================================================
-#include <cmath>
-#include <queue>
+#include "game_record.h"
 #include "model_board.h"
+#include "position_hash.h"
 
 namespace Core {
 
-const std::array<int, ModelBoard::kNumPossibleMovements>
-    ModelBoard::kAllMovements = {1, 0, -1};
-
 ModelBoard::MoveType operator+(const ModelBoard::MoveType& move_left,
                                const ModelBoard::DirectionType& move_right) {
   assert(move_left.size() == move_right.size());
@@ -49,11 +46,20 @@ ModelBoard::DirectionType operator*(const ModelBoard::DirectionType& move_left,
 ModelBoard::ModelBoard(std::vector<PieceIDType> piece_IDs,
                        const std::vector<std::size_t>& dimensions,
                        uint8_t num_connected)
-    : board_(dimensions)
+    : arena_(std::make_shared<GameArena>())
+    , board_(dimensions)
     , num_win_connected_(num_connected)
+    , possible_moves_(PossibleMovesType::key_compare(),
+                      PossibleMovesType::allocator_type(arena_))
     , piece_IDs_(piece_IDs)
     , current_state_(States::OnGoing)
-    , current_chip_index_(0) {
+    , current_chip_index_(0)
+    , num_pieces_(0)
+    , cells_key_(0)
+    , history_moves_(ArenaAllocator<std::size_t>(arena_))
+    , winning_moves_(ArenaAllocator<std::size_t>(arena_))
+    , geometry_(BoardGeometry::Get(dimensions))
+    , recorder_(nullptr) {
   assert(piece_IDs.size() > kDefaultNumChips);
   assert(dimensions.size() > kMinNumDimensions);
   assert(std::find(piece_IDs_.begin(), piece_IDs_.end(), kEmptyPosition) ==
@@ -62,11 +68,10 @@ ModelBoard::ModelBoard(std::vector<PieceIDType> piece_IDs,
   assert(std::unique(piece_IDs.begin(), piece_IDs.end()) == piece_IDs.end());
   assert(num_connected > kDefaultMinNumConnected);
   board_.Fill(kEmptyPosition);
-  GeneratePossibleInitialMoves();
-  DirectionType direction(dimensions.size(), 0);
-  std::size_t num_directions_limit =
-      (std::pow(kNumPossibleMovements, direction.size()) - 1) / 2;
-  GenerateDirections(num_directions_limit, direction, 0, dimensions.size());
+  // the history never grows, the arena keeps no freed buffer of it
+  history_moves_.reserve(board_.capacity());
+  possible_moves_.insert(geometry_->GetInitialMoves().begin(),
+                         geometry_->GetInitialMoves().end());
 }
 
 void ModelBoard::SetMove(const MoveType& move) {
@@ -79,12 +84,29 @@ void ModelBoard::SetMove(const MoveType& move) {
   SetMoveInc(move);
 }
 
+bool ModelBoard::SetMoveInColumn(const CoMoveType& column) {
+  auto it = possible_moves_.find(column);
+  if(it == possible_moves_.end() || current_state_ != States::OnGoing) {
+    return false;
+  }
+  MoveType move(column.size() + 1);
+  move[0] = it->second;
+  std::copy(column.begin(), column.end(), move.begin() + 1);
+  SetMoveInc(move);
+  return true;
+}
+
 void ModelBoard::SetMoveInc(const MoveType& move) {
   board_[move] = GetNextChipId();
-  history_moves_.push(move);
+  history_moves_.push_back(board_.GetOffset(move));
+  num_pieces_++;
+  cells_key_ ^= GetCellKey(move, current_chip_index_);
+  if(recorder_ != nullptr) {
+    recorder_->WriteMove(move);
+  }
   if(CheckConnected(move)) {
     current_state_ = States::Win;
-  } else if(history_moves_.size() == board_.capacity()) {
+  } else if(num_pieces_ == board_.capacity()) {
     current_state_ = States::Draw;
   } else {
     current_state_ = States::OnGoing;
@@ -115,10 +137,16 @@ void ModelBoard::Undo() {
   if(history_moves_.empty()) {
     return;
   }
-  board_[history_moves_.top()] = kEmptyPosition;
-  UpdatePossibleMoves(history_moves_.top(), true);
-  history_moves_.pop();
+  if(recorder_ != nullptr) {
+    recorder_->WriteUndo();
+  }
+  MoveType move = board_.GetPosition(history_moves_.back());
+  history_moves_.pop_back();
+  board_[move] = kEmptyPosition;
+  UpdatePossibleMoves(move, true);
+  num_pieces_--;
   current_chip_index_ = GetIndexCurrentChip();
+  cells_key_ ^= GetCellKey(move, current_chip_index_);
   winning_moves_.clear();
   current_state_ = States::OnGoing;
 }
@@ -131,10 +159,112 @@ void ModelBoard::Undo() {
 void ModelBoard::Reset() {
   board_.Fill(kEmptyPosition);
   current_chip_index_ = 0;
+  num_pieces_ = 0;
+  cells_key_ = 0;
   current_state_ = States::OnGoing;
   winning_moves_.clear();
-  ClearMoveHistory();
-  GeneratePossibleInitialMoves();
+  history_moves_.clear();
+  possible_moves_.clear();
+  possible_moves_.insert(geometry_->GetInitialMoves().begin(),
+                         geometry_->GetInitialMoves().end());
+}
+
+bool ModelBoard::NextCoordinates(const std::vector<std::size_t>& dimensions,
+                                 MoveType& position) {
+  for(std::size_t axis = dimensions.size(); axis-- > 0;) {
+    if(++position[axis] < dimensions[axis]) {
+      return true;
+    }
+    position[axis] = 0;
+  }
+  return false;
+}
+
+/**
+ * @brief The cells are copied, then the top of each column gives the possible
+ * moves. The state is computed by looking for connected pieces from every
+ * piece on the board.
+ */
+bool ModelBoard::SetPosition(const std::vector<PieceIDType>& cells,
+                             PieceIDType next_chip) {
+  auto next_it = std::find(piece_IDs_.begin(), piece_IDs_.end(), next_chip);
+  if(cells.size() != board_.capacity() || next_it == piece_IDs_.end()) {
+    return false;
+  }
+  Reset();
+  MoveType position(board_.GetDimensions().size(), 0);
+  auto cell_it = cells.begin();
+  do {
+    PieceIDType piece_ID = *cell_it++;
+    if(piece_ID == kEmptyPosition) {
+      continue;
+    }
+    auto piece_it = std::find(piece_IDs_.begin(), piece_IDs_.end(), piece_ID);
+    if(piece_it == piece_IDs_.end()) {
+      Reset();
+      return false;
+    }
+    board_[position] = piece_ID;
+    num_pieces_++;
+    cells_key_ ^= GetCellKey(position, piece_it - piece_IDs_.begin());
+  } while(NextCoordinates(board_.GetDimensions(), position));
+
+  // the lowest empty cell of each column, all the cells above must be empty
+  for(auto it = possible_moves_.begin(); it != possible_moves_.end();) {
+    position[0] = board_.GetDimensionSize(0);
+    std::copy(it->first.begin(), it->first.end(), position.begin() + 1);
+    bool full = true;
+    while(position[0]-- > 0) {
+      if(board_[position] == kEmptyPosition) {
+        it->second = position[0];
+        full = false;
+        break;
+      }
+    }
+    while(!full && position[0]-- > 0) {
+      if(board_[position] != kEmptyPosition) {
+        Reset();
+        return false;
+      }
+    }
+    it = full ? possible_moves_.erase(it) : std::next(it);
+  }
+
+  current_chip_index_ = next_it - piece_IDs_.begin();
+  std::fill(position.begin(), position.end(), 0);
+  do {
+    if(board_[position] != kEmptyPosition && CheckConnected(position)) {
+      current_state_ = States::Win;
+      return true;
+    }
+  } while(NextCoordinates(board_.GetDimensions(), position));
+  winning_moves_.clear();
+  if(num_pieces_ == board_.capacity()) {
+    current_state_ = States::Draw;
+  }
+  return true;
+}
+
+// The key of the player to move is the one of a cell past the last one
+uint64_t ModelBoard::GetHashKey() const {
+  return cells_key_ ^
+         PositionHasher::GetCellKey(board_.capacity(), current_chip_index_ + 1);
+}
+
+uint64_t ModelBoard::GetCellKey(const MoveType& move,
+                                std::size_t chip_index) const {
+  const std::vector<std::size_t>& strides = geometry_->GetStrides();
+  std::size_t offset = 0;
+  for(std::size_t i = 0; i < move.size(); i++) {
+    offset += move[i] * strides[i];
+  }
+  return PositionHasher::GetCellKey(offset, chip_index + 1);
+}
+
+void ModelBoard::SetNextChipId(PieceIDType chip) {
+  auto it = std::find(piece_IDs_.begin(), piece_IDs_.end(), chip);
+  assert(it != piece_IDs_.end());
+  current_chip_index_ = it - piece_IDs_.begin();
 }
 
 ModelBoard::PieceIDType ModelBoard::GetCurrentChipId() const {
@@ -170,7 +300,7 @@ bool ModelBoard::ExploreMove(const DirectionType& direction,
       move = move + direction;
       if(board_[move] == lookup_chip) {
         counter++;
-        winning_moves_.push_back(move);
+        winning_moves_.push_back(board_.GetOffset(move));
         continue;
       }
     }
@@ -179,76 +309,61 @@ bool ModelBoard::ExploreMove(const DirectionType& direction,
   return counter == num_win_connected_;
 }
 
+// The cells are read through their offsets, the coordinates of the move
+// bound the number of steps in each direction
+bool ModelBoard::IsWinningMove(const MoveType& move, PieceIDType chip) const {
+  const PieceIDType* cells = board_.data();
+  const SSizeT offset = board_.GetOffset(move);
+  auto offset_it = geometry_->GetDirectionOffsets().begin();
+  for(const DirectionType& direction : geometry_->GetDirections()) {
+    const SSizeT direction_offset = *offset_it++;
+    SSizeT num_connected = 1;
+    for(SSizeT sign = 1; sign >= -1; sign -= 2) {
+      SSizeT max_steps = num_win_connected_ - num_connected;
+      for(std::size_t axis = 0; axis < move.size(); axis++) {
+        SSizeT step = sign * direction[axis];
+        SSizeT position = static_cast<SSizeT>(move[axis]);
+        if(step > 0) {
+          max_steps = std::min(
+              max_steps,
+              static_cast<SSizeT>(board_.GetDimensionSize(axis)) - 1 -
+                  position);
+        } else if(step < 0) {
+          max_steps = std::min(max_steps, position);
+        }
+      }
+      for(SSizeT steps = 1;
+          steps <= max_steps &&
+          cells[offset + sign * steps * direction_offset] == chip;
+          steps++) {
+        num_connected++;
+      }
+    }
+    if(num_connected >= num_win_connected_) {
+      return true;
+    }
+  }
+  return false;
+}
+
 bool ModelBoard::CheckConnected(const MoveType& move) {
   DirectionType vect_dir;
-  for(DirectionType& cur_dir : directions_) {
+  for(const DirectionType& cur_dir : geometry_->GetDirections()) {
     winning_moves_.clear();
     int8_t num_connected_chips = 1;
     if(ExploreMove(cur_dir, move, num_connected_chips, board_[move])) {
-      winning_moves_.push_back(move);
+      winning_moves_.push_back(board_.GetOffset(move));
       break;
     }
     vect_dir = cur_dir * -1;
     if(ExploreMove(vect_dir, move, num_connected_chips, board_[move])) {
-      winning_moves_.push_back(move);
+      winning_moves_.push_back(board_.GetOffset(move));
       break;
     }
   }
   return winning_moves_.size() >= num_win_connected_;
 }
 
-bool ModelBoard::GenerateDirections(std::size_t num_directions_limit,
-                                    DirectionType& current_direction,
-                                    std::size_t pos,
-                                    std::size_t depth) {
-  bool stop = false;
-  if(directions_.size() >= num_directions_limit) {
-    stop = true;
-  } else if(depth == 0) {
-    directions_.push_back(current_direction);
-    stop = false;
-  } else {
-    for(auto cur_increment : kAllMovements) {
-      current_direction[pos] = cur_increment;
-      if(GenerateDirections(num_directions_limit, current_direction, pos + 1,
-                            depth - 1)) {
-        stop = true;
-        break;
-      }
-    }
-  }
-  return stop;
-}
-
-struct NodePossibleMove {
-  ModelBoard::CoMoveType possible_move_;
-  std::size_t current_dim_;
-};
-
-void ModelBoard::GeneratePossibleInitialMoves() {
-  std::queue<NodePossibleMove> nodes;
-  nodes.emplace(NodePossibleMove({{}, 0}));
-  NodePossibleMove curNode, childNode;
-  possible_moves_.clear();
-
-  while(!nodes.empty()) {
-    curNode = nodes.front();
-    if(curNode.current_dim_ == board_.GetDimensions().size() - 1) {
-      possible_moves_.insert(std::make_pair(curNode.possible_move_,
-                                            board_.GetDimensionSize(0) - 1));
-    } else {
-      for(std::size_t i = 0;
-          i < board_.GetDimensionSize(curNode.current_dim_ + 1); i++) {
-        childNode.possible_move_ = curNode.possible_move_;
-        childNode.possible_move_.push_back(i);
-        childNode.current_dim_ = curNode.current_dim_ + 1;
-        nodes.push(childNode);
-      }
-    }
-    nodes.pop();
-  }
-}
-
 void ModelBoard::UpdatePossibleMoves(const MoveType& move, bool undo) {
   CoMoveType move_up(move.begin() + 1, move.end());
   auto it = possible_moves_.find(move_up);
@@ -270,10 +385,4 @@ void ModelBoard::UpdatePossibleMoves(const MoveType& move, bool undo) {
   }
 }
 
-void ModelBoard::ClearMoveHistory() {
-  while(!history_moves_.empty()) {
-    history_moves_.pop();
-  }
-}
-
 }  // namespace Core
\ No newline at end of file
@@ -0,0 +1,413 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Small neural network evaluating a board, its first layer is
+//               updated with every move (NNUE).
+//============================================================================
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include "neural_evaluator.h"
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CONNECTX_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace Core {
+
+// beyond it a file is rejected rather than allocated
+const std::size_t kNeuralMaxWeights = std::size_t(1) << 26;
+const int kNeuralDefaultOutputScale = 16;
+
+namespace {
+
+// accumulator += row or accumulator -= row, size is a multiple of
+// kNeuralHiddenAlignment
+typedef void (*UpdateFunction)(int16_t* accumulator,
+                               const int16_t* row,
+                               std::size_t size);
+// Sum of weights[i] * clip(accumulator[i])
+typedef int32_t (*DotFunction)(const int16_t* accumulator,
+                               const int8_t* weights,
+                               std::size_t size);
+
+void AddScalar(int16_t* accumulator, const int16_t* row, std::size_t size) {
+  for(std::size_t i = 0; i < size; i++) {
+    accumulator[i] = static_cast<int16_t>(accumulator[i] + row[i]);
+  }
+}
+
+void SubtractScalar(int16_t* accumulator,
+                    const int16_t* row,
+                    std::size_t size) {
+  for(std::size_t i = 0; i < size; i++) {
+    accumulator[i] = static_cast<int16_t>(accumulator[i] - row[i]);
+  }
+}
+
+int32_t DotScalar(const int16_t* accumulator,
+                  const int8_t* weights,
+                  std::size_t size) {
+  int32_t sum = 0;
+  for(std::size_t i = 0; i < size; i++) {
+    int value = std::min<int>(std::max<int>(accumulator[i], 0),
+                              kNeuralActivationMax);
+    sum += value * weights[i];
+  }
+  return sum;
+}
+
+#ifdef CONNECTX_X86_SIMD
+__attribute__((target("sse2"))) void AddSse2(int16_t* accumulator,
+                                             const int16_t* row,
+                                             std::size_t size) {
+  for(std::size_t i = 0; i < size; i += 8) {
+    __m128i* values = reinterpret_cast<__m128i*>(accumulator + i);
+    _mm_storeu_si128(values, _mm_add_epi16(_mm_loadu_si128(values),
+                                           _mm_loadu_si128(
+                                               reinterpret_cast<const __m128i*>(
+                                                   row + i))));
+  }
+}
+
+__attribute__((target("sse2"))) void SubtractSse2(int16_t* accumulator,
+                                                  const int16_t* row,
+                                                  std::size_t size) {
+  for(std::size_t i = 0; i < size; i += 8) {
+    __m128i* values = reinterpret_cast<__m128i*>(accumulator + i);
+    _mm_storeu_si128(values, _mm_sub_epi16(_mm_loadu_si128(values),
+                                           _mm_loadu_si128(
+                                               reinterpret_cast<const __m128i*>(
+                                                   row + i))));
+  }
+}
+
+// The weights are widened to 16 bits, madd sums the products by pairs
+__attribute__((target("sse2"))) int32_t DotSse2(const int16_t* accumulator,
+                                                const int8_t* weights,
+                                                std::size_t size) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i maximum = _mm_set1_epi16(kNeuralActivationMax);
+  __m128i sum = zero;
+  for(std::size_t i = 0; i < size; i += 16) {
+    __m128i low = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(accumulator + i));
+    __m128i high = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(accumulator + i + 8));
+    low = _mm_min_epi16(_mm_max_epi16(low, zero), maximum);
+    high = _mm_min_epi16(_mm_max_epi16(high, zero), maximum);
+    __m128i bytes =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(weights + i));
+    __m128i signs = _mm_cmpgt_epi8(zero, bytes);
+    sum = _mm_add_epi32(sum, _mm_madd_epi16(low, _mm_unpacklo_epi8(bytes,
+                                                                   signs)));
+    sum = _mm_add_epi32(sum, _mm_madd_epi16(high, _mm_unpackhi_epi8(bytes,
+                                                                    signs)));
+  }
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4E));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xB1));
+  return _mm_cvtsi128_si32(sum);
+}
+
+__attribute__((target("avx2"))) void AddAvx2(int16_t* accumulator,
+                                             const int16_t* row,
+                                             std::size_t size) {
+  for(std::size_t i = 0; i < size; i += 16) {
+    __m256i* values = reinterpret_cast<__m256i*>(accumulator + i);
+    _mm256_storeu_si256(
+        values, _mm256_add_epi16(_mm256_loadu_si256(values),
+                                 _mm256_loadu_si256(
+                                     reinterpret_cast<const __m256i*>(row + i))));
+  }
+}
+
+__attribute__((target("avx2"))) void SubtractAvx2(int16_t* accumulator,
+                                                  const int16_t* row,
+                                                  std::size_t size) {
+  for(std::size_t i = 0; i < size; i += 16) {
+    __m256i* values = reinterpret_cast<__m256i*>(accumulator + i);
+    _mm256_storeu_si256(
+        values, _mm256_sub_epi16(_mm256_loadu_si256(values),
+                                 _mm256_loadu_si256(
+                                     reinterpret_cast<const __m256i*>(row + i))));
+  }
+}
+
+// The clipped values are packed to unsigned bytes, maddubs multiplies them
+// with the signed weights: a pair sums to at most 2 * 127 * 128, no
+// saturation
+__attribute__((target("avx2"))) int32_t DotAvx2(const int16_t* accumulator,
+                                                const int8_t* weights,
+                                                std::size_t size) {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i maximum = _mm256_set1_epi16(kNeuralActivationMax);
+  const __m256i ones = _mm256_set1_epi16(1);
+  __m256i sum = zero;
+  for(std::size_t i = 0; i < size; i += 32) {
+    __m256i low = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(accumulator + i));
+    __m256i high = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(accumulator + i + 16));
+    low = _mm256_min_epi16(_mm256_max_epi16(low, zero), maximum);
+    high = _mm256_min_epi16(_mm256_max_epi16(high, zero), maximum);
+    // packus interleaves the 128 bit lanes, the permutation restores the order
+    __m256i values =
+        _mm256_permute4x64_epi64(_mm256_packus_epi16(low, high), 0xD8);
+    __m256i products = _mm256_maddubs_epi16(
+        values,
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(weights + i)));
+    sum = _mm256_add_epi32(sum, _mm256_madd_epi16(products, ones));
+  }
+  __m128i half = _mm_add_epi32(_mm256_castsi256_si128(sum),
+                               _mm256_extracti128_si256(sum, 1));
+  half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0x4E));
+  half = _mm_add_epi32(half, _mm_shuffle_epi32(half, 0xB1));
+  return _mm_cvtsi128_si32(half);
+}
+#endif
+
+UpdateFunction GetAddFunction(InstructionSet instruction_set) {
+#ifdef CONNECTX_X86_SIMD
+  if(instruction_set == InstructionSet::Avx2) {
+    return AddAvx2;
+  } else if(instruction_set == InstructionSet::Sse2) {
+    return AddSse2;
+  }
+#endif
+  return AddScalar;
+}
+
+UpdateFunction GetSubtractFunction(InstructionSet instruction_set) {
+#ifdef CONNECTX_X86_SIMD
+  if(instruction_set == InstructionSet::Avx2) {
+    return SubtractAvx2;
+  } else if(instruction_set == InstructionSet::Sse2) {
+    return SubtractSse2;
+  }
+#endif
+  return SubtractScalar;
+}
+
+DotFunction GetDotFunction(InstructionSet instruction_set) {
+#ifdef CONNECTX_X86_SIMD
+  if(instruction_set == InstructionSet::Avx2) {
+    return DotAvx2;
+  } else if(instruction_set == InstructionSet::Sse2) {
+    return DotSse2;
+  }
+#endif
+  return DotScalar;
+}
+
+template <typename T>
+bool ReadValues(std::istream& input, std::vector<T>& values) {
+  input.read(reinterpret_cast<char*>(values.data()),
+             values.size() * sizeof(T));
+  return static_cast<bool>(input);
+}
+
+template <typename T>
+void WriteValues(std::ostream& output, const std::vector<T>& values) {
+  output.write(reinterpret_cast<const char*>(values.data()),
+               values.size() * sizeof(T));
+}
+
+}  // namespace
+
+NeuralNetwork::NeuralNetwork()
+    : num_win_connected_(0),
+      num_players_(0),
+      hidden_size_(0),
+      output_scale_(kNeuralDefaultOutputScale),
+      instruction_set_(WindowEvaluator::GetBestInstructionSet()) {}
+
+void NeuralNetwork::Resize() {
+  std::size_t num_cells = 1;
+  strides_.assign(dimensions_.size(), 1);
+  for(std::size_t axis = dimensions_.size(); axis-- > 0;) {
+    strides_[axis] = num_cells;
+    num_cells *= dimensions_[axis];
+  }
+  feature_weights_.assign(num_cells * num_players_ * hidden_size_, 0);
+  feature_biases_.assign(hidden_size_, 0);
+  output_weights_.assign(num_players_ * num_players_ * hidden_size_, 0);
+  output_biases_.assign(num_players_, 0);
+}
+
+bool NeuralNetwork::Load(const std::string& path) {
+  std::ifstream input(path, std::ios::binary);
+  NeuralNetworkHeader header;
+  if(!input.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+     std::memcmp(header.magic_, kNeuralNetworkMagic, sizeof(header.magic_)) ||
+     header.version_ != kNeuralNetworkVersion ||
+     header.num_dimensions_ == 0 ||
+     header.num_dimensions_ > kNeuralNetworkMaxDimensions ||
+     header.num_win_connected_ > UINT8_MAX || header.num_players_ < 2 ||
+     header.num_players_ > UINT8_MAX || header.hidden_size_ == 0 ||
+     header.hidden_size_ > kNeuralMaxHiddenSize ||
+     header.hidden_size_ % kNeuralHiddenAlignment != 0 ||
+     header.output_scale_ <= 0) {
+    return false;
+  }
+  std::size_t num_weights = header.num_players_ * header.hidden_size_;
+  for(uint32_t axis = 0; axis < header.num_dimensions_; axis++) {
+    if(header.dimensions_[axis] == 0 ||
+       num_weights * header.dimensions_[axis] > kNeuralMaxWeights) {
+      return false;
+    }
+    num_weights *= header.dimensions_[axis];
+  }
+  dimensions_.assign(header.dimensions_,
+                     header.dimensions_ + header.num_dimensions_);
+  num_win_connected_ = static_cast<uint8_t>(header.num_win_connected_);
+  num_players_ = header.num_players_;
+  hidden_size_ = header.hidden_size_;
+  output_scale_ = header.output_scale_;
+  Resize();
+  bool valid = ReadValues(input, feature_weights_) &&
+               ReadValues(input, feature_biases_) &&
+               ReadValues(input, output_weights_) &&
+               ReadValues(input, output_biases_) &&
+               input.peek() == std::char_traits<char>::eof();
+  if(!valid) {
+    dimensions_.clear();
+    num_players_ = 0;
+    hidden_size_ = 0;
+    Resize();
+  }
+  return valid;
+}
+
+bool NeuralNetwork::Save(const std::string& path) const {
+  assert(!dimensions_.empty());
+  NeuralNetworkHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic_, kNeuralNetworkMagic, sizeof(header.magic_));
+  header.version_ = kNeuralNetworkVersion;
+  header.num_dimensions_ = dimensions_.size();
+  header.num_win_connected_ = num_win_connected_;
+  std::copy(dimensions_.begin(), dimensions_.end(), header.dimensions_);
+  header.num_players_ = num_players_;
+  header.hidden_size_ = hidden_size_;
+  header.output_scale_ = output_scale_;
+  std::ofstream output(path, std::ios::binary);
+  output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  WriteValues(output, feature_weights_);
+  WriteValues(output, feature_biases_);
+  WriteValues(output, output_weights_);
+  WriteValues(output, output_biases_);
+  return static_cast<bool>(output);
+}
+
+void NeuralNetwork::Initialize(const std::vector<std::size_t>& dimensions,
+                               uint8_t num_win_connected,
+                               uint8_t num_players,
+                               std::size_t hidden_size,
+                               uint32_t seed) {
+  assert(!dimensions.empty() &&
+         dimensions.size() <= kNeuralNetworkMaxDimensions);
+  assert(num_players >= 2);
+  assert(hidden_size > 0 && hidden_size <= kNeuralMaxHiddenSize &&
+         hidden_size % kNeuralHiddenAlignment == 0);
+  dimensions_ = dimensions;
+  num_win_connected_ = num_win_connected;
+  num_players_ = num_players;
+  hidden_size_ = hidden_size;
+  output_scale_ = kNeuralDefaultOutputScale;
+  Resize();
+  std::mt19937 random(seed);
+  std::uniform_int_distribution<int> feature_weight(-16, 16);
+  std::uniform_int_distribution<int> output_weight(-32, 32);
+  for(int16_t& weight : feature_weights_) {
+    weight = static_cast<int16_t>(feature_weight(random));
+  }
+  std::fill(feature_biases_.begin(), feature_biases_.end(),
+            kNeuralActivationMax / 2);
+  for(int8_t& weight : output_weights_) {
+    weight = static_cast<int8_t>(output_weight(random));
+  }
+}
+
+bool NeuralNetwork::HasShape(const std::vector<std::size_t>& dimensions,
+                             uint8_t num_win_connected,
+                             std::size_t num_players) const {
+  return dimensions_ == dimensions && num_win_connected_ == num_win_connected &&
+         num_players_ == num_players;
+}
+
+std::size_t NeuralNetwork::GetCellIndex(const MoveType& position) const {
+  assert(position.size() == strides_.size());
+  std::size_t index = 0;
+  for(std::size_t axis = 0; axis < strides_.size(); axis++) {
+    index += position[axis] * strides_[axis];
+  }
+  return index;
+}
+
+void NeuralNetwork::SetInstructionSet(InstructionSet instruction_set) {
+  assert(WindowEvaluator::IsAvailable(instruction_set));
+  instruction_set_ = instruction_set;
+}
+
+void NeuralAccumulator::Reset(const NeuralNetwork& network) {
+  values_.resize(network.num_players_ * network.hidden_size_);
+  for(std::size_t player = 0; player < network.num_players_; player++) {
+    std::copy(network.feature_biases_.begin(), network.feature_biases_.end(),
+              values_.begin() + player * network.hidden_size_);
+  }
+}
+
+void NeuralAccumulator::AddPiece(const NeuralNetwork& network,
+                                 std::size_t cell,
+                                 std::size_t turn) {
+  const std::size_t num_players = network.num_players_;
+  const std::size_t hidden_size = network.hidden_size_;
+  UpdateFunction add = GetAddFunction(network.instruction_set_);
+  for(std::size_t player = 0; player < num_players; player++) {
+    std::size_t feature =
+        cell * num_players + (turn + num_players - player) % num_players;
+    add(values_.data() + player * hidden_size,
+        network.feature_weights_.data() + feature * hidden_size, hidden_size);
+  }
+}
+
+void NeuralAccumulator::RemovePiece(const NeuralNetwork& network,
+                                    std::size_t cell,
+                                    std::size_t turn) {
+  const std::size_t num_players = network.num_players_;
+  const std::size_t hidden_size = network.hidden_size_;
+  UpdateFunction subtract = GetSubtractFunction(network.instruction_set_);
+  for(std::size_t player = 0; player < num_players; player++) {
+    std::size_t feature =
+        cell * num_players + (turn + num_players - player) % num_players;
+    subtract(values_.data() + player * hidden_size,
+             network.feature_weights_.data() + feature * hidden_size,
+             hidden_size);
+  }
+}
+
+int NeuralAccumulator::Evaluate(const NeuralNetwork& network,
+                                std::size_t perspective_turn,
+                                std::size_t next_turn) const {
+  const std::size_t num_players = network.num_players_;
+  const std::size_t hidden_size = network.hidden_size_;
+  assert(values_.size() == num_players * hidden_size);
+  std::size_t row = (next_turn + num_players - perspective_turn) % num_players;
+  const int8_t* weights =
+      network.output_weights_.data() + row * num_players * hidden_size;
+  DotFunction dot = GetDotFunction(network.instruction_set_);
+  int64_t sum = network.output_biases_[row];
+  for(std::size_t i = 0; i < num_players; i++) {
+    std::size_t player = (perspective_turn + i) % num_players;
+    sum += dot(values_.data() + player * hidden_size, weights + i * hidden_size,
+               hidden_size);
+  }
+  sum /= network.output_scale_;
+  return static_cast<int>(std::max<int64_t>(
+      std::min<int64_t>(sum, kNeuralMaxScore), -kNeuralMaxScore));
+}
+
+}  // namespace Core
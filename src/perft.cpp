@@ -0,0 +1,19 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Enumeration of the move sequences of a board (perft).
+//============================================================================
+#include "perft.h"
+
+namespace Core {
+
+PerftCounts& PerftCounts::operator+=(const PerftCounts& counts) {
+  leaves_ += counts.leaves_;
+  wins_ += counts.wins_;
+  draws_ += counts.draws_;
+  moves_ += counts.moves_;
+  return *this;
+}
+
+}  // namespace Core
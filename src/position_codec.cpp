@@ -0,0 +1,311 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Text and binary encodings of a position.
+//============================================================================
+#include <algorithm>
+#include <cctype>
+#include "position_codec.h"
+
+namespace Core {
+
+static void AppendVarint(std::string& bytes, uint64_t value) {
+  while(value >= 0x80) {
+    bytes += static_cast<char>((value & 0x7F) | 0x80);
+    value >>= 7;
+  }
+  bytes += static_cast<char>(value);
+}
+
+static bool ReadVarint(const std::string& bytes, std::size_t& offset,
+                       uint64_t& value) {
+  value = 0;
+  for(int shift = 0; shift < 64 && offset < bytes.size(); shift += 7) {
+    uint8_t byte = bytes[offset++];
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if(!(byte & 0x80)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool ReadNumber(const std::string& text, std::size_t& offset,
+                       std::size_t& value) {
+  std::size_t start = offset;
+  value = 0;
+  while(offset < text.size() && std::isdigit(text[offset])) {
+    if(value > (SIZE_MAX - 9) / 10) {
+      return false;
+    }
+    value = value * 10 + (text[offset++] - '0');
+  }
+  return offset > start;
+}
+
+static bool ReadSpace(const std::string& text, std::size_t& offset) {
+  std::size_t start = offset;
+  while(offset < text.size() && text[offset] == ' ') {
+    offset++;
+  }
+  return offset > start;
+}
+
+std::size_t GetNumCells(const std::vector<std::size_t>& dimensions) {
+  std::size_t num_cells = 1;
+  for(std::size_t dim : dimensions) {
+    num_cells *= dim;
+  }
+  return num_cells;
+}
+
+bool IsValidShape(const std::vector<std::size_t>& dimensions) {
+  if(dimensions.size() <= kMinNumDimensions ||
+     dimensions.size() > kMaxPositionDimensions) {
+    return false;
+  }
+  std::size_t num_cells = 1;
+  for(std::size_t dim : dimensions) {
+    if(dim == 0 || dim > kMaxPositionCells / num_cells) {
+      return false;
+    }
+    num_cells *= dim;
+  }
+  return true;
+}
+
+// number of bits per cell in the binary encoding
+static std::size_t GetCellBits(std::size_t num_players) {
+  std::size_t bits = 1;
+  while((std::size_t(1) << bits) <= num_players) {
+    bits++;
+  }
+  return bits;
+}
+
+void GetPosition(const ModelBoard& board, Position& position) {
+  const std::vector<ModelBoard::PieceIDType>& piece_IDs = board.GetPieceIDs();
+  position.dimensions_ = board.GetDimensions();
+  position.num_win_connected_ = board.GetNumWinConnected();
+  position.num_players_ = piece_IDs.size();
+  position.side_to_move_ =
+      std::find(piece_IDs.begin(), piece_IDs.end(), board.GetNextChipId()) -
+      piece_IDs.begin() + 1;
+  position.cells_.clear();
+  ModelBoard::MoveType coordinates(position.dimensions_.size(), 0);
+  do {
+    ModelBoard::PieceIDType piece_ID = board.GetPiece(coordinates);
+    position.cells_.push_back(
+        piece_ID == kEmptyPosition ?
+            0 :
+            std::find(piece_IDs.begin(), piece_IDs.end(), piece_ID) -
+                piece_IDs.begin() + 1);
+  } while(ModelBoard::NextCoordinates(position.dimensions_, coordinates));
+}
+
+bool SetPosition(const Position& position, ModelBoard& board) {
+  const std::vector<ModelBoard::PieceIDType>& piece_IDs = board.GetPieceIDs();
+  if(position.dimensions_ != board.GetDimensions() ||
+     position.num_win_connected_ != board.GetNumWinConnected() ||
+     position.num_players_ != piece_IDs.size()) {
+    return false;
+  }
+  std::vector<ModelBoard::PieceIDType> cells(position.cells_.size());
+  for(std::size_t i = 0; i < cells.size(); i++) {
+    cells[i] = position.cells_[i] == 0 ? kEmptyPosition :
+                                         piece_IDs[position.cells_[i] - 1];
+  }
+  return board.SetPosition(cells, piece_IDs[position.side_to_move_ - 1]);
+}
+
+std::string SerializePosition(const Position& position) {
+  std::string text;
+  for(std::size_t i = 0; i < position.dimensions_.size(); i++) {
+    if(i > 0) {
+      text += kPositionDimensionSeparator;
+    }
+    text += std::to_string(position.dimensions_[i]);
+  }
+  text += ' ' + std::to_string(position.num_win_connected_) + ' ' +
+          std::to_string(position.num_players_) + ' ' +
+          static_cast<char>(kPositionFirstPlayer + position.side_to_move_ - 1) +
+          ' ';
+  std::size_t line_size = position.dimensions_.back();
+  std::size_t num_empty = 0;
+  for(std::size_t i = 0; i < position.cells_.size(); i++) {
+    if(i > 0 && i % line_size == 0) {
+      if(num_empty > 0) {
+        text += std::to_string(num_empty);
+        num_empty = 0;
+      }
+      text += kPositionLineSeparator;
+    }
+    if(position.cells_[i] == 0) {
+      num_empty++;
+      continue;
+    }
+    if(num_empty > 0) {
+      text += std::to_string(num_empty);
+      num_empty = 0;
+    }
+    text += static_cast<char>(kPositionFirstPlayer + position.cells_[i] - 1);
+  }
+  if(num_empty > 0) {
+    text += std::to_string(num_empty);
+  }
+  return text;
+}
+
+std::string SerializePosition(const ModelBoard& board) {
+  Position position;
+  GetPosition(board, position);
+  return SerializePosition(position);
+}
+
+bool ParsePosition(const std::string& text, Position& position) {
+  std::size_t offset = 0, value;
+  ReadSpace(text, offset);
+  position.dimensions_.clear();
+  do {
+    if(!ReadNumber(text, offset, value) || value == 0) {
+      return false;
+    }
+    position.dimensions_.push_back(value);
+  } while(offset < text.size() && text[offset++] == kPositionDimensionSeparator);
+  offset--;
+  // the cells are allocated from the shape, which is checked first
+  if(!IsValidShape(position.dimensions_) ||
+     !ReadSpace(text, offset) || !ReadNumber(text, offset, value) ||
+     value <= kDefaultMinNumConnected || value > UINT8_MAX) {
+    return false;
+  }
+  position.num_win_connected_ = value;
+  if(!ReadSpace(text, offset) || !ReadNumber(text, offset, value) ||
+     value <= kDefaultNumChips || value > kMaxPositionPlayers) {
+    return false;
+  }
+  position.num_players_ = value;
+  if(!ReadSpace(text, offset) || offset >= text.size()) {
+    return false;
+  }
+  position.side_to_move_ = text[offset++] - kPositionFirstPlayer + 1;
+  if(position.side_to_move_ < 1 ||
+     position.side_to_move_ > position.num_players_ ||
+     !ReadSpace(text, offset)) {
+    return false;
+  }
+  std::size_t line_size = position.dimensions_.back();
+  std::size_t num_cells = GetNumCells(position.dimensions_);
+  position.cells_.clear();
+  position.cells_.reserve(num_cells);
+  std::size_t line_end = line_size;
+  while(offset < text.size() && text[offset] != ' ') {
+    char symbol = text[offset];
+    if(symbol == kPositionLineSeparator) {
+      if(position.cells_.size() != line_end) {
+        return false;
+      }
+      line_end += line_size;
+      offset++;
+    } else if(std::isdigit(symbol)) {
+      ReadNumber(text, offset, value);
+      // the count is checked before the cells are allocated
+      if(value > line_end - position.cells_.size()) {
+        return false;
+      }
+      position.cells_.insert(position.cells_.end(), value, 0);
+    } else {
+      uint8_t turn = symbol - kPositionFirstPlayer + 1;
+      if(turn < 1 || turn > position.num_players_) {
+        return false;
+      }
+      position.cells_.push_back(turn);
+      offset++;
+    }
+    if(position.cells_.size() > line_end) {
+      return false;
+    }
+  }
+  return position.cells_.size() == num_cells && line_end == num_cells;
+}
+
+void EncodePosition(const Position& position, std::string& bytes) {
+  AppendVarint(bytes, position.dimensions_.size());
+  for(std::size_t dim : position.dimensions_) {
+    AppendVarint(bytes, dim);
+  }
+  bytes += static_cast<char>(position.num_win_connected_);
+  bytes += static_cast<char>(position.num_players_);
+  bytes += static_cast<char>(position.side_to_move_);
+  std::size_t bits = GetCellBits(position.num_players_);
+  uint32_t buffer = 0;
+  std::size_t num_bits = 0;
+  for(uint8_t cell : position.cells_) {
+    buffer |= static_cast<uint32_t>(cell) << num_bits;
+    num_bits += bits;
+    while(num_bits >= 8) {
+      bytes += static_cast<char>(buffer & 0xFF);
+      buffer >>= 8;
+      num_bits -= 8;
+    }
+  }
+  if(num_bits > 0) {
+    bytes += static_cast<char>(buffer & 0xFF);
+  }
+}
+
+bool DecodePosition(const std::string& bytes, std::size_t& offset,
+                    Position& position) {
+  uint64_t value;
+  if(!ReadVarint(bytes, offset, value) || value <= kMinNumDimensions ||
+     value > kMaxPositionDimensions) {
+    return false;
+  }
+  position.dimensions_.resize(value);
+  for(std::size_t& dim : position.dimensions_) {
+    if(!ReadVarint(bytes, offset, value) || value == 0 ||
+       value > kMaxPositionCells) {
+      return false;
+    }
+    dim = value;
+  }
+  if(!IsValidShape(position.dimensions_) || offset + 3 > bytes.size()) {
+    return false;
+  }
+  position.num_win_connected_ = bytes[offset++];
+  position.num_players_ = bytes[offset++];
+  position.side_to_move_ = bytes[offset++];
+  if(position.num_win_connected_ <= kDefaultMinNumConnected ||
+     position.num_players_ <= kDefaultNumChips ||
+     position.num_players_ > kMaxPositionPlayers || position.side_to_move_ < 1 ||
+     position.side_to_move_ > position.num_players_) {
+    return false;
+  }
+  std::size_t bits = GetCellBits(position.num_players_);
+  // at most kMaxPositionCells cells of a few bits, the size cannot overflow
+  std::size_t num_cells = GetNumCells(position.dimensions_);
+  if((num_cells * bits + 7) / 8 > bytes.size() - offset) {
+    return false;
+  }
+  position.cells_.resize(num_cells);
+  uint32_t buffer = 0;
+  std::size_t num_bits = 0;
+  const uint32_t mask = (1u << bits) - 1;
+  for(uint8_t& cell : position.cells_) {
+    while(num_bits < bits) {
+      buffer |= static_cast<uint32_t>(static_cast<uint8_t>(bytes[offset++]))
+                << num_bits;
+      num_bits += 8;
+    }
+    cell = buffer & mask;
+    buffer >>= bits;
+    num_bits -= bits;
+    if(cell > position.num_players_) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace Core
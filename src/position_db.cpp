@@ -0,0 +1,219 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Memory-mapped database of the statistics of positions.
+//============================================================================
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstring>
+#include "position_codec.h"
+#include "position_db.h"
+#include "position_hash.h"
+
+namespace Core {
+
+// The key 0 marks the empty slots
+static uint64_t GetStoredKey(uint64_t key) {
+  return key == 0 ? 1 : key;
+}
+
+PositionDatabase::PositionDatabase()
+    : header_(nullptr), entries_(nullptr), length_(0), writable_(false) {
+}
+
+PositionDatabase::~PositionDatabase() {
+  Close();
+}
+
+bool PositionDatabase::Map(int file, std::size_t length, bool writable) {
+  void* address = mmap(nullptr, length, writable ? PROT_READ | PROT_WRITE :
+                                                   PROT_READ,
+                       MAP_SHARED, file, 0);
+  close(file);
+  if(address == MAP_FAILED) {
+    return false;
+  }
+  header_ = static_cast<PositionDbHeader*>(address);
+  entries_ = reinterpret_cast<PositionDbEntry*>(header_ + 1);
+  length_ = length;
+  writable_ = writable;
+  return true;
+}
+
+bool PositionDatabase::Open(const std::string& path) {
+  Close();
+  int file = open(path.c_str(), O_RDONLY);
+  if(file < 0) {
+    return false;
+  }
+  struct stat file_stat;
+  if(fstat(file, &file_stat) != 0 ||
+     static_cast<std::size_t>(file_stat.st_size) < sizeof(PositionDbHeader)) {
+    close(file);
+    return false;
+  }
+  if(!Map(file, file_stat.st_size, false)) {
+    return false;
+  }
+  if(std::memcmp(header_->magic_, kPositionDbMagic, sizeof(kPositionDbMagic)) ||
+     header_->version_ != kPositionDbVersion ||
+     header_->num_dimensions_ <= kMinNumDimensions ||
+     header_->num_dimensions_ > kPositionDbMaxDimensions ||
+     header_->num_win_connected_ <= kDefaultMinNumConnected ||
+     header_->num_players_ <= kDefaultNumChips ||
+     header_->num_players_ > kMaxPositionPlayers ||
+     !IsValidShape(GetDimensions()) ||
+     header_->capacity_ == 0 ||
+     (header_->capacity_ & (header_->capacity_ - 1)) != 0 ||
+     header_->capacity_ > (length_ - sizeof(PositionDbHeader)) /
+                              sizeof(PositionDbEntry)) {
+    Close();
+    return false;
+  }
+  // the slots are probed in a random order
+  madvise(header_, length_, MADV_RANDOM);
+  return true;
+}
+
+bool PositionDatabase::Create(const std::string& path,
+                              const std::vector<std::size_t>& dimensions,
+                              uint8_t num_win_connected,
+                              std::size_t num_players,
+                              std::size_t num_positions) {
+  assert(dimensions.size() <= kPositionDbMaxDimensions);
+  Close();
+  // the load factor stays below one half
+  std::size_t capacity = 1;
+  while(capacity < 2 * num_positions) {
+    capacity <<= 1;
+  }
+  std::size_t length =
+      sizeof(PositionDbHeader) + capacity * sizeof(PositionDbEntry);
+  int file = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if(file < 0) {
+    return false;
+  }
+  if(ftruncate(file, length) != 0) {
+    close(file);
+    return false;
+  }
+  if(!Map(file, length, true)) {
+    return false;
+  }
+  // the file is created filled with zeros, all the slots are empty
+  std::memcpy(header_->magic_, kPositionDbMagic, sizeof(kPositionDbMagic));
+  header_->version_ = kPositionDbVersion;
+  header_->num_dimensions_ = dimensions.size();
+  header_->num_win_connected_ = num_win_connected;
+  header_->num_players_ = num_players;
+  for(std::size_t i = 0; i < dimensions.size(); i++) {
+    header_->dimensions_[i] = dimensions[i];
+  }
+  header_->capacity_ = capacity;
+  header_->size_ = 0;
+  return true;
+}
+
+void PositionDatabase::Close() {
+  if(header_ != nullptr) {
+    if(writable_) {
+      msync(header_, length_, MS_SYNC);
+    }
+    munmap(header_, length_);
+  }
+  header_ = nullptr;
+  entries_ = nullptr;
+  length_ = 0;
+  writable_ = false;
+}
+
+bool PositionDatabase::HasShape(const std::vector<std::size_t>& dimensions,
+                                uint8_t num_win_connected,
+                                std::size_t num_players) const {
+  if(header_ == nullptr || header_->num_dimensions_ != dimensions.size() ||
+     header_->num_win_connected_ != num_win_connected ||
+     header_->num_players_ != num_players) {
+    return false;
+  }
+  for(std::size_t i = 0; i < dimensions.size(); i++) {
+    if(header_->dimensions_[i] != dimensions[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::vector<std::size_t> PositionDatabase::GetDimensions() const {
+  std::vector<std::size_t> dimensions;
+  if(header_ != nullptr) {
+    dimensions.assign(header_->dimensions_,
+                      header_->dimensions_ + header_->num_dimensions_);
+  }
+  return dimensions;
+}
+
+std::size_t PositionDatabase::GetSlot(uint64_t key) const {
+  std::size_t mask = header_->capacity_ - 1;
+  std::size_t slot = key & mask;
+  while(entries_[slot].key_ != 0 && entries_[slot].key_ != key) {
+    slot = (slot + 1) & mask;
+  }
+  return slot;
+}
+
+bool PositionDatabase::Find(uint64_t key, PositionStats& stats) const {
+  if(header_ == nullptr) {
+    return false;
+  }
+  key = GetStoredKey(key);
+  const PositionDbEntry& entry = entries_[GetSlot(key)];
+  if(entry.key_ != key) {
+    return false;
+  }
+  stats = entry.stats_;
+  return true;
+}
+
+bool PositionDatabase::Find(const ModelBoard& board,
+                            PositionStats& stats) const {
+  if(!HasShape(board.GetDimensions(), board.GetNumWinConnected(),
+               board.GetPieceIDs().size())) {
+    return false;
+  }
+  PositionHasher hasher(board.GetDimensions());
+  hasher.Compute(board);
+  return Find(hasher.GetCanonicalKey(), stats);
+}
+
+bool PositionDatabase::Add(uint64_t key, GameResult result) {
+  assert(writable_);
+  key = GetStoredKey(key);
+  PositionDbEntry& entry = entries_[GetSlot(key)];
+  if(entry.key_ == 0) {
+    if(2 * (header_->size_ + 1) > header_->capacity_) {
+      return false;
+    }
+    entry.key_ = key;
+    header_->size_++;
+  }
+  entry.stats_.count_++;
+  switch(result) {
+    case GameResult::Win:
+      entry.stats_.wins_++;
+      break;
+    case GameResult::Loss:
+      entry.stats_.losses_++;
+      break;
+    case GameResult::Draw:
+      entry.stats_.draws_++;
+      break;
+    case GameResult::Unknown:
+      break;
+  }
+  return true;
+}
+
+}  // namespace Core
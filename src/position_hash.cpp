@@ -0,0 +1,73 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Zobrist hashing of the positions of a board.
+//============================================================================
+#include <algorithm>
+#include "position_hash.h"
+
+namespace Core {
+
+// splitmix64 finalizer, the keys are derived from the cell and the piece
+static uint64_t MixBits(uint64_t value) {
+  value += 0x9E3779B97F4A7C15ULL;
+  value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+  return value ^ (value >> 31);
+}
+
+PositionHasher::PositionHasher(const std::vector<std::size_t>& dimensions)
+    : dimensions_(dimensions)
+    , strides_(dimensions.size())
+    , keys_(std::size_t(1) << (dimensions.size() - 1), 0) {
+  assert(dimensions.size() > kMinNumDimensions);
+  std::size_t stride = 1;
+  for(std::size_t i = dimensions_.size(); i-- > 0;) {
+    strides_[i] = stride;
+    stride *= dimensions_[i];
+  }
+}
+
+void PositionHasher::Clear() {
+  std::fill(keys_.begin(), keys_.end(), 0);
+}
+
+uint64_t PositionHasher::GetCellKey(std::size_t offset, std::size_t turn) {
+  return MixBits((static_cast<uint64_t>(offset) << 8) |
+                 static_cast<uint8_t>(turn));
+}
+
+void PositionHasher::Toggle(const MoveType& position, std::size_t turn) {
+  assert(position.size() == dimensions_.size());
+  for(std::size_t mirror = 0; mirror < keys_.size(); mirror++) {
+    std::size_t offset = position[0] * strides_[0];
+    for(std::size_t i = 1; i < dimensions_.size(); i++) {
+      std::size_t coordinate = (mirror >> (i - 1)) & 1 ?
+                                   dimensions_[i] - 1 - position[i] :
+                                   position[i];
+      offset += coordinate * strides_[i];
+    }
+    keys_[mirror] ^= GetCellKey(offset, turn);
+  }
+}
+
+uint64_t PositionHasher::GetCanonicalKey() const {
+  return *std::min_element(keys_.begin(), keys_.end());
+}
+
+void PositionHasher::Compute(const ModelBoard& board) {
+  assert(board.GetDimensions() == dimensions_);
+  Clear();
+  const std::vector<PieceIDType>& piece_IDs = board.GetPieceIDs();
+  MoveType position(dimensions_.size(), 0);
+  do {
+    PieceIDType piece_ID = board.GetPiece(position);
+    if(piece_ID != kEmptyPosition) {
+      Toggle(position, std::find(piece_IDs.begin(), piece_IDs.end(), piece_ID) -
+                           piece_IDs.begin() + 1);
+    }
+  } while(ModelBoard::NextCoordinates(dimensions_, position));
+}
+
+}  // namespace Core
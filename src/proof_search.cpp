@@ -0,0 +1,313 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Depth-first proof-number search (df-pn) proving the forced
+//               wins of the player to move.
+//============================================================================
+#include "proof_search.h"
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+namespace Core {
+
+static const uint32_t kProofInfinite = std::numeric_limits<uint32_t>::max();
+static const std::size_t kProofBucketSize = 4;
+// the clock is read once kProofClockNodes nodes were searched since the
+// last reading
+static const std::size_t kProofClockNodes = 1024;
+
+static uint32_t AddNumbers(uint32_t a, uint32_t b) {
+  return a >= kProofInfinite - b ? kProofInfinite : a + b;
+}
+
+// threshold - sum + child, without overflow
+static uint32_t GetChildThreshold(uint32_t threshold, uint32_t sum,
+                                  uint32_t child) {
+  if(threshold == kProofInfinite) {
+    return kProofInfinite;
+  }
+  uint64_t value = static_cast<uint64_t>(threshold) + child;
+  value = value > sum ? value - sum : 0;
+  return static_cast<uint32_t>(
+      std::min<uint64_t>(value, kProofInfinite));
+}
+
+// Number of winning cells of chip among the moves, counted up to two
+static std::size_t CountWins(const ModelBoard& board,
+                             const std::vector<ModelBoard::MoveType>& moves,
+                             ModelBoard::PieceIDType chip,
+                             std::size_t& index) {
+  std::size_t num_wins = 0;
+  for(std::size_t i = 0; i < moves.size() && num_wins < 2; i++) {
+    if(board.IsWinningMove(moves[i], chip)) {
+      if(num_wins == 0) {
+        index = i;
+      }
+      num_wins++;
+    }
+  }
+  return num_wins;
+}
+
+// The number of buckets is the largest power of two that fits
+ProofSearch::ProofSearch(std::size_t num_megabytes)
+    : attacker_(0), attacker_key_(0), num_nodes_(0), max_nodes_(0),
+      next_clock_nodes_(0), has_deadline_(false), aborted_(false) {
+  std::size_t num_buckets = 1;
+  while(num_buckets * 2 * kProofBucketSize * sizeof(Entry) <=
+        (num_megabytes << 20)) {
+    num_buckets *= 2;
+  }
+  entries_.reset(new Entry[num_buckets * kProofBucketSize]);
+  mask_ = num_buckets - 1;
+  Clear();
+}
+
+void ProofSearch::Clear() {
+  for(std::size_t i = 0; i < (mask_ + 1) * kProofBucketSize; i++) {
+    entries_[i] = Entry{0, {1, 1}, 0};
+  }
+}
+
+bool ProofSearch::Probe(uint64_t key, Numbers& numbers, uint32_t& work) const {
+  const Entry* bucket = &entries_[(key & mask_) * kProofBucketSize];
+  for(std::size_t i = 0; i < kProofBucketSize; i++) {
+    if(bucket[i].key_ == key) {
+      numbers = bucket[i].numbers_;
+      work = bucket[i].work_;
+      return true;
+    }
+  }
+  return false;
+}
+
+void ProofSearch::Store(uint64_t key, const Numbers& numbers, uint32_t work) {
+  Entry* bucket = &entries_[(key & mask_) * kProofBucketSize];
+  Entry* replaced = bucket;
+  for(std::size_t i = 0; i < kProofBucketSize; i++) {
+    if(bucket[i].key_ == key) {
+      replaced = &bucket[i];
+      break;
+    }
+    if(bucket[i].work_ < replaced->work_) {
+      replaced = &bucket[i];
+    }
+  }
+  *replaced = Entry{key, numbers, work};
+}
+
+// The same position has other numbers for another attacker, 0 marks the
+// empty entries
+uint64_t ProofSearch::GetKey(const ModelBoard& board) const {
+  uint64_t key = board.GetHashKey() ^ attacker_key_;
+  return key == 0 ? 1 : key;
+}
+
+bool ProofSearch::Evaluate(ModelBoard& board,
+                           std::vector<MoveType>& moves,
+                           Numbers& numbers) const {
+  const Numbers proven = {0, kProofInfinite};
+  const Numbers disproven = {kProofInfinite, 0};
+  if(board.GetCurrentState() == States::Win) {
+    numbers = board.GetCurrentChipId() == attacker_ ? proven : disproven;
+    return true;
+  }
+  if(board.GetCurrentState() != States::OnGoing) {
+    numbers = disproven;
+    return true;
+  }
+  board.GetPossibleMoves(moves);
+  PieceIDType chip = board.GetNextChipId();
+  std::size_t index = 0;
+  if(CountWins(board, moves, chip, index) > 0) {
+    numbers = chip == attacker_ ? proven : disproven;
+    return true;
+  }
+  const std::vector<PieceIDType>& piece_IDs = board.GetPieceIDs();
+  std::size_t next_index =
+      (std::find(piece_IDs.begin(), piece_IDs.end(), chip) -
+       piece_IDs.begin() + 1) % piece_IDs.size();
+  PieceIDType next_chip = piece_IDs[next_index];
+  // a defender lets the next defender win, it is not a threat to block
+  if(chip != attacker_ && next_chip != attacker_) {
+    return false;
+  }
+  std::size_t num_wins = CountWins(board, moves, next_chip, index);
+  if(num_wins > 1) {
+    numbers = next_chip == attacker_ ? proven : disproven;
+    return true;
+  }
+  if(num_wins == 1) {
+    MoveType block = moves[index];
+    moves.assign(1, block);
+  }
+  return false;
+}
+
+ProofSearch::Numbers ProofSearch::GetChildNumbers(ModelBoard& board,
+                                                  const MoveType& move,
+                                                  uint32_t& work) {
+  Numbers numbers = {1, 1};
+  work = 0;
+  board.SetMove(move);
+  if(board.GetCurrentState() != States::OnGoing) {
+    std::vector<MoveType> moves;
+    Evaluate(board, moves, numbers);
+  } else {
+    Probe(GetKey(board), numbers, work);
+  }
+  board.Undo();
+  return numbers;
+}
+
+bool ProofSearch::IsOutOfBudget() {
+  if(aborted_) {
+    return true;
+  }
+  if(max_nodes_ > 0 && num_nodes_ >= max_nodes_) {
+    aborted_ = true;
+  } else if(has_deadline_ && num_nodes_ >= next_clock_nodes_) {
+    // the budget is not checked at every node, a multiple of
+    // kProofClockNodes can be passed without a reading
+    next_clock_nodes_ = num_nodes_ + kProofClockNodes;
+    aborted_ = std::chrono::steady_clock::now() >= deadline_;
+  }
+  return aborted_;
+}
+
+// Multiple iterative deepening (MID): the children are searched while the
+// numbers of the node stay below the thresholds
+void ProofSearch::Search(ModelBoard& board,
+                         const Numbers& thresholds,
+                         Numbers& numbers) {
+  num_nodes_++;
+  uint64_t key = GetKey(board);
+  std::vector<MoveType> moves;
+  if(Evaluate(board, moves, numbers)) {
+    Store(key, numbers, 1);
+    return;
+  }
+  std::size_t start_nodes = num_nodes_;
+  bool or_node = board.GetNextChipId() == attacker_;
+  std::vector<Numbers> children(moves.size());
+  uint32_t work = 0;
+  for(std::size_t i = 0; i < moves.size(); i++) {
+    children[i] = GetChildNumbers(board, moves[i], work);
+  }
+  while(true) {
+    // min and sum are taken on the numbers of the player to move: the proof
+    // numbers at an OR node, the disproof numbers at an AND node
+    uint32_t min_value = kProofInfinite, second_value = kProofInfinite;
+    uint32_t sum = 0;
+    std::size_t best = 0;
+    for(std::size_t i = 0; i < children.size(); i++) {
+      uint32_t value = or_node ? children[i].proof_ : children[i].disproof_;
+      uint32_t other = or_node ? children[i].disproof_ : children[i].proof_;
+      sum = AddNumbers(sum, other);
+      if(value < min_value) {
+        second_value = min_value;
+        min_value = value;
+        best = i;
+      } else if(value < second_value) {
+        second_value = value;
+      }
+    }
+    numbers = or_node ? Numbers{min_value, sum} : Numbers{sum, min_value};
+    if(numbers.proof_ >= thresholds.proof_ ||
+       numbers.disproof_ >= thresholds.disproof_ || IsOutOfBudget()) {
+      break;
+    }
+    Numbers child_thresholds;
+    uint32_t limit = AddNumbers(second_value, 1);
+    if(or_node) {
+      child_thresholds.proof_ = std::min(thresholds.proof_, limit);
+      child_thresholds.disproof_ = GetChildThreshold(
+          thresholds.disproof_, numbers.disproof_, children[best].disproof_);
+    } else {
+      child_thresholds.disproof_ = std::min(thresholds.disproof_, limit);
+      child_thresholds.proof_ = GetChildThreshold(
+          thresholds.proof_, numbers.proof_, children[best].proof_);
+    }
+    board.SetMove(moves[best]);
+    Search(board, child_thresholds, children[best]);
+    board.Undo();
+  }
+  std::size_t subtree_nodes = num_nodes_ - start_nodes + 1;
+  Store(key, numbers, static_cast<uint32_t>(
+      std::min<std::size_t>(subtree_nodes, kProofInfinite)));
+}
+
+// The attacker plays a proven move, the defence the proven move which took
+// the longest to search. The line stops early if its nodes were replaced.
+void ProofSearch::BuildLine(ModelBoard& board, std::vector<MoveType>& line) {
+  line.clear();
+  std::vector<MoveType> moves;
+  Numbers numbers;
+  while(board.GetCurrentState() == States::OnGoing) {
+    PieceIDType chip = board.GetNextChipId();
+    bool decided = Evaluate(board, moves, numbers);
+    std::size_t index = 0;
+    if(chip == attacker_ && CountWins(board, moves, chip, index) > 0) {
+      line.push_back(moves[index]);
+      break;
+    }
+    bool found = false;
+    MoveType next_move;
+    uint32_t best_work = 0;
+    for(const MoveType& move : moves) {
+      uint32_t work = 0;
+      if(GetChildNumbers(board, move, work).proof_ != 0 ||
+         (found && work <= best_work)) {
+        continue;
+      }
+      found = true;
+      best_work = work;
+      next_move = move;
+      if(chip == attacker_) {
+        break;
+      }
+    }
+    if(!found) {
+      // a defender facing two wins of the attacker loses with any move
+      if(chip == attacker_ || !decided || numbers.proof_ != 0) {
+        break;
+      }
+      next_move = moves.front();
+    }
+    line.push_back(next_move);
+    board.SetMove(next_move);
+  }
+}
+
+ProofStatus ProofSearch::Solve(const ModelBoard& board,
+                               const ProofLimits& limits,
+                               std::vector<MoveType>& line) {
+  line.clear();
+  num_nodes_ = 0;
+  if(board.GetCurrentState() != States::OnGoing) {
+    return ProofStatus::Disproven;
+  }
+  ModelBoard proof_board(board);
+  // the simulated moves must not be recorded
+  proof_board.SetRecorder(nullptr);
+  attacker_ = proof_board.GetNextChipId();
+  attacker_key_ = 0x9E3779B97F4A7C15ULL *
+                  static_cast<uint64_t>(static_cast<uint8_t>(attacker_) + 1);
+  max_nodes_ = limits.nodes_;
+  has_deadline_ = limits.time_.count() > 0;
+  deadline_ = std::chrono::steady_clock::now() + limits.time_;
+  next_clock_nodes_ = kProofClockNodes;
+  aborted_ = false;
+  Numbers numbers;
+  Search(proof_board, Numbers{kProofInfinite, kProofInfinite}, numbers);
+  if(numbers.proof_ == 0) {
+    BuildLine(proof_board, line);
+    return ProofStatus::Proven;
+  }
+  return numbers.disproof_ == 0 ? ProofStatus::Disproven
+                                : ProofStatus::Unknown;
+}
+
+}  // namespace Core
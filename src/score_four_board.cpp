@@ -0,0 +1,503 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Score Four, the 4x4x4 Connect Four of 2 players, on a 64 bit
+//               bitboard with its own alpha-beta search.
+//============================================================================
+#include "score_four_board.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include "trace.h"
+
+namespace Core {
+
+namespace {
+
+const std::size_t kLayerCells = kScoreFourSize * kScoreFourSize;
+const std::size_t kMaxCellLines = 7;
+const std::size_t kTableBits = 16;
+const std::size_t kBucketSize = 2;
+// a win at ply p is worth kWin - p, the scores beyond kWinBound are wins
+const int kWin = 1 << 20;
+const int kWinBound = kWin - static_cast<int>(kScoreFourNumCells) - 1;
+const int kInfinite = kWin + 1;
+// score of a line holding 0 to 4 pieces of a single player, the searched
+// positions never hold a full line
+const int kLineScores[kScoreFourSize + 1] = {0, 1, 6, 36, 0};
+const std::size_t kCheckMask = 0x3FF;
+
+struct Lines {
+  uint64_t lines_[kScoreFourNumLines];
+  uint64_t cell_lines_[kScoreFourNumCells][kMaxCellLines];
+  std::size_t num_cell_lines_[kScoreFourNumCells];
+};
+
+// The lines of the 13 directions whose first non zero step is positive
+Lines ComputeLines() {
+  Lines lines;
+  std::memset(&lines, 0, sizeof(lines));
+  const int size = static_cast<int>(kScoreFourSize);
+  std::size_t num_lines = 0;
+  for(int dz = -1; dz <= 1; dz++) {
+    for(int dy = -1; dy <= 1; dy++) {
+      for(int dx = -1; dx <= 1; dx++) {
+        if(dz < 0 || (dz == 0 && (dy < 0 || (dy == 0 && dx <= 0)))) {
+          continue;
+        }
+        for(int z = 0; z < size; z++) {
+          for(int y = 0; y < size; y++) {
+            for(int x = 0; x < size; x++) {
+              int last_z = z + dz * (size - 1), last_y = y + dy * (size - 1),
+                  last_x = x + dx * (size - 1);
+              if(last_z < 0 || last_z >= size || last_y < 0 ||
+                 last_y >= size || last_x < 0 || last_x >= size) {
+                continue;
+              }
+              uint64_t line = 0;
+              for(int i = 0; i < size; i++) {
+                line |= 1ULL << ((z + dz * i) * size * size +
+                                 (y + dy * i) * size + x + dx * i);
+              }
+              lines.lines_[num_lines++] = line;
+            }
+          }
+        }
+      }
+    }
+  }
+  assert(num_lines == kScoreFourNumLines);
+  for(std::size_t i = 0; i < kScoreFourNumLines; i++) {
+    for(uint64_t rest = lines.lines_[i]; rest != 0; rest &= rest - 1) {
+      std::size_t cell = __builtin_ctzll(rest);
+      lines.cell_lines_[cell][lines.num_cell_lines_[cell]++] = lines.lines_[i];
+    }
+  }
+  return lines;
+}
+
+const Lines& GetLines() {
+  static const Lines lines = ComputeLines();
+  return lines;
+}
+
+}  // namespace
+
+bool ScoreFourBoard::IsSupported(const std::vector<std::size_t>& dimensions,
+                                 uint8_t num_win_connected,
+                                 std::size_t num_players) {
+  return dimensions.size() == 3 &&
+         std::count(dimensions.begin(), dimensions.end(), kScoreFourSize) ==
+             3 &&
+         num_win_connected == kScoreFourSize && num_players == 2;
+}
+
+ScoreFourBoard::MoveType ScoreFourBoard::GetMove(uint64_t cell) {
+  std::size_t index = __builtin_ctzll(cell);
+  return {index / kLayerCells, index / kScoreFourSize % kScoreFourSize,
+          index % kScoreFourSize};
+}
+
+ScoreFourBoard::ScoreFourBoard()
+    : playable_(0), turn_(0), num_pieces_(0),
+      entries_(new Entry[kBucketSize << kTableBits]),
+      mask_((std::size_t(1) << kTableBits) - 1), age_(0), control_(nullptr),
+      num_nodes_(0), num_evaluations_(0), max_nodes_(0),
+      movetime_(0), iteration_depth_(0), interrupted_(false), root_move_(0),
+      last_score_(0) {
+  pieces_[0] = pieces_[1] = 0;
+  for(std::size_t i = 0; i < kBucketSize * (mask_ + 1); i++) {
+    entries_[i] = Entry{0, 0, 0, 0, Bound::None, 0, 0};
+  }
+  // the bottom layer
+  playable_ = ((1ULL << kLayerCells) - 1) << (kScoreFourNumCells - kLayerCells);
+  GetLines();
+}
+
+bool ScoreFourBoard::SetPosition(const ModelBoard& board) {
+  assert(IsSupported(board.GetDimensions(), board.GetNumWinConnected(),
+                     board.GetPieceIDs().size()));
+  const std::vector<ModelBoard::PieceIDType>& piece_IDs = board.GetPieceIDs();
+  pieces_[0] = pieces_[1] = 0;
+  playable_ = 0;
+  num_pieces_ = 0;
+  turn_ = board.GetNextChipId() == piece_IDs[0] ? 0 : 1;
+  for(std::size_t index = 0; index < kScoreFourNumCells; index++) {
+    ModelBoard::PieceIDType chip = board.GetPiece(GetMove(1ULL << index));
+    if(chip == kEmptyPosition) {
+      continue;
+    }
+    auto it = std::find(piece_IDs.begin(), piece_IDs.end(), chip);
+    if(it == piece_IDs.end()) {
+      return false;
+    }
+    pieces_[it - piece_IDs.begin()] |= 1ULL << index;
+    num_pieces_++;
+  }
+  uint64_t occupied = pieces_[0] | pieces_[1];
+  for(std::size_t column = 0; column < kLayerCells; column++) {
+    for(std::size_t z = kScoreFourSize; z-- > 0;) {
+      uint64_t cell = 1ULL << (z * kLayerCells + column);
+      if((occupied & cell) == 0) {
+        playable_ |= cell;
+        break;
+      }
+    }
+  }
+  return true;
+}
+
+// The cell above a cell is 16 bits lower, there is none above the top layer
+void ScoreFourBoard::Play(uint64_t cell) {
+  assert((playable_ & cell) == cell && cell != 0 && (cell & (cell - 1)) == 0);
+  pieces_[turn_] |= cell;
+  playable_ ^= cell;
+  playable_ |= cell >> kLayerCells;
+  turn_ ^= 1;
+  history_moves_[num_pieces_++] = static_cast<uint8_t>(__builtin_ctzll(cell));
+}
+
+void ScoreFourBoard::Undo() {
+  assert(num_pieces_ > 0);
+  uint64_t cell = 1ULL << history_moves_[--num_pieces_];
+  turn_ ^= 1;
+  pieces_[turn_] ^= cell;
+  playable_ &= ~(cell >> kLayerCells);
+  playable_ |= cell;
+}
+
+bool ScoreFourBoard::IsGameOver() const {
+  if(playable_ == 0) {
+    return true;
+  }
+  const Lines& lines = GetLines();
+  for(uint64_t line : lines.lines_) {
+    if((pieces_[0] & line) == line || (pieces_[1] & line) == line) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// A line is completed by its cell which does not hold a piece of own, if
+// there is a single one and it is empty
+uint64_t ScoreFourBoard::GetWinningCells(uint64_t own, uint64_t other) {
+  const Lines& lines = GetLines();
+  uint64_t cells = 0;
+  for(uint64_t line : lines.lines_) {
+    uint64_t rest = line & ~own;
+    if((rest & (rest - 1)) == 0 && (rest & other) == 0) {
+      cells |= rest;
+    }
+  }
+  return cells;
+}
+
+bool ScoreFourBoard::IsConnected(std::size_t index, uint64_t pieces) {
+  const Lines& lines = GetLines();
+  for(std::size_t i = 0; i < lines.num_cell_lines_[index]; i++) {
+    if((pieces & lines.cell_lines_[index][i]) == lines.cell_lines_[index][i]) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// The lines open to a single player, scored by the number of its pieces
+int ScoreFourBoard::Evaluate() {
+  num_evaluations_++;
+  const Lines& lines = GetLines();
+  uint64_t own = pieces_[turn_], other = pieces_[turn_ ^ 1];
+  int score = 0;
+  for(uint64_t line : lines.lines_) {
+    uint64_t own_line = own & line, other_line = other & line;
+    if(other_line == 0) {
+      score += kLineScores[__builtin_popcountll(own_line)];
+    } else if(own_line == 0) {
+      score -= kLineScores[__builtin_popcountll(other_line)];
+    }
+  }
+  return score;
+}
+
+// The high bits of the pieces (the bottom layer) are folded into the low bits
+// of the index
+static std::size_t GetBucket(uint64_t own, uint64_t other, std::size_t mask) {
+  uint64_t key = own ^ (other * 0x9E3779B97F4A7C15ULL);
+  key ^= key >> 33;
+  key *= 0xFF51AFD7ED558CCDULL;
+  key ^= key >> 33;
+  return static_cast<std::size_t>(key & mask) * kBucketSize;
+}
+
+const ScoreFourBoard::Entry* ScoreFourBoard::Probe(uint64_t own,
+                                                   uint64_t other) const {
+  const Entry* bucket = &entries_[GetBucket(own, other, mask_)];
+  for(std::size_t i = 0; i < kBucketSize; i++) {
+    if(bucket[i].bound_ != Bound::None && bucket[i].own_ == own &&
+       bucket[i].other_ == other) {
+      return &bucket[i];
+    }
+  }
+  return nullptr;
+}
+
+// The first entry is replaced by a deeper search or a newer one, the second
+// one by any other position
+void ScoreFourBoard::Store(const Entry& entry) {
+  Entry* bucket = &entries_[GetBucket(entry.own_, entry.other_, mask_)];
+  if((bucket[0].own_ == entry.own_ && bucket[0].other_ == entry.other_) ||
+     bucket[0].age_ != entry.age_ || bucket[0].depth_ <= entry.depth_) {
+    bucket[0] = entry;
+  } else {
+    bucket[1] = entry;
+  }
+}
+
+std::size_t ScoreFourBoard::OrderMoves(uint64_t moves,
+                                       int table_move,
+                                       std::size_t ply,
+                                       uint8_t* ordered) const {
+  uint32_t keys[kLayerCells];
+  std::size_t num_moves = 0;
+  const Lines& lines = GetLines();
+  for(; moves != 0; moves &= moves - 1) {
+    uint8_t index = static_cast<uint8_t>(__builtin_ctzll(moves));
+    uint32_t key = std::min<uint32_t>(history_[turn_][index], 1u << 24) *
+                       8 +
+                   static_cast<uint32_t>(lines.num_cell_lines_[index]);
+    if(index == table_move) {
+      key = std::numeric_limits<uint32_t>::max();
+    } else if(index == killers_[ply][0]) {
+      key = (1u << 30) + 1;
+    } else if(index == killers_[ply][1]) {
+      key = 1u << 30;
+    }
+    std::size_t i = num_moves++;
+    for(; i > 0 && keys[i - 1] < key; i--) {
+      keys[i] = keys[i - 1];
+      ordered[i] = ordered[i - 1];
+    }
+    keys[i] = key;
+    ordered[i] = index;
+  }
+  return num_moves;
+}
+
+bool ScoreFourBoard::IsInterrupted() {
+  // the first iteration always completes to have a move to play
+  if(interrupted_ || iteration_depth_ <= 1) {
+    return interrupted_;
+  }
+  if(max_nodes_ > 0 && num_nodes_ >= max_nodes_) {
+    interrupted_ = true;
+  } else if((num_nodes_ & kCheckMask) == 0) {
+    auto now = std::chrono::steady_clock::now();
+    if(control_ != nullptr) {
+      interrupted_ = control_->stop_;
+      if(control_->pondering_) {
+        clock_start_ = now;
+      }
+    }
+    if(movetime_.count() > 0 && now - clock_start_ >= movetime_) {
+      interrupted_ = true;
+    }
+  }
+  return interrupted_;
+}
+
+// Principal variation search: the moves after the first one are searched with
+// a null window, and again with the full window if they turn out better
+int ScoreFourBoard::Negamax(int depth, int alpha, int beta, std::size_t ply) {
+  num_nodes_++;
+  if(IsInterrupted()) {
+    return 0;
+  }
+  uint64_t own = pieces_[turn_], other = pieces_[turn_ ^ 1];
+  uint64_t wins = GetWinningCells(own, other) & playable_;
+  if(wins != 0) {
+    if(ply == 0) {
+      root_move_ = static_cast<uint8_t>(__builtin_ctzll(wins));
+    }
+    return kWin - static_cast<int>(ply) - 1;
+  }
+  if(playable_ == 0) {
+    return 0;
+  }
+  uint64_t other_wins = GetWinningCells(other, own);
+  uint64_t moves = playable_;
+  uint64_t blocks = other_wins & playable_;
+  if(blocks != 0) {
+    moves = blocks;
+  }
+  if(ply == 0) {
+    root_move_ = static_cast<uint8_t>(__builtin_ctzll(moves));
+  }
+  // the opponent wins at once after two blocks or a move below its cell
+  moves &= ~(other_wins << kLayerCells);
+  if((blocks & (blocks - 1)) != 0 || moves == 0) {
+    return -(kWin - static_cast<int>(ply) - 2);
+  }
+  if(depth <= 0) {
+    return Evaluate();
+  }
+
+  const Entry* entry = Probe(own, other);
+  int table_move = -1;
+  if(entry != nullptr) {
+    table_move = entry->move_;
+    if(entry->depth_ >= depth && ply > 0) {
+      int score = entry->score_;
+      if(score > kWinBound) {
+        score -= static_cast<int>(ply);
+      } else if(score < -kWinBound) {
+        score += static_cast<int>(ply);
+      }
+      if(entry->bound_ == Bound::Exact ||
+         (entry->bound_ == Bound::Lower && score >= beta) ||
+         (entry->bound_ == Bound::Upper && score <= alpha)) {
+        return score;
+      }
+    }
+  }
+
+  uint8_t ordered[kLayerCells];
+  std::size_t num_moves = OrderMoves(moves, table_move, ply, ordered);
+  int original_alpha = alpha, best_score = -kInfinite;
+  uint8_t best_move = ordered[0];
+  for(std::size_t i = 0; i < num_moves; i++) {
+    Play(1ULL << ordered[i]);
+    int score;
+    if(i == 0) {
+      score = -Negamax(depth - 1, -beta, -alpha, ply + 1);
+    } else {
+      score = -Negamax(depth - 1, -alpha - 1, -alpha, ply + 1);
+      if(score > alpha && score < beta) {
+        score = -Negamax(depth - 1, -beta, -alpha, ply + 1);
+      }
+    }
+    Undo();
+    if(interrupted_) {
+      return 0;
+    }
+    if(score > best_score) {
+      best_score = score;
+      best_move = ordered[i];
+      if(ply == 0) {
+        root_move_ = best_move;
+      }
+    }
+    if(score > alpha) {
+      alpha = score;
+    }
+    if(alpha >= beta) {
+      if(killers_[ply][0] != best_move) {
+        killers_[ply][1] = killers_[ply][0];
+        killers_[ply][0] = best_move;
+      }
+      history_[turn_][best_move] += depth * depth;
+      break;
+    }
+  }
+
+  int stored_score = best_score;
+  if(stored_score > kWinBound) {
+    stored_score += static_cast<int>(ply);
+  } else if(stored_score < -kWinBound) {
+    stored_score -= static_cast<int>(ply);
+  }
+  Bound bound = best_score <= original_alpha
+                    ? Bound::Upper
+                    : (best_score >= beta ? Bound::Lower : Bound::Exact);
+  Store(Entry{own, other, stored_score, static_cast<int8_t>(depth), bound,
+              best_move, age_});
+  return best_score;
+}
+
+// The moves of the table from the root, as long as they are stored
+void ScoreFourBoard::BuildPrincipalVariation(int depth) {
+  principal_variation_.assign(1, GetMove(1ULL << root_move_));
+  Play(1ULL << root_move_);
+  int num_played = 1;
+  while(num_played < depth &&
+        !IsConnected(history_moves_[num_pieces_ - 1], pieces_[turn_ ^ 1])) {
+    uint64_t own = pieces_[turn_], other = pieces_[turn_ ^ 1];
+    const Entry* entry = Probe(own, other);
+    if(entry == nullptr || (playable_ & (1ULL << entry->move_)) == 0) {
+      break;
+    }
+    principal_variation_.push_back(GetMove(1ULL << entry->move_));
+    Play(1ULL << entry->move_);
+    num_played++;
+  }
+  while(num_played-- > 0) {
+    Undo();
+  }
+}
+
+int ScoreFourBoard::GetSearchScore(int score) const {
+  if(score > kWinBound) {
+    return std::numeric_limits<int>::max();
+  } else if(score < -kWinBound) {
+    return -std::numeric_limits<int>::max();
+  }
+  return score;
+}
+
+bool ScoreFourBoard::Search(
+    const SearchLimits& limits,
+    SearchControl* control,
+    const std::function<void(const SearchInfo&)>& info_callback,
+    MoveType& best_move) {
+  principal_variation_.clear();
+  num_nodes_ = 0;
+  num_evaluations_ = 0;
+  last_score_ = 0;
+  if(IsGameOver()) {
+    return false;
+  }
+  control_ = control;
+  max_nodes_ = limits.nodes_;
+  movetime_ = limits.movetime_;
+  interrupted_ = false;
+  age_++;
+  std::memset(killers_, 0xFF, sizeof(killers_));
+  std::memset(history_, 0, sizeof(history_));
+  int depth = static_cast<int>(std::min<std::size_t>(
+      limits.depth_, kScoreFourNumCells - num_pieces_));
+  uint8_t solution = static_cast<uint8_t>(__builtin_ctzll(playable_));
+  auto start = std::chrono::steady_clock::now();
+  clock_start_ = start;
+  for(iteration_depth_ = 1; iteration_depth_ <= depth; ++iteration_depth_) {
+    CONNECTX_TRACE_SCOPE_ARG("ScoreFourIteration", "depth", iteration_depth_);
+    int score = Negamax(iteration_depth_, -kInfinite, kInfinite, 0);
+    if(interrupted_) {
+      break;
+    }
+    solution = root_move_;
+    last_score_ = GetSearchScore(score);
+    BuildPrincipalVariation(iteration_depth_);
+    auto end = std::chrono::steady_clock::now();
+    if(info_callback) {
+      info_callback({static_cast<DepthType>(iteration_depth_), last_score_,
+                     num_nodes_,
+                     std::chrono::duration_cast<std::chrono::milliseconds>(
+                         end - start),
+                     principal_variation_, 0});
+    }
+    if(limits.soft_time_.count() > 0 &&
+       std::chrono::duration_cast<std::chrono::milliseconds>(end - start) >=
+           limits.soft_time_) {
+      break;
+    }
+    // a win or a loss is certain
+    if(score > kWinBound || score < -kWinBound) {
+      break;
+    }
+  }
+  best_move = GetMove(1ULL << solution);
+  return true;
+}
+
+}  // namespace Core
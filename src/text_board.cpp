@@ -7,8 +7,10 @@
 #include <algorithm>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include "cursor_console.h"
 #include "text_board.h"
+#include "trace.h"
 
 namespace UI {
 
@@ -18,18 +20,22 @@ TextBoard::TextBoard(const std::map<int8_t, TextPiece>& chips,
                      const std::string& line_indent)
     : Board<TextPiece>(chips, dimensions)
     , line_length_(0)
-    , line_indent_(line_indent) {
+    , line_indent_(line_indent)
+    , cells_(dimensions[kfirstAxis] * dimensions[kSecondAxis],
+             kPieceEmptyCell)
+    , highlighted_(cells_.size(), false)
+    , view_origin_(kMaxDimensions, 0)
+    , view_size_(dimensions)
+    , compact_(false) {
   assert(dimensions_.size() == kMaxDimensions);
   assert(!chips.empty());
-  h_cell_size_ = chips_.begin()->second.GetSymbol().size() + 1;
-  l_cell_size_ = chips_.begin()->second.GetSymbol()[0].size();
-  empty_cell_string_.resize(l_cell_size_, kEmptyChar);
-  lower_cell_string_.resize(l_cell_size_, kUnderScore);
+  SetCellSizes();
   Clear();
 }
 
 // Prints the board on the console.
 void TextBoard::DrawBoard() {
+  CONNECTX_TRACE_SCOPE("TextBoard::DrawBoard");
   if(previous_.empty()) {
     PrepareCursor();
     UI::WriteToWindow(board_stream_);
@@ -39,6 +45,13 @@ void TextBoard::DrawBoard() {
   }
   std::string current = board_stream_.str();
   if(cursor_.first < std::numeric_limits<int>::max()) {
+    if(current.size() != previous_.size()) {
+      UI::SetCursorPosition(cursor_.first, cursor_.second);
+      UI::WriteToWindow(board_stream_);
+      previous_ = current;
+      UI::RefreshWindow();
+      return;
+    }
     std::size_t x = cursor_.first;
     std::size_t y = cursor_.second;
     for(std::size_t i = 0; i < previous_.size(); i++) {
@@ -69,60 +82,197 @@ void TextBoard::Clear() {
 
 // Clears the board from the console and display an empty board with no pieces.
 void TextBoard::ClearBoard() {
-  ClearBoardStream();
+  std::fill(cells_.begin(), cells_.end(), kPieceEmptyCell);
+  std::fill(highlighted_.begin(), highlighted_.end(), false);
+  RenderViewport();
 }
 
 //Initializes the stream, empty board
 void TextBoard::ClearBoardStream() {
   board_stream_.str("");
+  line_length_ =
+      line_indent_.size() + view_size_[kSecondAxis] * (l_cell_size_ + 1) + 2;
   PrintEmptyLine(kTopMargin);
-  for(std::size_t i = 0; i < dimensions_[kfirstAxis]; i++) {
+  for(std::size_t i = 0; i < view_size_[kfirstAxis]; i++) {
     for(std::size_t j = 0; j < h_cell_size_; j++) {
       board_stream_ << line_indent_;
       PrintLine(j);
     }
   }
-  line_length_ =
-      line_indent_.size() + dimensions_[kSecondAxis] * (l_cell_size_ + 1) + 2;
+}
+
+// Rebuilds the stream from the cells located in the viewport only, the cost
+// is bounded by the size of the viewport and not by the size of the board.
+void TextBoard::RenderViewport() {
+  ClearBoardStream();
+  PrintExtraLines();
+  std::vector<std::size_t> position(kMaxDimensions);
+  for(std::size_t i = 0; i < view_size_[kfirstAxis]; i++) {
+    position[kfirstAxis] = view_origin_[kfirstAxis] + i;
+    for(std::size_t j = 0; j < view_size_[kSecondAxis]; j++) {
+      position[kSecondAxis] = view_origin_[kSecondAxis] + j;
+      if(cells_[GetCellIndex(position)] != kPieceEmptyCell) {
+        WriteCell(position);
+      }
+    }
+  }
+}
+
+void TextBoard::SetCellSizes() {
+  if(compact_) {
+    h_cell_size_ = 1;
+    l_cell_size_ = 1;
+  } else {
+    h_cell_size_ = chips_.begin()->second.GetSymbol().size() + 1;
+    l_cell_size_ = chips_.begin()->second.GetSymbol()[0].size();
+  }
+  empty_cell_string_.assign(l_cell_size_, kEmptyChar);
+  lower_cell_string_.assign(l_cell_size_, kUnderScore);
+}
+
+void TextBoard::FitToWindow(std::size_t max_lines, std::size_t max_columns) {
+  std::size_t grid_lines = 0, grid_columns = 0;
+  for(bool compact : {false, true}) {
+    compact_ = compact;
+    SetCellSizes();
+    std::size_t extra_lines = kTopMargin + GetNumExtraLines();
+    // right border and one spare column so the lines never wrap
+    std::size_t extra_columns = line_indent_.size() + 3;
+    grid_lines = max_lines > extra_lines ? max_lines - extra_lines : 0;
+    grid_columns = max_columns > extra_columns ? max_columns - extra_columns : 0;
+    if(dimensions_[kfirstAxis] * h_cell_size_ <= grid_lines &&
+       dimensions_[kSecondAxis] * (l_cell_size_ + 1) <= grid_columns) {
+      break;
+    }
+  }
+  view_size_[kfirstAxis] = std::max<std::size_t>(
+      1, std::min(dimensions_[kfirstAxis], grid_lines / h_cell_size_));
+  view_size_[kSecondAxis] = std::max<std::size_t>(
+      1, std::min(dimensions_[kSecondAxis], grid_columns / (l_cell_size_ + 1)));
+  std::fill(view_origin_.begin(), view_origin_.end(), 0);
+  previous_.clear();
+  RenderViewport();
+}
+
+void TextBoard::ScrollTo(const std::vector<std::size_t>& model_position) {
+  std::vector<std::size_t> position = GetGridPosition(model_position);
+  assert(position.size() == kMaxDimensions);
+  bool moved = false;
+  for(std::size_t axis = 0; axis < kMaxDimensions; axis++) {
+    if(position[axis] < view_origin_[axis]) {
+      view_origin_[axis] = position[axis];
+      moved = true;
+    } else if(position[axis] >= view_origin_[axis] + view_size_[axis]) {
+      view_origin_[axis] = position[axis] - view_size_[axis] + 1;
+      moved = true;
+    }
+  }
+  if(moved) {
+    RenderViewport();
+  }
+}
+
+void TextBoard::Scroll(long long num_rows, long long num_columns) {
+  const long long deltas[kMaxDimensions] = {num_rows, num_columns};
+  for(std::size_t axis = 0; axis < kMaxDimensions; axis++) {
+    long long max_origin = dimensions_[axis] - view_size_[axis];
+    long long origin = static_cast<long long>(view_origin_[axis]) + deltas[axis];
+    view_origin_[axis] = std::max(0LL, std::min(max_origin, origin));
+  }
+  RenderViewport();
+}
+
+bool TextBoard::IsVisible(const std::vector<std::size_t>& position) const {
+  return IsGridVisible(GetGridPosition(position));
+}
+
+bool TextBoard::IsGridVisible(const std::vector<std::size_t>& position) const {
+  for(std::size_t axis = 0; axis < kMaxDimensions; axis++) {
+    if(position[axis] < view_origin_[axis] ||
+       position[axis] >= view_origin_[axis] + view_size_[axis]) {
+      return false;
+    }
+  }
+  return true;
 }
 
 // Given a position on the board, prints a board with the chip
 // displayed in the cell.
 void TextBoard::SetChip(const std::vector<std::size_t>& position,
                         int8_t piece_ID) {
-  SetChipInc(position, piece_ID);
+  SetChipInc(GetGridPosition(position), piece_ID);
 }
 
-// Draws the piece in the specified location.
+// Stores the piece and draws it if the cell is in the viewport.
 void TextBoard::SetChipInc(const std::vector<std::size_t>& position,
                            int8_t piece_ID) {
   assert(position.size() == kMaxDimensions);
-  board_stream_.seekp(0, board_stream_.beg);
-  std::size_t pos = (position[kfirstAxis] * line_length_ * (h_cell_size_)) +
-                    kTopMargin + 1 + line_indent_.size() +
-                    position[kSecondAxis] * (l_cell_size_ + 1);
-  board_stream_.seekp(pos, board_stream_.beg);
+  std::size_t index = GetCellIndex(position);
+  cells_[index] = piece_ID;
+  if(piece_ID == kPieceEmptyCell) {
+    highlighted_[index] = false;
+  }
+  if(IsGridVisible(position)) {
+    WriteCell(position);
+  }
+}
+
+void TextBoard::SetHighlighted(const std::vector<std::size_t>& position,
+                               bool highlighted) {
+  assert(position.size() == kMaxDimensions);
+  highlighted_[GetCellIndex(position)] = highlighted;
+  if(IsGridVisible(position)) {
+    WriteCell(position);
+  }
+}
+
+// Offset in the stream of the top left character of a visible cell
+std::size_t TextBoard::GetStreamOffset(
+    const std::vector<std::size_t>& position) const {
+  return ((position[kfirstAxis] - view_origin_[kfirstAxis]) * line_length_ *
+          h_cell_size_) +
+         kTopMargin + 1 + line_indent_.size() +
+         (position[kSecondAxis] - view_origin_[kSecondAxis]) *
+             (l_cell_size_ + 1);
+}
+
+// Draws the piece of a visible cell in the stream.
+// A highlighted cell has its background dotted, in compact mode the border on
+// its left is dotted instead.
+void TextBoard::WriteCell(const std::vector<std::size_t>& position) {
+  std::size_t index = GetCellIndex(position);
+  std::size_t pos = GetStreamOffset(position);
+  if(compact_) {
+    board_stream_.seekp(pos - 1, board_stream_.beg);
+    board_stream_ << (highlighted_[index] ? kDotChar : kVerticalLine);
+  } else {
+    board_stream_.seekp(pos, board_stream_.beg);
+  }
 
-  if(piece_ID != kPieceEmptyCell) {
+  std::map<int8_t, TextPiece>::const_iterator it = chips_.find(cells_[index]);
+  if(it == chips_.end()) {
+    WriteToCell(compact_ ? lower_cell_string_ : empty_cell_string_);
+  } else if(compact_) {
+    board_stream_ << it->second.GetCompactSymbol();
+  } else {
     // once the cell is identified in the stream, the next step
     // is to print the piece's symbol, line by line
-    std::map<int8_t, TextPiece>::const_iterator it = chips_.find(piece_ID);
-    if(it != chips_.end()) {
-      auto vector_string = it->second.GetSymbol();
-      for(std::size_t i = 0; i < vector_string.size(); i++) {
-        board_stream_ << vector_string[i];
-        board_stream_.seekp(line_length_ - l_cell_size_, board_stream_.cur);
+    std::string line;
+    for(const std::string& symbol_line : it->second.GetSymbol()) {
+      line = symbol_line;
+      if(highlighted_[index]) {
+        std::replace(line.begin(), line.end(), kEmptyChar, kDotChar);
       }
+      board_stream_ << line;
+      board_stream_.seekp(line_length_ - l_cell_size_, board_stream_.cur);
     }
-  } else {
-    WriteToCell(empty_cell_string_);
   }
 }
 
 // Write a string in the cell, line by line
 void TextBoard::WriteToCell(const std::string& str) {
   assert(str.size() == l_cell_size_);
-  for(std::size_t i = 1; i < h_cell_size_; i++) {
+  for(std::size_t i = 1; i < std::max<std::size_t>(h_cell_size_, 2); i++) {
     board_stream_ << str;
     // positioning the cursor to the next line
     board_stream_.seekp(line_length_ - l_cell_size_, board_stream_.cur);
@@ -132,12 +282,12 @@ void TextBoard::WriteToCell(const std::string& str) {
 // Drawing a single line of the board given the coordinates (cline)
 void TextBoard::PrintLine(std::size_t cline) {
   if(cline < h_cell_size_ - 1) {
-    for(std::size_t k = 0; k < dimensions_[kSecondAxis]; k++) {
+    for(std::size_t k = 0; k < view_size_[kSecondAxis]; k++) {
       board_stream_ << kVerticalLine << empty_cell_string_;
     }
   } else {
     // If last line, the bottom border is printed |______.
-    for(std::size_t k = 0; k < dimensions_[kSecondAxis]; k++) {
+    for(std::size_t k = 0; k < view_size_[kSecondAxis]; k++) {
       board_stream_ << kVerticalLine << lower_cell_string_;
     }
   }
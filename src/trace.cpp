@@ -0,0 +1,129 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Scoped trace spans written as Chrome trace events.
+//============================================================================
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "trace.h"
+
+namespace Core {
+
+const std::size_t kTraceBufferEvents = 1 << 16;
+
+namespace {
+
+// Written by its thread only, the size is published after the event so the
+// events can be read while the thread records more.
+struct TraceBuffer {
+  TraceBuffer() : events_(kTraceBufferEvents), size_(0), dropped_(0) {}
+
+  std::vector<TraceEvent> events_;
+  std::atomic<std::size_t> size_;
+  std::atomic<std::size_t> dropped_;
+};
+
+struct TraceBuffers {
+  std::mutex mutex_;
+  // in the order of the first event of the threads
+  std::vector<std::unique_ptr<TraceBuffer>> buffers_;
+};
+
+TraceBuffers& GetTraceBuffers() {
+  static TraceBuffers buffers;
+  return buffers;
+}
+
+// The buffer of the thread is created and registered by its first event
+TraceBuffer& GetThreadBuffer() {
+  static thread_local TraceBuffer* buffer = nullptr;
+  if(buffer == nullptr) {
+    TraceBuffers& buffers = GetTraceBuffers();
+    std::lock_guard<std::mutex> lock(buffers.mutex_);
+    buffers.buffers_.push_back(std::unique_ptr<TraceBuffer>(new TraceBuffer));
+    buffer = buffers.buffers_.back().get();
+  }
+  return *buffer;
+}
+
+void WriteJsonString(std::ostream& output, const char* text) {
+  output << '"';
+  for(; *text != '\0'; text++) {
+    if(*text == '"' || *text == '\\') {
+      output << '\\';
+    }
+    output << *text;
+  }
+  output << '"';
+}
+
+}  // namespace
+
+int64_t Tracer::Now() {
+  static const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+void Tracer::Record(const TraceEvent& event) {
+  TraceBuffer& buffer = GetThreadBuffer();
+  std::size_t size = buffer.size_.load(std::memory_order_relaxed);
+  if(size == buffer.events_.size()) {
+    buffer.dropped_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  buffer.events_[size] = event;
+  buffer.size_.store(size + 1, std::memory_order_release);
+}
+
+std::string Tracer::GetOutputPath() {
+  const char* path = std::getenv(kTraceFileVariable);
+  return path != nullptr && *path != '\0' ? path : kDefaultTraceFile;
+}
+
+bool Tracer::WriteChromeTrace(const std::string& path) {
+  std::ofstream output(path);
+  TraceBuffers& buffers = GetTraceBuffers();
+  std::lock_guard<std::mutex> lock(buffers.mutex_);
+  output << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+  const char* separator = "\n";
+  for(std::size_t thread = 0; thread < buffers.buffers_.size(); thread++) {
+    const TraceBuffer& buffer = *buffers.buffers_[thread];
+    output << separator << "{\"name\": \"thread_name\", \"ph\": \"M\", "
+           << "\"pid\": 1, \"tid\": " << thread + 1
+           << ", \"args\": {\"name\": \"thread " << thread + 1;
+    std::size_t dropped = buffer.dropped_.load(std::memory_order_relaxed);
+    if(dropped > 0) {
+      output << " (" << dropped << " events dropped)";
+    }
+    output << "\"}}";
+    separator = ",\n";
+    std::size_t size = buffer.size_.load(std::memory_order_acquire);
+    for(std::size_t i = 0; i < size; i++) {
+      const TraceEvent& event = buffer.events_[i];
+      output << separator << "{\"name\": ";
+      WriteJsonString(output, event.name_);
+      output << ", \"cat\": \"connectx\", \"ph\": \"X\", \"pid\": 1, "
+             << "\"tid\": " << thread + 1 << ", \"ts\": " << event.start_
+             << ", \"dur\": " << event.duration_;
+      if(event.arg_name_ != nullptr) {
+        output << ", \"args\": {";
+        WriteJsonString(output, event.arg_name_);
+        output << ": " << event.arg_ << "}";
+      }
+      output << "}";
+    }
+  }
+  output << "\n]}" << std::endl;
+  return static_cast<bool>(output);
+}
+
+}  // namespace Core
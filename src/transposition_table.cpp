@@ -0,0 +1,245 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Transposition table shared by concurrent searches.
+//============================================================================
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include "transposition_table.h"
+
+namespace Core {
+
+// slots written to a table file at once
+static const std::size_t kTableFileChunkSlots = 4096;
+
+// data: score (32 bits), depth (8 bits), bound (8 bits), move (16 bits)
+static uint64_t PackEntry(const TableEntry& entry) {
+  return static_cast<uint64_t>(static_cast<uint32_t>(entry.score_)) |
+         static_cast<uint64_t>(static_cast<uint8_t>(entry.depth_)) << 32 |
+         static_cast<uint64_t>(entry.bound_) << 40 |
+         static_cast<uint64_t>(entry.move_) << 48;
+}
+
+static void UnpackEntry(uint64_t data, TableEntry& entry) {
+  entry.score_ = static_cast<int32_t>(static_cast<uint32_t>(data));
+  entry.depth_ = static_cast<int8_t>(data >> 32);
+  entry.bound_ = static_cast<Bound>(static_cast<uint8_t>(data >> 40));
+  entry.move_ = static_cast<uint16_t>(data >> 48);
+}
+
+std::string GetTableFileName(const TableFileShape& shape) {
+  std::ostringstream name;
+  for(std::size_t i = 0; i < shape.dimensions_.size(); i++) {
+    name << (i > 0 ? "x" : "") << shape.dimensions_[i];
+  }
+  name << '-' << static_cast<int>(shape.num_win_connected_) << '-'
+       << static_cast<int>(shape.num_players_);
+  if(shape.evaluation_key_ != 0) {
+    name << '-' << std::hex << std::setw(16) << std::setfill('0')
+         << shape.evaluation_key_;
+  }
+  name << kTableFileExtension;
+  return name.str();
+}
+
+static bool HasShape(const TableFileHeader& header,
+                     const TableFileShape& shape) {
+  if(std::memcmp(header.magic_, kTableFileMagic, sizeof(kTableFileMagic)) ||
+     header.version_ != kTableFileVersion ||
+     header.num_dimensions_ != shape.dimensions_.size() ||
+     header.num_win_connected_ != shape.num_win_connected_ ||
+     header.num_players_ != shape.num_players_ ||
+     header.multi_player_search_ != shape.multi_player_search_ ||
+     header.evaluation_key_ != shape.evaluation_key_) {
+    return false;
+  }
+  for(std::size_t i = 0; i < shape.dimensions_.size(); i++) {
+    if(header.dimensions_[i] != shape.dimensions_[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool WriteAll(int file, const void* data, std::size_t size) {
+  const char* bytes = static_cast<const char*>(data);
+  while(size > 0) {
+    ssize_t written = write(file, bytes, size);
+    if(written <= 0) {
+      return false;
+    }
+    bytes += written;
+    size -= written;
+  }
+  return true;
+}
+
+// The number of slots is the largest power of two that fits
+TranspositionTable::TranspositionTable(std::size_t num_megabytes)
+    : slots_(nullptr), mapping_(nullptr), mapping_length_(0) {
+  static_assert(sizeof(Slot) == 2 * sizeof(uint64_t),
+                "the slots of the table files are two words");
+  std::size_t num_slots = 1;
+  while(num_slots * 2 * sizeof(Slot) <= (num_megabytes << 20)) {
+    num_slots *= 2;
+  }
+  heap_slots_.reset(new Slot[num_slots]);
+  slots_ = heap_slots_.get();
+  mask_ = num_slots - 1;
+  Clear();
+}
+
+TranspositionTable::~TranspositionTable() {
+  Unmap();
+}
+
+void TranspositionTable::Unmap() {
+  if(mapping_ != nullptr) {
+    munmap(mapping_, mapping_length_);
+  }
+  mapping_ = nullptr;
+  mapping_length_ = 0;
+}
+
+void TranspositionTable::Clear() {
+  if(mapping_ != nullptr) {
+    Unmap();
+    heap_slots_.reset(new Slot[mask_ + 1]);
+    slots_ = heap_slots_.get();
+  }
+  for(std::size_t i = 0; i <= mask_; i++) {
+    slots_[i].check_.store(0, std::memory_order_relaxed);
+    slots_[i].data_.store(0, std::memory_order_relaxed);
+  }
+}
+
+bool TranspositionTable::Probe(uint64_t key, TableEntry& entry) const {
+  const Slot& slot = slots_[key & mask_];
+  uint64_t data = slot.data_.load(std::memory_order_relaxed);
+  if((slot.check_.load(std::memory_order_relaxed) ^ data) != key) {
+    return false;
+  }
+  UnpackEntry(data, entry);
+  return entry.bound_ != Bound::None;
+}
+
+void TranspositionTable::Store(uint64_t key, const TableEntry& entry) {
+  Slot& slot = slots_[key & mask_];
+  uint64_t data = PackEntry(entry);
+  slot.check_.store(key ^ data, std::memory_order_relaxed);
+  slot.data_.store(data, std::memory_order_relaxed);
+}
+
+bool TranspositionTable::Load(const std::string& path,
+                              const TableFileShape& shape) {
+  int file = open(path.c_str(), O_RDONLY);
+  if(file < 0) {
+    return false;
+  }
+  struct stat file_stat;
+  TableFileHeader header;
+  if(fstat(file, &file_stat) != 0 ||
+     pread(file, &header, sizeof(header), 0) != sizeof(header) ||
+     !HasShape(header, shape) || header.num_slots_ == 0 ||
+     (header.num_slots_ & (header.num_slots_ - 1)) != 0 ||
+     static_cast<std::size_t>(file_stat.st_size) !=
+         sizeof(header) + header.num_slots_ * sizeof(Slot)) {
+    close(file);
+    return false;
+  }
+  std::size_t length = file_stat.st_size;
+  // private, the stores of the searches are not written to the file
+  void* address = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                       file, 0);
+  close(file);
+  if(address == MAP_FAILED) {
+    return false;
+  }
+  Slot* file_slots = reinterpret_cast<Slot*>(static_cast<char*>(address) +
+                                             sizeof(TableFileHeader));
+  if(header.num_slots_ == GetNumSlots()) {
+    Unmap();
+    heap_slots_.reset();
+    slots_ = file_slots;
+    mapping_ = address;
+    mapping_length_ = length;
+    // the slots are probed in a random order
+    madvise(address, length, MADV_RANDOM);
+    return true;
+  }
+  // the entries move to the slots of their keys in this table
+  Clear();
+  for(std::size_t i = 0; i < header.num_slots_; i++) {
+    uint64_t data = file_slots[i].data_.load(std::memory_order_relaxed);
+    TableEntry entry;
+    UnpackEntry(data, entry);
+    if(entry.bound_ != Bound::None) {
+      Store(file_slots[i].check_.load(std::memory_order_relaxed) ^ data,
+            entry);
+    }
+  }
+  munmap(address, length);
+  return true;
+}
+
+bool TranspositionTable::Save(const std::string& path,
+                              const TableFileShape& shape,
+                              int8_t min_depth) const {
+  assert(shape.dimensions_.size() <= kTableFileMaxDimensions);
+  TableFileHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic_, kTableFileMagic, sizeof(kTableFileMagic));
+  header.version_ = kTableFileVersion;
+  header.num_dimensions_ = shape.dimensions_.size();
+  header.num_win_connected_ = shape.num_win_connected_;
+  for(std::size_t i = 0; i < shape.dimensions_.size(); i++) {
+    header.dimensions_[i] = shape.dimensions_[i];
+  }
+  header.num_players_ = shape.num_players_;
+  header.multi_player_search_ = shape.multi_player_search_;
+  header.evaluation_key_ = shape.evaluation_key_;
+  header.num_slots_ = GetNumSlots();
+  // every process writes its own file before it replaces the table file
+  std::string temporary_path = path + ".tmp" + std::to_string(getpid());
+  int file = open(temporary_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if(file < 0) {
+    return false;
+  }
+  bool written = WriteAll(file, &header, sizeof(header));
+  std::vector<uint64_t> words;
+  words.reserve(2 * kTableFileChunkSlots);
+  for(std::size_t i = 0; written && i <= mask_; i++) {
+    uint64_t check = slots_[i].check_.load(std::memory_order_relaxed);
+    uint64_t data = slots_[i].data_.load(std::memory_order_relaxed);
+    TableEntry entry;
+    UnpackEntry(data, entry);
+    if(entry.bound_ == Bound::None || entry.depth_ < min_depth) {
+      check = 0;
+      data = 0;
+    }
+    words.push_back(check);
+    words.push_back(data);
+    if(words.size() == words.capacity() || i == mask_) {
+      written = WriteAll(file, words.data(), words.size() * sizeof(uint64_t));
+      words.clear();
+    }
+  }
+  if(close(file) != 0) {
+    written = false;
+  }
+  if(!written || std::rename(temporary_path.c_str(), path.c_str()) != 0) {
+    unlink(temporary_path.c_str());
+    return false;
+  }
+  return true;
+}
+
+}  // namespace Core
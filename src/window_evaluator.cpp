@@ -0,0 +1,346 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Evaluation of a board line by line with bit masks computed
+//               with SIMD instructions.
+//============================================================================
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include "multi_dim_array.h"
+#include "window_evaluator.h"
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CONNECTX_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace Core {
+
+const std::size_t kMaxLineSize = 64;
+const std::size_t kMinSlotSize = 8;
+const std::size_t kWordBits = 64;
+
+namespace {
+
+// Sets the bit i of masks[value * num_words + i / 64] when bytes[i] equals
+// values[value]
+typedef void (*MaskFunction)(const int8_t* bytes,
+                             std::size_t num_words,
+                             const int8_t* values,
+                             std::size_t num_values,
+                             uint64_t* masks);
+
+void ComputeMasksScalar(const int8_t* bytes,
+                        std::size_t num_words,
+                        const int8_t* values,
+                        std::size_t num_values,
+                        uint64_t* masks) {
+  for(std::size_t word = 0; word < num_words; word++) {
+    const int8_t* word_bytes = bytes + word * kWordBits;
+    for(std::size_t value = 0; value < num_values; value++) {
+      uint64_t mask = 0;
+      for(std::size_t bit = 0; bit < kWordBits; bit++) {
+        mask |= static_cast<uint64_t>(word_bytes[bit] == values[value]) << bit;
+      }
+      masks[value * num_words + word] = mask;
+    }
+  }
+}
+
+#ifdef CONNECTX_X86_SIMD
+__attribute__((target("sse2"))) void ComputeMasksSse2(
+    const int8_t* bytes,
+    std::size_t num_words,
+    const int8_t* values,
+    std::size_t num_values,
+    uint64_t* masks) {
+  for(std::size_t word = 0; word < num_words; word++) {
+    const __m128i* chunks =
+        reinterpret_cast<const __m128i*>(bytes + word * kWordBits);
+    __m128i chunk[4] = {
+        _mm_loadu_si128(chunks), _mm_loadu_si128(chunks + 1),
+        _mm_loadu_si128(chunks + 2), _mm_loadu_si128(chunks + 3)};
+    for(std::size_t value = 0; value < num_values; value++) {
+      __m128i repeated = _mm_set1_epi8(values[value]);
+      uint64_t mask = 0;
+      for(int i = 0; i < 4; i++) {
+        mask |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(
+                    _mm_cmpeq_epi8(chunk[i], repeated))))
+                << (16 * i);
+      }
+      masks[value * num_words + word] = mask;
+    }
+  }
+}
+
+__attribute__((target("avx2"))) void ComputeMasksAvx2(
+    const int8_t* bytes,
+    std::size_t num_words,
+    const int8_t* values,
+    std::size_t num_values,
+    uint64_t* masks) {
+  for(std::size_t word = 0; word < num_words; word++) {
+    const __m256i* chunks =
+        reinterpret_cast<const __m256i*>(bytes + word * kWordBits);
+    __m256i low = _mm256_loadu_si256(chunks);
+    __m256i high = _mm256_loadu_si256(chunks + 1);
+    for(std::size_t value = 0; value < num_values; value++) {
+      __m256i repeated = _mm256_set1_epi8(values[value]);
+      uint32_t low_mask = static_cast<uint32_t>(
+          _mm256_movemask_epi8(_mm256_cmpeq_epi8(low, repeated)));
+      uint32_t high_mask = static_cast<uint32_t>(
+          _mm256_movemask_epi8(_mm256_cmpeq_epi8(high, repeated)));
+      masks[value * num_words + word] =
+          low_mask | static_cast<uint64_t>(high_mask) << 32;
+    }
+  }
+}
+#endif
+
+MaskFunction GetMaskFunction(InstructionSet instruction_set) {
+#ifdef CONNECTX_X86_SIMD
+  if(instruction_set == InstructionSet::Avx2) {
+    return ComputeMasksAvx2;
+  } else if(instruction_set == InstructionSet::Sse2) {
+    return ComputeMasksSse2;
+  }
+#endif
+  return ComputeMasksScalar;
+}
+
+// bits from first to last included
+inline uint64_t GetRangeMask(unsigned first, unsigned last) {
+  uint64_t high = last >= kWordBits - 1 ? ~0ULL : (1ULL << (last + 1)) - 1;
+  return high & (~0ULL << first);
+}
+
+inline uint64_t ShiftRight(uint64_t bits, unsigned shift) {
+  return shift >= kWordBits ? 0 : bits >> shift;
+}
+
+// true if a pattern of the given size starts between start and end
+inline bool HasPattern(uint64_t starts,
+                       unsigned size,
+                       unsigned start,
+                       unsigned end) {
+  return end + 1 >= start + size &&
+         (starts & GetRangeMask(start, end + 1 - size)) != 0;
+}
+
+}  // namespace
+
+WindowEvaluator::WindowEvaluator(const std::vector<std::size_t>& dimensions,
+                                 const std::list<DirectionType>& directions,
+                                 uint8_t num_win_connected,
+                                 const std::vector<PieceIDType>& piece_IDs,
+                                 int win_score,
+                                 int threat_score)
+    : num_win_connected_(num_win_connected),
+      piece_IDs_(piece_IDs),
+      win_score_(win_score),
+      threat_score_(threat_score),
+      instruction_set_(GetBestInstructionSet()),
+      slot_size_(kMinSlotSize),
+      num_lines_(0),
+      padding_(std::numeric_limits<int8_t>::min()) {
+  assert(IsSupported(dimensions, num_win_connected));
+  while(slot_size_ < *std::max_element(dimensions.begin(), dimensions.end())) {
+    slot_size_ *= 2;
+  }
+  while(std::find(piece_IDs_.begin(), piece_IDs_.end(), padding_) !=
+        piece_IDs_.end()) {
+    padding_++;
+  }
+  values_.push_back(kEmptyPosition);
+  values_.insert(values_.end(), piece_IDs_.begin(), piece_IDs_.end());
+  MultiDimArray<PieceIDType> layout(dimensions);
+  for(const DirectionType& direction : directions) {
+    ModelBoard::MoveType cell(dimensions.size(), 0);
+    do {
+      // a line starts at a cell whose previous cell is outside the board
+      bool is_start = false;
+      for(std::size_t axis = 0; axis < dimensions.size(); axis++) {
+        SSizeT previous = static_cast<SSizeT>(cell[axis]) - direction[axis];
+        if(previous < 0 || previous >= static_cast<SSizeT>(dimensions[axis])) {
+          is_start = true;
+        }
+      }
+      if(!is_start) {
+        continue;
+      }
+      ModelBoard::MoveType position = cell;
+      bool inside = true;
+      for(std::size_t index = 0; inside; index++) {
+        byte_indexes_.push_back(num_lines_ * slot_size_ + index);
+        cell_offsets_.push_back(layout.GetOffset(position));
+        for(std::size_t axis = 0; axis < dimensions.size() && inside; axis++) {
+          SSizeT next = static_cast<SSizeT>(position[axis]) + direction[axis];
+          inside = next >= 0 && next < static_cast<SSizeT>(dimensions[axis]);
+          position[axis] = static_cast<std::size_t>(next);
+        }
+      }
+      num_lines_++;
+    } while(ModelBoard::NextCoordinates(dimensions, cell));
+  }
+  num_bytes_ = (num_lines_ * slot_size_ + kWordBits - 1) / kWordBits *
+               kWordBits;
+}
+
+bool WindowEvaluator::IsSupported(const std::vector<std::size_t>& dimensions,
+                                  uint8_t num_win_connected) {
+  return !dimensions.empty() && num_win_connected >= 2 &&
+         *std::max_element(dimensions.begin(), dimensions.end()) <=
+             kMaxLineSize;
+}
+
+InstructionSet WindowEvaluator::GetBestInstructionSet() {
+  static const InstructionSet best =
+      IsAvailable(InstructionSet::Avx2)
+          ? InstructionSet::Avx2
+          : (IsAvailable(InstructionSet::Sse2) ? InstructionSet::Sse2
+                                               : InstructionSet::Scalar);
+  return best;
+}
+
+bool WindowEvaluator::IsAvailable(InstructionSet instruction_set) {
+  switch(instruction_set) {
+#ifdef CONNECTX_X86_SIMD
+    case InstructionSet::Avx2:
+      return __builtin_cpu_supports("avx2");
+    case InstructionSet::Sse2:
+      return __builtin_cpu_supports("sse2");
+#endif
+    case InstructionSet::Scalar:
+      return true;
+    default:
+      return false;
+  }
+}
+
+const char* WindowEvaluator::GetName(InstructionSet instruction_set) {
+  switch(instruction_set) {
+    case InstructionSet::Avx2:
+      return "avx2";
+    case InstructionSet::Sse2:
+      return "sse2";
+    default:
+      return "scalar";
+  }
+}
+
+void WindowEvaluator::SetInstructionSet(InstructionSet instruction_set) {
+  assert(IsAvailable(instruction_set));
+  instruction_set_ = instruction_set;
+}
+
+int WindowEvaluator::Evaluate(const PieceIDType* cells,
+                              PieceIDType maximizing_chip,
+                              PieceIDType next_chip,
+                              Scratch& scratch) const {
+  const std::size_t num_words = num_bytes_ / kWordBits;
+  if(scratch.bytes_.size() != num_bytes_) {
+    scratch.bytes_.assign(num_bytes_, padding_);
+    scratch.masks_.resize(values_.size() * num_words);
+  }
+  int8_t* bytes = scratch.bytes_.data();
+  for(std::size_t i = 0; i < byte_indexes_.size(); i++) {
+    bytes[byte_indexes_[i]] = cells[cell_offsets_[i]];
+  }
+  GetMaskFunction(instruction_set_)(bytes, num_words, values_.data(),
+                                    values_.size(), scratch.masks_.data());
+
+  const uint64_t slot_mask =
+      slot_size_ == kWordBits ? ~0ULL : (1ULL << slot_size_) - 1;
+  const uint64_t* empty_masks = scratch.masks_.data();
+  int score = 0;
+  for(std::size_t player = 0; player < piece_IDs_.size(); player++) {
+    const uint64_t* own_masks = empty_masks + (player + 1) * num_words;
+    bool is_next = piece_IDs_[player] == next_chip;
+    int player_score = 0;
+    for(std::size_t line = 0; line < num_lines_; line++) {
+      std::size_t bit = line * slot_size_;
+      uint64_t own = (own_masks[bit / kWordBits] >> bit % kWordBits) &
+                     slot_mask;
+      if(own != 0) {
+        uint64_t empty = (empty_masks[bit / kWordBits] >> bit % kWordBits) &
+                         slot_mask;
+        player_score += ScoreLine(own, empty, is_next);
+      }
+    }
+    score += piece_IDs_[player] == maximizing_chip ? player_score
+                                                   : -player_score;
+  }
+  return score;
+}
+
+// Follows IntelligentBoard::ScorePatterns, a window is scored once
+int WindowEvaluator::ScoreLine(uint64_t own,
+                               uint64_t empty,
+                               bool is_next) const {
+  const unsigned num_connected = num_win_connected_;
+  const uint64_t blocked = ~(own | empty);
+  const uint64_t not_empty = ~empty;
+  // where the patterns of IntelligentBoard::GetPatterns start
+  uint64_t open_row = empty & ShiftRight(empty, num_connected);
+  uint64_t split_row = own & ShiftRight(empty, 1) &
+                       ShiftRight(empty, num_connected) &
+                       ShiftRight(own, num_connected + 1);
+  uint64_t split_middle = ShiftRight(empty, num_connected - 2) &
+                          ShiftRight(own, num_connected - 1) &
+                          ShiftRight(empty, num_connected);
+  for(unsigned i = 1; i < num_connected; i++) {
+    open_row &= ShiftRight(own, i);
+  }
+  for(unsigned i = 2; i < num_connected; i++) {
+    split_row &= ShiftRight(own, i);
+  }
+  for(unsigned i = 0; i + 2 < num_connected; i++) {
+    split_middle &= ShiftRight(own, i) &
+                    ShiftRight(own, num_connected + 1 + i);
+  }
+
+  int score = 0;
+  uint64_t pieces = own;
+  while(pieces != 0) {
+    unsigned first = __builtin_ctzll(pieces), last = first;
+    uint64_t rest = pieces & (pieces - 1);
+    while(rest != 0) {
+      unsigned next = __builtin_ctzll(rest);
+      if(next - last > num_connected ||
+         (next > last + 1 &&
+          (blocked & GetRangeMask(last + 1, next - 1)) != 0)) {
+        break;
+      }
+      last = next;
+      rest &= rest - 1;
+    }
+    int num_pieces = __builtin_popcountll(own & GetRangeMask(first, last));
+    uint64_t below = not_empty & ((1ULL << first) - 1);
+    unsigned lead = below == 0 ? first : first - (63 - __builtin_clzll(below)) - 1;
+    uint64_t above = last == kWordBits - 1 ? 0 : not_empty & (~0ULL << (last + 1));
+    unsigned trail =
+        above == 0 ? kWordBits - 1 - last : __builtin_ctzll(above) - last - 1;
+    unsigned start = first - std::min(lead, num_connected - 1);
+    unsigned end = last + std::min(trail, num_connected - 1);
+
+    int window = num_pieces;
+    if(end - start + 1 >= num_connected) {
+      if(num_pieces + 1 >= static_cast<int>(num_connected) &&
+         (HasPattern(open_row, num_connected + 1, start, end) ||
+          HasPattern(split_row, num_connected + 2, start, end) ||
+          HasPattern(split_middle, 2 * num_connected - 1, start, end))) {
+        window = win_score_;
+      } else if(num_pieces + 1 >= static_cast<int>(num_connected) && is_next) {
+        window = threat_score_;
+      } else {
+        window *= num_connected;
+      }
+    }
+    score += window;
+    pieces &= ~GetRangeMask(first, last);
+  }
+  return score;
+}
+
+}  // namespace Core
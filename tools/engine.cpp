@@ -0,0 +1,25 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Plays the AI through a text protocol on the standard input
+//               and output (see engine.h).
+//============================================================================
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "engine.h"
+#include "trace.h"
+
+int main() {
+  Core::Engine engine(std::cout);
+  std::string command;
+  while(std::getline(std::cin, command)) {
+    if(!engine.Execute(command)) {
+      break;
+    }
+  }
+  engine.Finish();
+  CONNECTX_TRACE_WRITE();
+  return EXIT_SUCCESS;
+}
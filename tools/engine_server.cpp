@@ -0,0 +1,79 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Serves the AI to many games over a Unix domain socket.
+//               engine_server <socket> [workers] [megabytes per variant]
+//                             [default budget ms] [max budget ms]
+//                             [table directory] [read-only tables 0|1]
+//                             [variants]
+//============================================================================
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include "engine_server.h"
+
+namespace {
+
+const char kUsageMsg[] = "usage: engine_server <socket> [workers]"
+                         " [megabytes per variant] [default budget ms]"
+                         " [max budget ms] [table directory]"
+                         " [read-only tables 0|1] [variants]";
+
+Core::EngineServer* server = nullptr;
+
+void StopServer(int) {
+  server->Shutdown();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if(argc < 2) {
+    std::cerr << kUsageMsg << std::endl;
+    return EXIT_FAILURE;
+  }
+  Core::ServerOptions options;
+  options.num_workers_ = std::max(std::thread::hardware_concurrency(), 1u);
+  if(argc > 2) {
+    options.num_workers_ = std::atol(argv[2]);
+  }
+  if(argc > 3) {
+    options.table_megabytes_ = std::atol(argv[3]);
+  }
+  if(argc > 4) {
+    options.default_budget_ = std::chrono::milliseconds(std::atol(argv[4]));
+  }
+  if(argc > 5) {
+    options.max_budget_ = std::chrono::milliseconds(std::atol(argv[5]));
+  }
+  if(argc > 6) {
+    options.table_directory_ = argv[6];
+  }
+  if(argc > 7) {
+    options.table_read_only_ = std::atol(argv[7]) != 0;
+  }
+  if(argc > 8) {
+    options.max_variants_ = std::atol(argv[8]);
+  }
+  if(options.num_workers_ == 0 || options.table_megabytes_ == 0 ||
+     options.max_variants_ == 0 ||
+     options.default_budget_.count() <= 0 ||
+     options.max_budget_.count() <= 0) {
+    std::cerr << kUsageMsg << std::endl;
+    return EXIT_FAILURE;
+  }
+  Core::EngineServer engine_server(options);
+  if(!engine_server.Listen(argv[1])) {
+    std::cerr << "cannot listen on " << argv[1] << std::endl;
+    return EXIT_FAILURE;
+  }
+  server = &engine_server;
+  std::signal(SIGINT, StopServer);
+  std::signal(SIGTERM, StopServer);
+  std::cout << "listening on " << argv[1] << " with " << options.num_workers_
+            << " workers" << std::endl;
+  engine_server.Run();
+  return EXIT_SUCCESS;
+}
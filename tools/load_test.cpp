@@ -0,0 +1,235 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Plays concurrent games against the engine server and reports
+//               the latency of the moves.
+//               load_test <socket> [games] [requests] [movetime ms] [variant]
+//============================================================================
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "engine.h"
+
+using namespace Core;
+
+namespace {
+
+const char kUsageMsg[] = "usage: load_test <socket> [games] [requests]"
+                         " [movetime ms] [variant]";
+// the first moves of a game are random so the games differ
+const std::size_t kRandomMoves = 2;
+
+struct Game {
+  int socket_ = -1;
+  std::string input_;
+  std::string moves_;
+  std::size_t num_moves_ = 0;
+  std::chrono::steady_clock::time_point sent_;
+};
+
+int Connect(const std::string& path) {
+  sockaddr_un address;
+  std::memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+  int socket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if(socket >= 0 && connect(socket, reinterpret_cast<sockaddr*>(&address),
+                            sizeof(address)) < 0) {
+    close(socket);
+    return -1;
+  }
+  return socket;
+}
+
+bool SendLine(int socket, const std::string& line) {
+  std::string data = line + '\n';
+  return send(socket, data.data(), data.size(), MSG_NOSIGNAL) ==
+         static_cast<ssize_t>(data.size());
+}
+
+class LoadTest {
+ public:
+  LoadTest(const Position& variant, long movetime)
+      : variant_(variant), movetime_(movetime), random_(std::random_device()()) {
+  }
+
+  bool Run(const std::string& path, std::size_t num_games,
+           std::size_t num_requests, const std::string& variant_text);
+  void Report(std::ostream& output) const;
+
+ private:
+  bool SendRequest(Game& game);
+  bool ReadLines(Game& game);
+  std::string GetRandomMove();
+
+  Position variant_;
+  long movetime_;
+  std::mt19937 random_;
+  std::vector<Game> games_;
+  std::size_t num_sent_ = 0;
+  std::size_t num_requests_ = 0;
+  std::size_t num_games_played_ = 0;
+  std::vector<double> latencies_;
+  std::chrono::milliseconds elapsed_;
+};
+
+std::string LoadTest::GetRandomMove() {
+  ModelBoard::MoveType move(variant_.dimensions_.size());
+  for(std::size_t i = 1; i < move.size(); i++) {
+    move[i] = random_() % variant_.dimensions_[i];
+  }
+  return FormatMove(move);
+}
+
+bool LoadTest::SendRequest(Game& game) {
+  while(game.num_moves_ < kRandomMoves) {
+    game.moves_ += ' ' + GetRandomMove();
+    game.num_moves_++;
+  }
+  num_sent_++;
+  game.sent_ = std::chrono::steady_clock::now();
+  return SendLine(game.socket_, "position startpos moves" + game.moves_) &&
+         SendLine(game.socket_, "go movetime " + std::to_string(movetime_));
+}
+
+// The move found is played, a new game starts after the end of a game.
+// false once the connection is closed or a command is rejected.
+bool LoadTest::ReadLines(Game& game) {
+  char buffer[4096];
+  ssize_t size = recv(game.socket_, buffer, sizeof(buffer), 0);
+  if(size <= 0) {
+    std::cerr << "connection closed by the server" << std::endl;
+    return false;
+  }
+  game.input_.append(buffer, size);
+  std::size_t end;
+  while((end = game.input_.find('\n')) != std::string::npos) {
+    std::istringstream line(game.input_.substr(0, end));
+    game.input_.erase(0, end + 1);
+    std::string word, move;
+    line >> word >> move;
+    // a rejected option or position would test another game than the one
+    // asked for
+    if(word == "info" && move == "string") {
+      std::string text;
+      std::getline(line >> std::ws, text);
+      if(text.compare(0, 7, "invalid") == 0 ||
+         text.compare(0, 7, "illegal") == 0) {
+        std::cerr << "the server answered: " << text << std::endl;
+        return false;
+      }
+    }
+    if(word != "bestmove") {
+      continue;
+    }
+    latencies_.push_back(std::chrono::duration<double, std::milli>(
+                             std::chrono::steady_clock::now() - game.sent_)
+                             .count());
+    if(move == "(none)") {
+      game.moves_.clear();
+      game.num_moves_ = 0;
+      num_games_played_++;
+    } else {
+      game.moves_ += ' ' + move;
+      game.num_moves_++;
+    }
+    if(num_sent_ < num_requests_ && !SendRequest(game)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool LoadTest::Run(const std::string& path, std::size_t num_games,
+                   std::size_t num_requests, const std::string& variant_text) {
+  num_requests_ = num_requests;
+  games_.resize(num_games);
+  auto start = std::chrono::steady_clock::now();
+  for(Game& game : games_) {
+    game.socket_ = Connect(path);
+    if(game.socket_ < 0 ||
+       (!variant_text.empty() &&
+        !SendLine(game.socket_, "setoption name Variant value " +
+                                    variant_text))) {
+      std::cerr << "cannot connect to " << path << std::endl;
+      return false;
+    }
+    if(num_sent_ < num_requests_ && !SendRequest(game)) {
+      return false;
+    }
+  }
+  std::vector<pollfd> sockets;
+  for(const Game& game : games_) {
+    sockets.push_back({game.socket_, POLLIN, 0});
+  }
+  while(latencies_.size() < num_sent_) {
+    if(poll(sockets.data(), sockets.size(), -1) < 0) {
+      return false;
+    }
+    for(std::size_t i = 0; i < sockets.size(); i++) {
+      if(sockets[i].revents != 0 && !ReadLines(games_[i])) {
+        return false;
+      }
+    }
+  }
+  elapsed_ = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+  for(Game& game : games_) {
+    close(game.socket_);
+  }
+  return true;
+}
+
+void LoadTest::Report(std::ostream& output) const {
+  std::vector<double> latencies(latencies_);
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&latencies](double rank) {
+    return latencies[std::min<std::size_t>(latencies.size() * rank,
+                                           latencies.size() - 1)];
+  };
+  output << std::fixed << std::setprecision(1) << "requests " << latencies.size()
+         << " games " << games_.size() << " finished games "
+         << num_games_played_ << " in " << elapsed_.count() << " ms ("
+         << latencies.size() * 1000.0 / std::max<long long>(elapsed_.count(), 1)
+         << " moves/s)\n"
+         << "latency ms: p50 " << percentile(0.5) << " p90 " << percentile(0.9)
+         << " p99 " << percentile(0.99) << " max " << latencies.back()
+         << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if(argc < 2) {
+    std::cerr << kUsageMsg << std::endl;
+    return EXIT_FAILURE;
+  }
+  long num_games = argc > 2 ? std::atol(argv[2]) : 16;
+  long num_requests = argc > 3 ? std::atol(argv[3]) : 1000;
+  long movetime = argc > 4 ? std::atol(argv[4]) : 100;
+  std::string variant_text = argc > 5 ? argv[5] : "";
+  Position variant;
+  if(num_games <= 0 || num_requests <= 0 || movetime <= 0 ||
+     !ParseVariant(variant_text.empty() ? kDefaultVariant : variant_text,
+                   variant)) {
+    std::cerr << kUsageMsg << std::endl;
+    return EXIT_FAILURE;
+  }
+  LoadTest load_test(variant, movetime);
+  if(!load_test.Run(argv[1], num_games, num_requests, variant_text)) {
+    return EXIT_FAILURE;
+  }
+  load_test.Report(std::cout);
+  return EXIT_SUCCESS;
+}
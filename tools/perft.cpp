@@ -0,0 +1,283 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Counts the move sequences of a position to check and time the
+//               rules of ModelBoard, or of BitBoard with --bitboard.
+//               perft [--variant <v>] [--position <text>] [--threads <n>]
+//                     [--bitboard] [--divide] <depth>
+//               perft --check [--threads <n>] [--bitboard]
+//============================================================================
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "bit_board.h"
+#include "engine.h"
+#include "perft.h"
+
+using namespace Core;
+
+namespace {
+
+const char kUsageMsg[] =
+    "usage: perft [--variant <v>] [--position <text>] [--threads <n>]"
+    " [--bitboard] [--divide] <depth>\n"
+    "       perft --check [--threads <n>] [--bitboard]";
+
+struct KnownCounts {
+  const char* name_;
+  // position text, see position_codec.h
+  const char* position_;
+  std::size_t depth_;
+  uint64_t leaves_;
+  uint64_t wins_;
+  uint64_t draws_;
+};
+
+// The start of the variants of the game, then small boards of 3 dimensions,
+// of 3 players and played to the end. The counts were checked against an
+// independent implementation of the rules.
+const KnownCounts kKnownCounts[] = {
+    {"6x7 Connect Four", "6x7 4 2 a 7/7/7/7/7/7", 7, 823536, 13032, 0},
+    {"3x6 Connect Three", "3x6 3 2 a 6/6/6", 8, 1070018, 138668, 0},
+    {"Five-in-a-Row", "6x9 5 2 a b7a/a7b/b7a/a7b/b7a/a7b", 7, 823536, 2880,
+     0},
+    {"7x10 Connect Four", "7x10 4 2 a 10/10/10/10/10/10/10", 6, 1000000, 0,
+     0},
+    {"8x8 Connect Four", "8x8 4 2 a 8/8/8/8/8/8/8/8", 7, 2097152, 27944, 0},
+    {"3x3x3 Connect Three", "3x3x3 3 2 a 3/3/3/3/3/3/3/3/3", 6, 496872, 22984,
+     0},
+    {"4x4x4 Score Four", "4x4x4 4 2 a 4/4/4/4/4/4/4/4/4/4/4/4/4/4/4/4", 5,
+     1048560, 0, 0},
+    {"4x5 Connect Three, 3 players", "4x5 3 3 a 5/5/5/5", 8, 354412, 18182,
+     0},
+    {"3x4 Connect Three", "3x4 3 2 a 4/4/4", 12, 133656, 118064, 15592}};
+
+// Texts which must be rejected before any cell is allocated
+const char* const kRejectedPositions[] = {
+    "1000000x1000000 4 2 a 1", "4294967296x4294967297 4 2 a 1",
+    "99999999999999999999999x7 4 2 a 7", "2x2x2x2x2x2x2x2x2 3 2 a 2",
+    "6x7 4 2 a 7/7/7/7/7/99999999999", "6x7 4 2 a 50"};
+
+const char* const kRejectedVariants[] = {"100000x100000 4 2",
+                                         "99999999999999999999x7 4 2"};
+
+// Encodings which must be rejected: a product of dimensions wrapping around,
+// too many dimensions and a win of a single chip
+const std::string kRejectedEncodings[] = {
+    std::string("\x02\x81\x80\x80\x80\x80\x80\x80\x80\x80\x01\x01\x04\x02"
+                "\x01\x00", 16),
+    std::string("\xff\xff\xff\xff\xff\xff\xff\xff\x7f", 9),
+    std::string("\x02\x01\x01\x01\x02\x01\x00", 7)};
+
+bool CreateBoard(const Position& position,
+                 std::unique_ptr<ModelBoard>& board) {
+  std::vector<ModelBoard::PieceIDType> piece_IDs;
+  for(uint8_t turn = 1; turn <= position.num_players_; turn++) {
+    piece_IDs.push_back(turn);
+  }
+  board.reset(new ModelBoard(piece_IDs, position.dimensions_,
+                             position.num_win_connected_));
+  return SetPosition(position, *board);
+}
+
+// Sums the counts of the moves of the board, with the time taken
+template <typename Board>
+PerftCounts Count(const Board& board,
+                  std::size_t depth,
+                  std::size_t num_threads,
+                  bool divide,
+                  std::chrono::milliseconds& elapsed) {
+  auto start = std::chrono::steady_clock::now();
+  std::vector<ModelBoard::MoveType> moves;
+  std::vector<PerftCounts> counts;
+  PerftDivide(board, depth, num_threads, moves, counts);
+  PerftCounts total;
+  if(moves.empty()) {
+    Board copy(board);
+    total = Perft(copy, depth);
+  }
+  for(std::size_t i = 0; i < moves.size(); i++) {
+    total += counts[i];
+    if(divide) {
+      std::cout << FormatMove(moves[i]) << ": " << counts[i].leaves_
+                << std::endl;
+    }
+  }
+  elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+  return total;
+}
+
+// Counts on the BitBoard the position of a ModelBoard
+struct BitBoardCount {
+  const ModelBoard* board_;
+  std::size_t depth_;
+  std::size_t num_threads_;
+  bool divide_;
+  std::chrono::milliseconds elapsed_;
+  PerftCounts counts_;
+  bool valid_;
+
+  template <typename Board>
+  void operator()(Board& bit_board) {
+    std::vector<ModelBoard::PieceIDType> cells;
+    ModelBoard::MoveType position(board_->GetDimensions().size(), 0);
+    do {
+      cells.push_back(board_->GetPiece(position));
+    } while(ModelBoard::NextCoordinates(board_->GetDimensions(), position));
+    valid_ = bit_board.SetPosition(cells, board_->GetNextChipId());
+    if(valid_) {
+      counts_ = Count(bit_board, depth_, num_threads_, divide_, elapsed_);
+    }
+  }
+};
+
+// false if the board does not fit in a BitBoard
+bool Count(const ModelBoard& board,
+           std::size_t depth,
+           std::size_t num_threads,
+           bool divide,
+           bool bitboard,
+           PerftCounts& counts,
+           std::chrono::milliseconds& elapsed) {
+  if(!bitboard) {
+    counts = Count(board, depth, num_threads, divide, elapsed);
+    return true;
+  }
+  BitBoardCount count = {&board, depth, num_threads, divide,
+                         std::chrono::milliseconds(0), PerftCounts(), false};
+  if(!CallWithBitBoard(board.GetPieceIDs(), board.GetDimensions(),
+                       board.GetNumWinConnected(), count) ||
+     !count.valid_) {
+    return false;
+  }
+  counts = count.counts_;
+  elapsed = count.elapsed_;
+  return true;
+}
+
+void Print(const PerftCounts& counts, std::chrono::milliseconds elapsed) {
+  std::cout << "leaves " << counts.leaves_ << " wins " << counts.wins_
+            << " draws " << counts.draws_ << " moves " << counts.moves_
+            << " time " << elapsed.count() << " ms moves/s "
+            << counts.moves_ * 1000 / std::max<long long>(elapsed.count(), 1)
+            << std::endl;
+}
+
+bool CheckKnownCounts(std::size_t num_threads, bool bitboard) {
+  bool passed = true;
+  PerftCounts all;
+  std::chrono::milliseconds all_elapsed(0);
+  for(const KnownCounts& known : kKnownCounts) {
+    Position position;
+    std::unique_ptr<ModelBoard> board;
+    if(!ParsePosition(known.position_, position) ||
+       !CreateBoard(position, board)) {
+      std::cout << known.name_ << ": invalid position" << std::endl;
+      passed = false;
+      continue;
+    }
+    std::chrono::milliseconds elapsed;
+    PerftCounts counts;
+    if(!Count(*board, known.depth_, num_threads, false, bitboard, counts,
+              elapsed)) {
+      std::cout << known.name_ << ": unsupported by BitBoard" << std::endl;
+      passed = false;
+      continue;
+    }
+    bool matches = counts.leaves_ == known.leaves_ &&
+                   counts.wins_ == known.wins_ && counts.draws_ == known.draws_;
+    std::cout << std::left << std::setw(30) << known.name_ << " depth "
+              << known.depth_ << (matches ? " ok " : " FAILED ") << std::right;
+    Print(counts, elapsed);
+    if(!matches) {
+      std::cout << "  expected leaves " << known.leaves_ << " wins "
+                << known.wins_ << " draws " << known.draws_ << std::endl;
+      passed = false;
+    }
+    all += counts;
+    all_elapsed += elapsed;
+  }
+  std::cout << "total ";
+  Print(all, all_elapsed);
+  for(const char* text : kRejectedPositions) {
+    Position position;
+    bool rejected = !ParsePosition(text, position);
+    std::cout << "rejected \"" << text << "\""
+              << (rejected ? " ok" : " FAILED") << std::endl;
+    passed = passed && rejected;
+  }
+  for(const char* text : kRejectedVariants) {
+    Position variant;
+    bool rejected = !ParseVariant(text, variant);
+    std::cout << "rejected variant \"" << text << "\""
+              << (rejected ? " ok" : " FAILED") << std::endl;
+    passed = passed && rejected;
+  }
+  for(const std::string& bytes : kRejectedEncodings) {
+    Position position;
+    std::size_t offset = 0;
+    bool rejected = !DecodePosition(bytes, offset, position);
+    std::cout << "rejected " << bytes.size() << " bytes"
+              << (rejected ? " ok" : " FAILED") << std::endl;
+    passed = passed && rejected;
+  }
+  return passed;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::string variant_text = kDefaultVariant, position_text;
+  std::size_t num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+  bool check = false, divide = false, bitboard = false, valid = true;
+  long depth = -1;
+  for(int i = 1; i < argc; i++) {
+    std::string argument = argv[i];
+    if(argument == "--variant" && i + 1 < argc) {
+      variant_text = argv[++i];
+    } else if(argument == "--position" && i + 1 < argc) {
+      position_text = argv[++i];
+    } else if(argument == "--threads" && i + 1 < argc) {
+      num_threads = std::max(std::atol(argv[++i]), 1L);
+    } else if(argument == "--bitboard") {
+      bitboard = true;
+    } else if(argument == "--divide") {
+      divide = true;
+    } else if(argument == "--check") {
+      check = true;
+    } else if(depth < 0 && !argument.empty() &&
+              argument.find_first_not_of("0123456789") == std::string::npos) {
+      depth = std::atol(argument.c_str());
+    } else {
+      valid = false;
+    }
+  }
+  if(valid && check) {
+    return CheckKnownCounts(num_threads, bitboard) ? EXIT_SUCCESS
+                                                   : EXIT_FAILURE;
+  }
+  Position position;
+  std::unique_ptr<ModelBoard> board;
+  if(!valid || depth < 0 ||
+     !(position_text.empty() ? ParseVariant(variant_text, position)
+                             : ParsePosition(position_text, position)) ||
+     !CreateBoard(position, board)) {
+    std::cerr << kUsageMsg << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::chrono::milliseconds elapsed;
+  PerftCounts counts;
+  if(!Count(*board, depth, num_threads, divide, bitboard, counts, elapsed)) {
+    std::cerr << "The board does not fit in a BitBoard" << std::endl;
+    return EXIT_FAILURE;
+  }
+  Print(counts, elapsed);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,225 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Builds and queries the position databases.
+//               position_db build <database> <game records>...
+//               position_db query <database> [column]...
+//============================================================================
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "engine.h"
+#include "game_record.h"
+#include "position_db.h"
+#include "position_hash.h"
+
+using namespace Core;
+
+namespace {
+
+const char kUsageMsg[] = "usage: position_db build <database> <records>...\n"
+                         "       position_db query <database> [column]...";
+
+// Reads the moves of the current game, the undone moves are removed.
+bool ReadFinalLine(GameRecordReader& reader, std::vector<std::size_t>& columns) {
+  GameRecordMove move;
+  columns.clear();
+  while(reader.ReadMove(move)) {
+    if(!move.undo_) {
+      columns.push_back(move.column_);
+    } else if(!columns.empty()) {
+      columns.pop_back();
+    }
+  }
+  return !reader.HasFailed();
+}
+
+bool IsSameShape(const GameRecordHeader& header,
+                 const GameRecordHeader& shape) {
+  return header.dimensions_ == shape.dimensions_ &&
+         header.num_win_connected_ == shape.num_win_connected_ &&
+         header.piece_IDs_.size() == shape.piece_IDs_.size();
+}
+
+// The first game found gives the shape of the database, the games of another
+// shape are skipped. Returns the number of positions to index.
+std::size_t CountPositions(const std::vector<std::string>& files,
+                           GameRecordHeader& shape) {
+  std::size_t num_positions = 0;
+  bool has_shape = false;
+  GameRecordHeader header;
+  std::vector<std::size_t> columns;
+  for(const std::string& file : files) {
+    std::ifstream stream(file, std::ios::binary);
+    GameRecordReader reader(stream);
+    while(reader.ReadHeader(header)) {
+      if(!has_shape) {
+        shape = header;
+        has_shape = true;
+      }
+      if(ReadFinalLine(reader, columns) && IsSameShape(header, shape)) {
+        num_positions += columns.size() + 1;
+      }
+    }
+  }
+  return num_positions;
+}
+
+// Replays the game and adds all the positions reached to the database with
+// the result of the game seen from the player to move.
+bool IndexGame(const GameRecordHeader& header,
+               const std::vector<std::size_t>& columns,
+               PositionDatabase& database) {
+  ModelBoard board(header.piece_IDs_, header.dimensions_,
+                   header.num_win_connected_);
+  PositionHasher hasher(header.dimensions_);
+  const std::size_t num_players = header.piece_IDs_.size();
+  std::vector<std::pair<uint64_t, std::size_t> > positions;
+  positions.reserve(columns.size() + 1);
+  positions.emplace_back(hasher.GetCanonicalKey(), 0);
+  ModelBoard::CoMoveType column;
+  for(std::size_t i = 0; i < columns.size(); i++) {
+    GetColumn(header.dimensions_, columns[i], column);
+    if(!board.SetMoveInColumn(column)) {
+      return false;
+    }
+    hasher.Toggle(board.GetLastMove(), i % num_players + 1);
+    positions.emplace_back(hasher.GetCanonicalKey(), (i + 1) % num_players);
+  }
+  std::size_t winner = columns.empty() ? 0 : (columns.size() - 1) % num_players;
+  for(const auto& position : positions) {
+    GameResult result = GameResult::Unknown;
+    if(board.GetCurrentState() == States::Draw) {
+      result = GameResult::Draw;
+    } else if(board.GetCurrentState() == States::Win) {
+      result = position.second == winner ? GameResult::Win : GameResult::Loss;
+    }
+    if(!database.Add(position.first, result)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int Build(const std::string& path, const std::vector<std::string>& files) {
+  GameRecordHeader shape;
+  std::size_t num_positions = CountPositions(files, shape);
+  if(num_positions == 0) {
+    std::cerr << "no game found" << std::endl;
+    return EXIT_FAILURE;
+  }
+  PositionDatabase database;
+  if(!database.Create(path, shape.dimensions_, shape.num_win_connected_,
+                      shape.piece_IDs_.size(), num_positions)) {
+    std::cerr << "cannot create " << path << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::size_t num_games = 0, num_skipped = 0;
+  GameRecordHeader header;
+  std::vector<std::size_t> columns;
+  auto start = std::chrono::steady_clock::now();
+  for(const std::string& file : files) {
+    std::ifstream stream(file, std::ios::binary);
+    GameRecordReader reader(stream);
+    while(reader.ReadHeader(header)) {
+      if(ReadFinalLine(reader, columns) && IsSameShape(header, shape) &&
+         IndexGame(header, columns, database)) {
+        num_games++;
+      } else {
+        num_skipped++;
+      }
+    }
+    // the games following a corrupt header cannot be found
+    if(reader.HasFailed()) {
+      std::cerr << "corrupt game record in " << file << std::endl;
+      num_skipped++;
+    }
+  }
+  double seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start).count();
+  std::cout << "games indexed: " << num_games << ", skipped: " << num_skipped
+            << std::endl
+            << "positions: " << num_positions
+            << ", distinct: " << database.GetSize()
+            << ", capacity: " << database.GetCapacity() << std::endl
+            << "time: " << seconds << " s" << std::endl;
+  return EXIT_SUCCESS;
+}
+
+void PrintStats(const std::string& label, const PositionStats& stats) {
+  std::cout << label << " count: " << stats.count_ << " wins: " << stats.wins_
+            << " losses: " << stats.losses_ << " draws: " << stats.draws_;
+  if(stats.count_ > 0) {
+    std::cout << " win rate: " << std::fixed << std::setprecision(3)
+              << static_cast<double>(stats.wins_) / stats.count_;
+  }
+  std::cout << std::endl;
+}
+
+// The columns are written as in the engine protocol (ParseMove), numbered
+// from 1. The statistics of the position and of each move playable from it
+// are printed.
+int Query(const std::string& path, const std::vector<std::string>& moves) {
+  PositionDatabase database;
+  if(!database.Open(path)) {
+    std::cerr << "cannot open " << path << std::endl;
+    return EXIT_FAILURE;
+  }
+  // the pieces are numbered by their turns, as in the keys of the database
+  std::vector<ModelBoard::PieceIDType> piece_IDs;
+  for(std::size_t turn = 1; turn <= database.GetNumPlayers(); turn++) {
+    piece_IDs.push_back(turn);
+  }
+  ModelBoard board(piece_IDs, database.GetDimensions(),
+                   database.GetNumWinConnected());
+  ModelBoard::CoMoveType column;
+  for(const std::string& move : moves) {
+    if(!ParseMove(move, board.GetDimensions(), column) ||
+       board.GetCurrentState() != States::OnGoing ||
+       !board.SetMoveInColumn(column)) {
+      std::cerr << "invalid column " << move << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  PositionStats stats;
+  auto start = std::chrono::steady_clock::now();
+  bool found = database.Find(board, stats);
+  auto lookup_time = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+  PrintStats("position", found ? stats : PositionStats());
+  std::cout << "lookup: " << lookup_time.count() << " us" << std::endl;
+  std::vector<ModelBoard::MoveType> next_moves;
+  board.GetPossibleMoves(next_moves);
+  for(const ModelBoard::MoveType& next_move : next_moves) {
+    board.SetMove(next_move);
+    if(database.Find(board, stats)) {
+      PrintStats("column " + FormatMove(next_move), stats);
+    }
+    board.Undo();
+  }
+  return EXIT_SUCCESS;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if(argc < 3) {
+    std::cerr << kUsageMsg << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::string command = argv[1];
+  std::vector<std::string> arguments(argv + 3, argv + argc);
+  if(command == "build" && !arguments.empty()) {
+    return Build(argv[2], arguments);
+  } else if(command == "query") {
+    return Query(argv[2], arguments);
+  }
+  std::cerr << kUsageMsg << std::endl;
+  return EXIT_FAILURE;
+}
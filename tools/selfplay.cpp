@@ -0,0 +1,192 @@
+//============================================================================
+// Author      : Franck Nassé - October 19, 2026
+// Version     : v1.0
+// Copyright   : Copyright (c) 2026, Franck Nassé. All rights reserved.
+// Description : Plays the AI against itself and writes the positions with
+//               their score and the result of the game, to train a network
+//               (see neural_evaluator.h).
+//               selfplay [--variant <v>] [--games <n>] [--depth <n>]
+//                        [--random-moves <n>] [--seed <n>]
+//                        [--eval-file <network>] [--output <file>]
+//============================================================================
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "engine.h"
+#include "neural_evaluator.h"
+#include "transposition_table.h"
+
+using namespace Core;
+
+namespace {
+
+const char kUsageMsg[] =
+    "usage: selfplay [--variant <v>] [--games <n>] [--depth <n>]"
+    " [--random-moves <n>] [--seed <n>]\n"
+    "                [--eval-file <network>] [--output <file>]";
+const long kDefaultGames = 100;
+const long kDefaultDepth = 6;
+// the first moves of a game are random so that the games differ
+const long kDefaultRandomMoves = 4;
+const uint32_t kDefaultSeed = 2016;
+
+// A searched position, its result is known at the end of the game
+struct Sample {
+  std::string position_;
+  int score_;
+  std::size_t turn_;
+};
+
+struct SelfPlayOptions {
+  Position variant_;
+  long num_games_ = kDefaultGames;
+  long depth_ = kDefaultDepth;
+  long num_random_moves_ = kDefaultRandomMoves;
+  uint32_t seed_ = kDefaultSeed;
+};
+
+// Index of the player to move in the order of the turns
+std::size_t GetNextTurn(const ModelBoard& board) {
+  const std::vector<ModelBoard::PieceIDType>& piece_IDs = board.GetPieceIDs();
+  return std::find(piece_IDs.begin(), piece_IDs.end(), board.GetNextChipId()) -
+         piece_IDs.begin();
+}
+
+// Random moves which do not end the game, unless all of them do
+void PlayRandomMoves(IntelligentBoard& board,
+                     long num_moves,
+                     std::mt19937& random) {
+  std::vector<ModelBoard::MoveType> moves;
+  for(long i = 0; i < num_moves && board.GetCurrentState() == States::OnGoing;
+      i++) {
+    board.GetPossibleMoves(moves);
+    std::shuffle(moves.begin(), moves.end(), random);
+    for(std::size_t candidate = 0; candidate < moves.size(); candidate++) {
+      board.SetMove(moves[candidate]);
+      if(board.GetCurrentState() == States::OnGoing ||
+         candidate + 1 == moves.size()) {
+        break;
+      }
+      board.Undo();
+    }
+  }
+}
+
+// Writes "<position text>\t<score>\t<result>" for every searched position,
+// the score and the result are seen from the player to move: 1 for a win,
+// 0 for a draw and -1 for a loss
+void PlayGame(IntelligentBoard& board,
+              TranspositionTable& table,
+              const SelfPlayOptions& options,
+              std::mt19937& random,
+              std::ostream& output) {
+  board.Reset();
+  table.Clear();
+  PlayRandomMoves(board, options.num_random_moves_, random);
+  std::vector<Sample> samples;
+  SearchLimits limits;
+  limits.depth_ = static_cast<DepthType>(options.depth_);
+  ModelBoard::MoveType best_move;
+  while(board.GetCurrentState() == States::OnGoing) {
+    std::size_t turn = GetNextTurn(board);
+    if(!board.Search(limits, best_move)) {
+      break;
+    }
+    samples.push_back({SerializePosition(board), board.GetLastScore(), turn});
+    board.SetMove(best_move);
+  }
+  bool won = board.GetCurrentState() == States::Win;
+  // the winner has played the last move
+  std::size_t winner = (GetNextTurn(board) + board.GetPieceIDs().size() - 1) %
+                       board.GetPieceIDs().size();
+  for(const Sample& sample : samples) {
+    int result = !won ? 0 : (sample.turn_ == winner ? 1 : -1);
+    output << sample.position_ << '\t' << sample.score_ << '\t' << result
+           << '\n';
+  }
+}
+
+bool ParseCount(const char* text, long& count) {
+  std::string digits = text;
+  if(digits.empty() ||
+     digits.find_first_not_of("0123456789") != std::string::npos) {
+    return false;
+  }
+  count = std::atol(text);
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  SelfPlayOptions options;
+  std::string variant_text = kDefaultVariant, network_file, output_file;
+  long seed = kDefaultSeed;
+  bool valid = true;
+  for(int i = 1; i < argc && valid; i++) {
+    std::string argument = argv[i];
+    if(i + 1 >= argc) {
+      valid = false;
+    } else if(argument == "--variant") {
+      variant_text = argv[++i];
+    } else if(argument == "--games") {
+      valid = ParseCount(argv[++i], options.num_games_);
+    } else if(argument == "--depth") {
+      valid = ParseCount(argv[++i], options.depth_) && options.depth_ > 0 &&
+              options.depth_ <= kMaxSearchDepth;
+    } else if(argument == "--random-moves") {
+      valid = ParseCount(argv[++i], options.num_random_moves_);
+    } else if(argument == "--seed") {
+      valid = ParseCount(argv[++i], seed);
+    } else if(argument == "--eval-file") {
+      network_file = argv[++i];
+    } else if(argument == "--output") {
+      output_file = argv[++i];
+    } else {
+      valid = false;
+    }
+  }
+  if(!valid || !ParseVariant(variant_text, options.variant_)) {
+    std::cerr << kUsageMsg << std::endl;
+    return EXIT_FAILURE;
+  }
+  options.seed_ = static_cast<uint32_t>(seed);
+
+  std::vector<IntelligentBoard::Party> parties;
+  for(uint8_t turn = 1; turn <= options.variant_.num_players_; turn++) {
+    parties.push_back(IntelligentBoard::Party(turn));
+  }
+  IntelligentBoard board(parties, options.variant_.dimensions_,
+                         options.variant_.num_win_connected_);
+  if(!network_file.empty()) {
+    std::shared_ptr<NeuralNetwork> network(new NeuralNetwork());
+    if(!network->Load(network_file) || !board.SetNeuralNetwork(network)) {
+      std::cerr << "selfplay: " << network_file
+                << " is not a network of the variant" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  TranspositionTable table;
+  board.SetTranspositionTable(&table);
+
+  std::ofstream file;
+  if(!output_file.empty()) {
+    file.open(output_file);
+    if(!file) {
+      std::cerr << "selfplay: cannot write " << output_file << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  std::ostream& output = output_file.empty() ? std::cout : file;
+  std::mt19937 random(options.seed_);
+  for(long game = 0; game < options.num_games_; game++) {
+    PlayGame(board, table, options, random, output);
+  }
+  output.flush();
+  return output ? EXIT_SUCCESS : EXIT_FAILURE;
+}